@@ -176,6 +176,9 @@ typedef struct _E_Rect         E_Rect;
 # include "e_includes.h"
 
 E_API double          e_main_ts(const char *str);
+E_API void            e_main_ts_span(const char *str, double start, double len);
+E_API char           *e_main_ts_timeline_get(void);
+E_API char           *e_main_ts_trace_get(void);
 
 #define E_EFL_VERSION_MINIMUM(MAJ, MIN, MIC) \
   ((eina_version->major > MAJ) || (eina_version->minor > MIN) ||\
@@ -10,6 +10,7 @@ typedef struct
    Ecore_Animator *anim;
    Ecore_Timer *retry_timer;
    int retries;
+   Eina_Bool fading : 1; // enlightenment_system is running a fade for us
 } Backlight_Device;
 
 E_API int E_EVENT_BACKLIGHT_CHANGE = -1;
@@ -77,6 +78,28 @@ _backlight_system_get_cb(void *data, const char *params)
      }
 }
 
+static void
+_backlight_system_fade_cb(void *data, const char *params)
+{
+   char dev[1024];
+   int val = 0;
+   Backlight_Device *bd = data;
+
+   if (!params) return;
+   if (sscanf(params, "%1023s %i", dev, &val) != 2) return;
+   if (!!strcmp(bd->dev, dev)) return;
+   e_system_handler_del("bklight-fade", _backlight_system_fade_cb, bd);
+   bd->fading = EINA_FALSE;
+   E_FREE_FUNC(bd->anim, ecore_animator_del);
+   // -1 == the device went away before the fade ended - ask what it is at
+   if (val >= 0)
+     {
+        bd->val = (double)val / 1000.0;
+        ecore_event_add(E_EVENT_BACKLIGHT_CHANGE, NULL, NULL, NULL);
+     }
+   _backlight_devices_device_update(bd);
+}
+
 static void
 _backlight_system_ddc_get_cb(void *data, const char *params)
 {
@@ -117,6 +140,7 @@ _backlight_devices_clear(void)
         if (bd->retry_timer) ecore_timer_del(bd->retry_timer);
         e_system_handler_del("bklight-val", _backlight_system_get_cb, bd);
         e_system_handler_del("ddc-val-get", _backlight_system_ddc_get_cb, bd);
+        e_system_handler_del("bklight-fade", _backlight_system_fade_cb, bd);
         free(bd);
      }
 }
@@ -219,9 +243,19 @@ _backlight_devices_randr_output_get(Ecore_X_Window root, const char *output, con
 }
 #endif
 
+static void
+_backlight_devices_device_fade_stop(Backlight_Device *bd)
+{
+   if (!bd->fading) return;
+   bd->fading = EINA_FALSE;
+   E_FREE_FUNC(bd->anim, ecore_animator_del);
+   e_system_handler_del("bklight-fade", _backlight_system_fade_cb, bd);
+}
+
 static void
 _backlight_devices_device_set(Backlight_Device *bd, double val)
 {
+   _backlight_devices_device_fade_stop(bd);
    bd->val = bd->expected_val = val;
    bd->retries = 0;
 #ifndef HAVE_WAYLAND_ONLY
@@ -596,6 +630,23 @@ _bl_anim(void *data, double pos)
    return EINA_TRUE;
 }
 
+static Eina_Bool
+_bl_fade_anim(void *data, double pos)
+{
+   Backlight_Device *bd = data;
+
+   // enlightenment_system does the writes - just follow along its curve
+   pos = ecore_animator_pos_map(pos, ECORE_POS_MAP_DECELERATE, 0.0, 0.0);
+   bd->val = (bd->from_val * (1.0 - pos)) + (bd->to_val * pos);
+   ecore_event_add(E_EVENT_BACKLIGHT_CHANGE, NULL, NULL, NULL);
+   if (pos >= 1.0)
+     {
+        bd->anim = NULL;
+        return EINA_FALSE;
+     }
+   return EINA_TRUE;
+}
+
 static void
 _cb_job_zone_change(void *data EINA_UNUSED)
 {
@@ -690,7 +741,8 @@ e_backlight_level_set(E_Zone *zone, double val, double tim)
    if ((!e_comp->screen) || (!e_comp->screen->backlight_enabled)) return;
    if (val < 0.0) val = 0.0;
    else if (val > 1.0) val = 1.0;
-   if ((fabs(val - bl_now) < DBL_EPSILON) && (!bd->anim)) return;
+   if ((fabs(val - bl_now) < DBL_EPSILON) && (!bd->anim) && (!bd->fading))
+     return;
 
    if (fabs(tim) < DBL_EPSILON)
      {
@@ -704,9 +756,23 @@ e_backlight_level_set(E_Zone *zone, double val, double tim)
 
    E_FREE_FUNC(bd->retry_timer, ecore_timer_del);
    E_FREE_FUNC(bd->anim, ecore_animator_del);
-   bd->anim = ecore_animator_timeline_add(tim, _bl_anim, bd);
    bd->from_val = bl_now;
    bd->to_val = val;
+   if ((bd->dev) && (!!strcmp(bd->dev, "randr")) &&
+       (!!strncmp(bd->dev, "ddc:", 4)))
+     { // sysfs backlights fade inside enlightenment_system - 1 msg per fade
+        bd->expected_val = val;
+        bd->retries = 0;
+        bd->fading = EINA_TRUE;
+        e_system_handler_del("bklight-fade", _backlight_system_fade_cb, bd);
+        e_system_handler_add("bklight-fade", _backlight_system_fade_cb, bd);
+        e_system_send("bklight-fade", "%s %i %i %i", bd->dev,
+                      (int)(bl_now * 1000.0), (int)(val * 1000.0),
+                      (int)(tim * 1000.0));
+        bd->anim = ecore_animator_timeline_add(tim, _bl_fade_anim, bd);
+        return;
+     }
+   bd->anim = ecore_animator_timeline_add(tim, _bl_anim, bd);
 }
 
 E_API double
@@ -475,6 +475,8 @@ _e_client_free(E_Client *ec)
      }
 
    E_OBJECT(ec)->references++;
+   if (ec->desk) e_desk_client_del(ec->desk, ec);
+   e_desk_client_sticky_update(ec);
    if (ec->fullscreen)
      {
         ec->desk->fullscreen_clients = eina_list_remove(ec->desk->fullscreen_clients, ec);
@@ -592,6 +594,8 @@ _e_client_del(E_Client *ec)
    ec->changed = 0;
    focus_stack = eina_list_remove(focus_stack, ec);
    raise_stack = eina_list_remove(raise_stack, ec);
+   if (ec->desk) e_desk_client_del(ec->desk, ec);
+   e_desk_client_sticky_update(ec);
    if (ec->exe_inst)
      {
         if (ec->exe_inst->phony && (eina_list_count(ec->exe_inst->clients) == 1))
@@ -1679,6 +1683,14 @@ _e_client_cb_evas_resize(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_
 static void
 _e_client_cb_evas_show(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
+   static Eina_Bool first_map = EINA_TRUE;
+   E_Client *ec = data;
+
+   if ((first_map) && (!ec->internal) && (!ec->input_only))
+     {
+        first_map = EINA_FALSE;
+        e_main_ts("First Client Map");
+     }
    _e_client_event_simple(data, E_EVENT_CLIENT_SHOW);
 }
 
@@ -2870,6 +2882,8 @@ e_client_desk_set(E_Client *ec, E_Desk *desk)
         desk->fullscreen_clients = eina_list_append(desk->fullscreen_clients, ec);
      }
    old_desk = ec->desk;
+   if (old_desk) e_desk_client_del(old_desk, ec);
+   e_desk_client_add(desk, ec);
    ec->desk = desk;
    if (ec->frame)
      {
@@ -2962,6 +2976,12 @@ e_client_action_get(void)
    return action_client;
 }
 
+E_API E_Client *
+e_client_moving_get(void)
+{
+   return ecmove;
+}
+
 E_API E_Client *
 e_client_warping_get(void)
 {
@@ -3431,6 +3451,7 @@ e_client_zone_set(E_Client *ec, E_Zone *zone)
      }
 
    ec->zone = zone;
+   if (ec->sticky) e_desk_client_sticky_update(ec);
 
    if ((!ec->desk) || (ec->desk->zone != ec->zone))
      e_client_desk_set(ec, e_desk_current_get(ec->zone));
@@ -4740,10 +4761,12 @@ e_client_stick(E_Client *ec)
    if (!ec->zone) return;
    if (ec->sticky) return;
    desk = ec->desk;
+   if (desk) e_desk_client_del(desk, ec);
    ec->desk = NULL;
    if (desk && ec->fullscreen)
      desk->fullscreen_clients = eina_list_remove(desk->fullscreen_clients, ec);
    ec->sticky = 1;
+   e_desk_client_sticky_update(ec);
    ec->hidden = 0;
    e_hints_window_sticky_set(ec, 1);
    e_client_desk_set(ec, desk);
@@ -4760,6 +4783,7 @@ e_client_stick(E_Client *ec)
                {
                   if (child == ec) continue;
                   child->sticky = 1;
+                  e_desk_client_sticky_update(child);
                   e_hints_window_sticky_set(child, 1);
                   evas_object_show(ec->frame);
                }
@@ -4776,6 +4800,7 @@ e_client_stick(E_Client *ec)
              EINA_LIST_FREE(list, child)
                {
                   child->sticky = 1;
+                  e_desk_client_sticky_update(child);
                   e_hints_window_sticky_set(child, 1);
                   evas_object_show(ec->frame);
                }
@@ -4799,8 +4824,10 @@ e_client_unstick(E_Client *ec)
    desk = e_desk_current_get(ec->zone);
    if (ec->desk && ec->fullscreen)
      ec->desk->fullscreen_clients = eina_list_remove(ec->desk->fullscreen_clients, ec);
+   if (ec->desk) e_desk_client_del(ec->desk, ec);
    ec->desk = NULL;
    ec->hidden = ec->sticky = 0;
+   e_desk_client_sticky_update(ec);
    e_hints_window_sticky_set(ec, 0);
    e_client_desk_set(ec, desk);
    evas_object_smart_callback_call(ec->frame, "unstick", NULL);
@@ -4816,6 +4843,7 @@ e_client_unstick(E_Client *ec)
                {
                   if (child == ec) continue;
                   child->sticky = 1;
+                  e_desk_client_sticky_update(child);
                   e_hints_window_sticky_set(child, 0);
                }
              e_client_stack_list_finish(list);
@@ -4831,6 +4859,7 @@ e_client_unstick(E_Client *ec)
              EINA_LIST_FREE(list, child)
                {
                   child->sticky = 0;
+                  e_desk_client_sticky_update(child);
                   e_hints_window_sticky_set(child, 0);
                }
           }
@@ -5132,11 +5161,42 @@ e_client_act_kill_begin(E_Client *ec)
 
 ////////////////////////////////////////////////
 
+#ifndef HAVE_WAYLAND_ONLY
+E_API Ecore_X_Icon *
+e_client_netwm_icon_get(const E_Client *ec, int size)
+{
+   Ecore_X_Icon *best = NULL;
+   int i, sz;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(ec, NULL);
+   if (!ec->netwm.icons) return NULL;
+   // icons are sorted largest first - take the smallest that is still at
+   // least size, or the largest if none are big enough
+   best = &(ec->netwm.icons[0]);
+   if (size <= 0) return best;
+   for (i = 0; i < ec->netwm.num_icons; i++)
+     {
+        sz = MAX(ec->netwm.icons[i].width, ec->netwm.icons[i].height);
+        if (sz < size) break;
+        best = &(ec->netwm.icons[i]);
+     }
+   return best;
+}
+#endif
 
 E_API Evas_Object *
 e_client_icon_add(E_Client *ec, Evas *evas)
+{
+   return e_client_icon_size_add(ec, evas, 64);
+}
+
+E_API Evas_Object *
+e_client_icon_size_add(E_Client *ec, Evas *evas, int size)
 {
    Evas_Object *o;
+#ifndef HAVE_WAYLAND_ONLY
+   Ecore_X_Icon *icon;
+#endif
 
    E_OBJECT_CHECK_RETURN(ec, NULL);
    E_OBJECT_TYPE_CHECK_RETURN(ec, E_CLIENT_TYPE, NULL);
@@ -5186,12 +5246,11 @@ e_client_icon_add(E_Client *ec, Evas *evas)
 #ifndef HAVE_WAYLAND_ONLY
    if ((e_config->use_app_icon) && (ec->icon_preference != E_ICON_PREF_USER))
      {
-        if (ec->netwm.icons)
+        icon = e_client_netwm_icon_get(ec, size);
+        if (icon)
           {
              o = e_icon_add(evas);
-             e_icon_data_set(o, ec->netwm.icons[0].data,
-                             ec->netwm.icons[0].width,
-                             ec->netwm.icons[0].height);
+             e_icon_data_set(o, icon->data, icon->width, icon->height);
              e_icon_alpha_set(o, 1);
              return o;
           }
@@ -5201,17 +5260,15 @@ e_client_icon_add(E_Client *ec, Evas *evas)
      {
         if ((ec->desktop) && (ec->icon_preference != E_ICON_PREF_NETWM))
           {
-             o = e_util_desktop_icon_add(ec->desktop, 64, evas);
+             o = e_util_desktop_icon_add(ec->desktop, size, evas);
              if (o)
                return o;
           }
 #ifndef HAVE_WAYLAND_ONLY
-        else if (ec->netwm.icons)
+        else if ((icon = e_client_netwm_icon_get(ec, size)))
           {
              o = e_icon_add(evas);
-             e_icon_data_set(o, ec->netwm.icons[0].data,
-                             ec->netwm.icons[0].width,
-                             ec->netwm.icons[0].height);
+             e_icon_data_set(o, icon->data, icon->width, icon->height);
              e_icon_alpha_set(o, 1);
              return o;
           }
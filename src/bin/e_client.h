@@ -782,6 +782,7 @@ E_API void e_client_unignore(E_Client *ec);
 E_API void e_client_desk_set(E_Client *ec, E_Desk *desk);
 E_API Eina_Bool e_client_comp_grabbed_get(void);
 E_API E_Client *e_client_action_get(void);
+E_API E_Client *e_client_moving_get(void);
 E_API E_Client *e_client_warping_get(void);
 E_API Eina_List *e_clients_immortal_list(void);
 E_API void e_client_mouse_in(E_Client *ec, int x, int y);
@@ -842,6 +843,10 @@ E_API void e_client_act_menu_begin(E_Client *ec, E_Binding_Event_Mouse_Button *e
 E_API void e_client_act_close_begin(E_Client *ec);
 E_API void e_client_act_kill_begin(E_Client *ec);
 E_API Evas_Object *e_client_icon_add(E_Client *ec, Evas *evas);
+E_API Evas_Object *e_client_icon_size_add(E_Client *ec, Evas *evas, int size);
+#ifndef HAVE_WAYLAND_ONLY
+E_API Ecore_X_Icon *e_client_netwm_icon_get(const E_Client *ec, int size);
+#endif
 E_API void e_client_ping(E_Client *cw);
 E_API void e_client_move_cancel(void);
 E_API void e_client_resize_cancel(void);
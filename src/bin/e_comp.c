@@ -1054,6 +1054,10 @@ e_comp_init(void)
              // going from version 0 we should disable grab for smoothness
              conf->grab = 0;
              /* fallthrough */
+           case 1:
+             // small mirrors (pager etc.) refresh at a reduced rate
+             conf->mirror_scaled_fps = 8.0;
+             /* fallthrough */
            default:
              break;
           }
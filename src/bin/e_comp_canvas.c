@@ -27,13 +27,17 @@ _e_comp_canvas_cb_first_frame(void *data EINA_UNUSED, Evas *e, void *event_info
 {
    double now = ecore_time_get();
 
-   switch (e_first_frame[0])
+   e_main_ts("First Frame");
+   if (e_first_frame)
      {
-      case 'A': abort();
-      case 'E':
-      case 'D': exit(-1);
-      case 'T': fprintf(stderr, "Startup time: '%f' - '%f' = '%f'\n", now, e_first_frame_start_time, now - e_first_frame_start_time);
-         break;
+        switch (e_first_frame[0])
+          {
+           case 'A': abort();
+           case 'E':
+           case 'D': exit(-1);
+           case 'T': fprintf(stderr, "Startup time: '%f' - '%f' = '%f'\n", now, e_first_frame_start_time, now - e_first_frame_start_time);
+              break;
+          }
      }
 
    evas_event_callback_del_full(e, EVAS_CALLBACK_RENDER_POST, _e_comp_canvas_cb_first_frame, NULL);
@@ -384,8 +388,7 @@ e_comp_canvas_init(int w, int h)
 
    e_comp->evas = ecore_evas_get(e_comp->ee);
 
-   if (e_first_frame)
-     evas_event_callback_add(e_comp->evas, EVAS_CALLBACK_RENDER_POST, _e_comp_canvas_cb_first_frame, NULL);
+   evas_event_callback_add(e_comp->evas, EVAS_CALLBACK_RENDER_POST, _e_comp_canvas_cb_first_frame, NULL);
    o = evas_object_rectangle_add(e_comp->evas);
    e_comp->canvas->resize_object = o;
    evas_object_layer_set(o, E_LAYER_BOTTOM);
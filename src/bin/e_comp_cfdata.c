@@ -53,6 +53,8 @@ e_comp_cfdata_edd_init(E_Config_DD **conf_edd, E_Config_DD **match_edd)
    E_CONFIG_VAL(D, T, nofade, UCHAR);
    E_CONFIG_VAL(D, T, smooth_windows, UCHAR);
    E_CONFIG_VAL(D, T, first_draw_delay, DOUBLE);
+   E_CONFIG_VAL(D, T, mirror_scaled_fps, DOUBLE);
+   E_CONFIG_VAL(D, T, wl_frame_deadline, DOUBLE);
    E_CONFIG_VAL(D, T, enable_advanced_features, UCHAR);
    E_CONFIG_LIST(D, T, match.popups, *match_edd);
    E_CONFIG_LIST(D, T, match.borders, *match_edd);
@@ -94,6 +96,8 @@ e_comp_cfdata_config_new(void)
    cfg->nofade = 0;
    cfg->smooth_windows = 0; // 1 if gl, 0 if not
    cfg->first_draw_delay = 0.15;
+   cfg->mirror_scaled_fps = 8.0;
+   cfg->wl_frame_deadline = 0.0;
 
    cfg->match.popups = NULL;
 
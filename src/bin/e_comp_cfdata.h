@@ -5,7 +5,7 @@ typedef struct _E_Comp_Match  E_Comp_Match;
 #ifndef E_COMP_CFDATA_H
 #define E_COMP_CFDATA_H
 
-#define E_COMP_VERSION 1
+#define E_COMP_VERSION 2
 struct _E_Comp_Config
 {
    int           version;
@@ -30,6 +30,8 @@ struct _E_Comp_Config
    unsigned char smooth_windows;
    unsigned char nofade;
    double        first_draw_delay;
+   double        mirror_scaled_fps; // refresh rate of small mirrors (pager), 0 to disable
+   double        wl_frame_deadline; // send wl frame callbacks this long before the next refresh, 0 sends them right after render
    Eina_Bool enable_advanced_features;
 
    struct
@@ -88,6 +88,8 @@ typedef struct _E_Comp_Object
    Evas_Object         *frame_volume; // volume level object
    unsigned int         layer; //e_comp_canvas_layer_map(cw->ec->layer)
    Eina_List           *obj_mirror;  // extra mirror objects
+   Eina_List           *obj_mirror_scaled;  // reduced resolution mirror copies
+   Ecore_Timer         *mirror_scaled_timer; // throttles obj_mirror_scaled refreshes
    Eina_List           *obj_agent;  // extra agent objects
    Eina_Tiler          *updates; //render update regions
    Eina_Tiler          *pending_updates; //render update regions which are about to render
@@ -228,6 +230,16 @@ _e_comp_object_cb_mirror_del(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
    cw->obj_mirror = eina_list_remove(cw->obj_mirror, obj);
 }
 
+static void
+_e_comp_object_cb_mirror_scaled_del(void *data, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   E_Comp_Object *cw = data;
+
+   cw->obj_mirror_scaled = eina_list_remove(cw->obj_mirror_scaled, obj);
+   if (!cw->obj_mirror_scaled)
+     E_FREE_FUNC(cw->mirror_scaled_timer, ecore_timer_del);
+}
+
 static void
 _e_comp_object_cb_mirror_show(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
@@ -250,6 +262,106 @@ _e_comp_object_cb_mirror_hide(void *data, Evas *e EINA_UNUSED, Evas_Object *obj
      evas_object_smart_callback_call(cw->smart_obj, "visibility_normal", cw->ec);
 }
 
+/* resample premultiplied argb pixels into a smaller buffer, averaging a 2x2
+ * grid of samples per destination pixel */
+static void
+_e_comp_object_pixels_downscale(const unsigned int *src, int sw, int sh, int sstride,
+                                unsigned int *dst, int dw, int dh, int dstride)
+{
+   int *sx;
+   int x, y;
+
+   sx = alloca(dw * 2 * sizeof(int));
+   for (x = 0; x < dw; x++)
+     {
+        sx[(x * 2)] = (((x * 4) + 1) * sw) / (dw * 4);
+        sx[(x * 2) + 1] = (((x * 4) + 3) * sw) / (dw * 4);
+     }
+   for (y = 0; y < dh; y++)
+     {
+        const unsigned int *s0, *s1;
+        unsigned int *d = dst + (y * dstride);
+
+        s0 = src + (((((y * 4) + 1) * sh) / (dh * 4)) * sstride);
+        s1 = src + (((((y * 4) + 3) * sh) / (dh * 4)) * sstride);
+        for (x = 0; x < dw; x++)
+          {
+             unsigned int a = s0[sx[(x * 2)]], b = s0[sx[(x * 2) + 1]];
+             unsigned int c = s1[sx[(x * 2)]], e = s1[sx[(x * 2) + 1]];
+             unsigned int rb, ag;
+
+             rb = (a & 0x00ff00ff) + (b & 0x00ff00ff) +
+                  (c & 0x00ff00ff) + (e & 0x00ff00ff);
+             ag = ((a >> 8) & 0x00ff00ff) + ((b >> 8) & 0x00ff00ff) +
+                  ((c >> 8) & 0x00ff00ff) + ((e >> 8) & 0x00ff00ff);
+             *d++ = ((rb >> 2) & 0x00ff00ff) | (((ag >> 2) & 0x00ff00ff) << 8);
+          }
+     }
+}
+
+static Eina_Bool
+_e_comp_object_mirror_scaled_cb_timer(void *data)
+{
+   E_Comp_Object *cw = data;
+   Eina_List *l;
+   Evas_Object *o;
+   unsigned int *src, *dst;
+   int sw, sh, sstride, w, h, ow, oh;
+   Eina_Bool alpha;
+
+   /* damage has not been fetched into pending updates yet: try next tick */
+   if (cw->update) return ECORE_CALLBACK_RENEW;
+   cw->mirror_scaled_timer = NULL;
+   if (cw->native || cw->blanked || (!cw->redirected)) return ECORE_CALLBACK_CANCEL;
+   if (e_object_is_del(E_OBJECT(cw->ec))) return ECORE_CALLBACK_CANCEL;
+   /* nothing else may be drawing this client (eg. it is on another desk) */
+   if (cw->pending_updates)
+     e_comp_object_render(cw->smart_obj);
+   else
+     e_comp_client_post_update_add(cw->ec);
+
+   src = evas_object_image_data_get(cw->obj, EINA_FALSE);
+   if (!src) return ECORE_CALLBACK_CANCEL;
+   evas_object_image_size_get(cw->obj, &sw, &sh);
+   sstride = evas_object_image_stride_get(cw->obj) / 4;
+   alpha = evas_object_image_alpha_get(cw->obj);
+   EINA_LIST_FOREACH(cw->obj_mirror_scaled, l, o)
+     {
+        evas_object_geometry_get(o, NULL, NULL, &w, &h);
+        w = MIN(w, sw);
+        h = MIN(h, sh);
+        if ((w < 1) || (h < 1)) continue;
+        evas_object_image_size_get(o, &ow, &oh);
+        if ((ow != w) || (oh != h))
+          evas_object_image_size_set(o, w, h);
+        evas_object_image_alpha_set(o, alpha);
+        dst = evas_object_image_data_get(o, EINA_TRUE);
+        if (!dst) continue;
+        _e_comp_object_pixels_downscale(src, sw, sh, sstride, dst, w, h,
+                                        evas_object_image_stride_get(o) / 4);
+        evas_object_image_data_set(o, dst);
+        evas_object_image_data_update_add(o, 0, 0, w, h);
+     }
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_e_comp_object_mirror_scaled_queue(E_Comp_Object *cw)
+{
+   double fps = e_comp_config_get()->mirror_scaled_fps;
+
+   if (cw->mirror_scaled_timer) return;
+   if (fps <= 0.0) fps = 1.0;
+   cw->mirror_scaled_timer =
+     ecore_timer_loop_add(1.0 / fps, _e_comp_object_mirror_scaled_cb_timer, cw);
+}
+
+static void
+_e_comp_object_cb_mirror_scaled_resize(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   _e_comp_object_mirror_scaled_queue(data);
+}
+
 /////////////////////////////////////
 
 static inline Eina_Bool
@@ -2446,6 +2558,16 @@ _e_comp_smart_del(Evas_Object *obj)
         evas_object_event_callback_del_full(o, EVAS_CALLBACK_HIDE, _e_comp_object_cb_mirror_hide, cw);
         evas_object_del(o);
      }
+   E_FREE_FUNC(cw->mirror_scaled_timer, ecore_timer_del);
+   EINA_LIST_FREE(cw->obj_mirror_scaled, o)
+     {
+        evas_object_freeze_events_set(o, 1);
+        evas_object_event_callback_del_full(o, EVAS_CALLBACK_DEL, _e_comp_object_cb_mirror_scaled_del, cw);
+        evas_object_event_callback_del_full(o, EVAS_CALLBACK_RESIZE, _e_comp_object_cb_mirror_scaled_resize, cw);
+        evas_object_event_callback_del_full(o, EVAS_CALLBACK_SHOW, _e_comp_object_cb_mirror_show, cw);
+        evas_object_event_callback_del_full(o, EVAS_CALLBACK_HIDE, _e_comp_object_cb_mirror_hide, cw);
+        evas_object_del(o);
+     }
    EINA_LIST_FREE(cw->obj_agent, o)
      {
         evas_object_freeze_events_set(o, 1);
@@ -3775,6 +3897,8 @@ e_comp_object_damage(Evas_Object *obj, int x, int y, int w, int h)
    cw->updates_exist = 1;
    if (!e_object_is_del(E_OBJECT(cw->ec)))
      e_comp_object_render_update_add(obj);
+   if (cw->obj_mirror_scaled)
+     _e_comp_object_mirror_scaled_queue(cw);
 }
 
 E_API Eina_Bool
@@ -4355,6 +4479,34 @@ e_comp_object_util_mirror_add(Evas_Object *obj)
    return o;
 }
 
+/* create a reduced resolution copy of a client, resampled to the geometry of
+ * the returned object and refreshed from damage at most mirror_scaled_fps
+ * times per second. returns NULL if the client's pixels are not accessible
+ * (native surfaces) and a regular mirror should be used instead
+ */
+E_API Evas_Object *
+e_comp_object_util_mirror_scaled_add(Evas_Object *obj)
+{
+   Evas_Object *o;
+
+   API_ENTRY NULL;
+
+   if ((!cw->ec) || cw->ec->input_only || cw->native || e_comp->gl) return NULL;
+   o = evas_object_image_filled_add(evas_object_evas_get(obj));
+   evas_object_image_colorspace_set(o, EVAS_COLORSPACE_ARGB8888);
+   evas_object_image_smooth_scale_set(o, e_comp_config_get()->smooth_windows);
+   evas_object_image_size_set(o, 1, 1);
+   cw->obj_mirror_scaled = eina_list_append(cw->obj_mirror_scaled, o);
+   evas_object_event_callback_add(o, EVAS_CALLBACK_DEL, _e_comp_object_cb_mirror_scaled_del, cw);
+   evas_object_event_callback_add(o, EVAS_CALLBACK_RESIZE, _e_comp_object_cb_mirror_scaled_resize, cw);
+   evas_object_event_callback_add(o, EVAS_CALLBACK_SHOW, _e_comp_object_cb_mirror_show, cw);
+   evas_object_event_callback_add(o, EVAS_CALLBACK_HIDE, _e_comp_object_cb_mirror_hide, cw);
+   evas_object_data_set(o, "E_Client", cw->ec);
+   evas_object_data_set(o, "comp_mirror", cw);
+   _e_comp_object_mirror_scaled_queue(cw);
+   return o;
+}
+
 //////////////////////////////////////////////////////
 
 E_API Eina_Bool
@@ -1293,6 +1293,8 @@ _e_comp_wl_surface_state_finish(E_Comp_Wl_Surface_State *state)
    EINA_LIST_FREE(free_list, cb)
      wl_resource_destroy(cb);
 
+   e_comp_wl_extension_presentation_feedback_discard(&state->feedbacks);
+
    EINA_LIST_FREE(state->damages, dmg)
      eina_rectangle_free(dmg);
 
@@ -1565,7 +1567,11 @@ _e_comp_wl_surface_state_commit(E_Client *ec, E_Comp_Wl_Surface_State *state)
    state->sx = 0;
    state->sy = 0;
    if (state->new_attach)
-     ec->comp_data->buffer_commit = 1;
+     {
+        ec->comp_data->buffer_commit = 1;
+        /* content which was never shown has been replaced */
+        e_comp_wl_extension_presentation_feedback_discard(&ec->comp_data->feedbacks);
+     }
    state->new_attach = EINA_FALSE;
 
    /* insert state frame callbacks into comp_data->frames
@@ -1573,6 +1579,9 @@ _e_comp_wl_surface_state_commit(E_Client *ec, E_Comp_Wl_Surface_State *state)
    ec->comp_data->frames = eina_list_merge(ec->comp_data->frames,
                                            state->frames);
    state->frames = NULL;
+   ec->comp_data->feedbacks = eina_list_merge(ec->comp_data->feedbacks,
+                                              state->feedbacks);
+   state->feedbacks = NULL;
 
    /* put state damages into surface */
    if ((!e_comp->nocomp) && (ec->frame))
@@ -1712,11 +1721,92 @@ _e_comp_wl_surface_cb_damage(struct wl_client *client, struct wl_resource *resou
    _e_comp_wl_surface_cb_damage_buffer(client, resource, x, y, w, h);
 }
 
+/* frame callbacks held back until their deadline before the next refresh */
+static Eina_List *_frames_due = NULL;
+static Ecore_Timer *_frames_due_timer = NULL;
+
+static Eina_Bool
+_e_comp_wl_frames_due_cb(void *d EINA_UNUSED)
+{
+   struct wl_resource *cb;
+   Eina_List *free_list;
+   double t = ecore_loop_time_get();
+
+   _frames_due_timer = NULL;
+   /* The resource destroy callback will walk the list,
+    * so move the list to a temporary first.
+    */
+   free_list = _frames_due;
+   _frames_due = NULL;
+   EINA_LIST_FREE(free_list, cb)
+     {
+        wl_callback_send_done(cb, t * 1000);
+        wl_resource_destroy(cb);
+     }
+   return ECORE_CALLBACK_CANCEL;
+}
+
+/* called after a render of the client: send its frame callbacks either right
+ * away or, if wl_frame_deadline is set, that long before the predicted next
+ * refresh so clients draw with the freshest input and don't queue up frames
+ */
+EINTERN void
+e_comp_wl_frames_done(E_Client *ec, double render_time)
+{
+   E_Comp_Wl_Output *wlo = NULL;
+   struct wl_resource *cb;
+   Eina_List *free_list;
+   double deadline, period, now;
+
+   e_comp_wl_extension_presentation_rendered(ec);
+   if (!ec->comp_data->frames) return;
+   /* The destroy callback will remove items from the frame list
+    * so we move the list to a temporary before walking it here
+    */
+   free_list = ec->comp_data->frames;
+   ec->comp_data->frames = NULL;
+
+   deadline = e_comp_config_get()->wl_frame_deadline;
+   if (deadline > 0.0)
+     {
+        if (ec->zone) wlo = ec->zone->output;
+        if (wlo && wlo->refresh)
+          period = 1000.0 / (double)wlo->refresh;
+        else
+          period = ecore_animator_frametime_get();
+        now = ecore_time_get();
+        /* render_time is the refresh this frame was drawn for */
+        deadline = render_time + period - deadline;
+        while (deadline + period <= now) deadline += period;
+        if (deadline > now)
+          {
+             Eina_List *l;
+
+             /* the client may be freed before these go out - they are in
+              * no client list any more so don't point back at it */
+             EINA_LIST_FOREACH(free_list, l, cb)
+               wl_resource_set_user_data(cb, NULL);
+             _frames_due = eina_list_merge(_frames_due, free_list);
+             if (!_frames_due_timer)
+               _frames_due_timer =
+                 ecore_timer_loop_add(deadline - now,
+                                      _e_comp_wl_frames_due_cb, NULL);
+             return;
+          }
+     }
+   EINA_LIST_FREE(free_list, cb)
+     {
+        wl_callback_send_done(cb, render_time * 1000);
+        wl_resource_destroy(cb);
+     }
+}
+
 static void
 _e_comp_wl_frame_cb_destroy(struct wl_resource *resource)
 {
    E_Client *ec;
 
+   _frames_due = eina_list_remove(_frames_due, resource);
    if (!(ec = wl_resource_get_user_data(resource))) return;
    if (e_object_is_del(E_OBJECT(ec))) return;
 
@@ -2170,6 +2260,9 @@ _e_comp_wl_subsurface_commit_to_cache(E_Client *ec)
    sdata->cached.frames = eina_list_merge(sdata->cached.frames,
                                           cdata->pending.frames);
    cdata->pending.frames = NULL;
+   sdata->cached.feedbacks = eina_list_merge(sdata->cached.feedbacks,
+                                             cdata->pending.feedbacks);
+   cdata->pending.feedbacks = NULL;
    sdata->cached.has_data = EINA_TRUE;
 }
 
@@ -2654,6 +2747,8 @@ _e_comp_wl_client_cb_del(void *data EINA_UNUSED, E_Client *ec)
    EINA_LIST_FREE(free_list, cb)
      wl_resource_destroy(cb);
 
+   e_comp_wl_extension_presentation_feedback_discard(&ec->comp_data->feedbacks);
+
    if (ec->comp_data->surface)
      wl_resource_set_user_data(ec->comp_data->surface, NULL);
 
@@ -80,7 +80,7 @@ struct _E_Comp_Wl_Surface_State
    int bw, bh;
    E_Comp_Wl_Buffer *buffer;
    struct wl_listener buffer_destroy_listener;
-   Eina_List *damages, *frames;
+   Eina_List *damages, *frames, *feedbacks;
    Eina_Tiler *input, *opaque;
    Eina_Bool new_attach E_BITFIELD;
    Eina_Bool has_data E_BITFIELD;
@@ -142,6 +142,12 @@ typedef struct E_Comp_Wl_Extension_Data
      {
         struct wl_global *global;
      } efl_aux_hints;
+   struct
+     {
+        struct wl_global *global;
+        Eina_List *presenting; // feedbacks rendered, waiting for the next refresh
+        uint64_t seq;
+     } wp_presentation;
 } E_Comp_Wl_Extension_Data;
 
 struct _E_Comp_Wl_Data
@@ -339,6 +345,7 @@ struct _E_Comp_Wl_Client_Data
    E_Comp_Wl_Surface_State pending;
 
    Eina_List *frames;
+   Eina_List *feedbacks; // wp_presentation_feedback for committed content
    Eina_List *constraints;
 
    struct
@@ -438,6 +445,9 @@ E_API Eina_Bool e_comp_wl_extension_pointer_constraints_update(E_Client *ec, int
 E_API void e_comp_wl_extension_pointer_unconstrain(E_Client *ec);
 E_API void e_comp_wl_extension_action_route_pid_allowed_set(uint32_t pid, Eina_Bool allow);
 E_API const void *e_comp_wl_extension_action_route_interface_get(int *version);
+EINTERN void e_comp_wl_extension_presentation_feedback_discard(Eina_List **feedbacks);
+EINTERN void e_comp_wl_extension_presentation_rendered(E_Client *ec);
+EINTERN void e_comp_wl_frames_done(E_Client *ec, double render_time);
 
 
 E_API void
@@ -26,6 +26,7 @@
 #define EXECUTIVE_MODE_ENABLED
 #define E_COMP_WL
 #include "e.h"
+#include <sys/mman.h>
 
 #if defined(__clang__)
 # pragma clang diagnostic ignored "-Wunused-parameter"
@@ -799,92 +800,252 @@ _e_comp_wl_data_cb_bind_manager(struct wl_client *client, void *data EINA_UNUSED
                                   e_comp->wl_comp_data, NULL);
 }
 
+static int
+_e_comp_wl_clipboard_memfd_new(void)
+{
+   const char *path;
+   char tmp[PATH_MAX];
+   Eina_Tmpstr *tmpstr = NULL;
+   int fd;
+
+#ifdef MFD_CLOEXEC
+   fd = memfd_create("e-wl-clipboard", MFD_CLOEXEC);
+   if (fd >= 0) return fd;
+#endif
+   /* no memfd: use an unlinked file in the runtime dir instead */
+   if (!(path = getenv("XDG_RUNTIME_DIR"))) return -1;
+   if (snprintf(tmp, sizeof(tmp), "%s/e-wl-clipboard-XXXXXX", path) >=
+       (int)sizeof(tmp))
+     return -1;
+   if ((fd = eina_file_mkstemp(tmp, &tmpstr)) < 0) return -1;
+   unlink(tmpstr);
+   eina_tmpstr_del(tmpstr);
+   eina_file_close_on_exec(fd, EINA_TRUE);
+   return fd;
+}
+
+static void
+_e_comp_wl_clipboard_offer_free(E_Comp_Wl_Clipboard_Offer *offer)
+{
+   if (offer->fd_handler) ecore_main_fd_handler_del(offer->fd_handler);
+   close(offer->fd);
+   e_comp_wl_clipboard_source_unref(offer->source);
+   free(offer);
+}
+
 static Eina_Bool
-_e_comp_wl_clipboard_offer_load(void *data, Ecore_Fd_Handler *handler)
+_e_comp_wl_clipboard_offer_load(void *data, Ecore_Fd_Handler *handler EINA_UNUSED)
 {
    E_Comp_Wl_Clipboard_Offer *offer;
-   char *p;
+   E_Comp_Wl_Clipboard_Contents *cc;
+   char buf[65536];
+   ssize_t len = -1;
    size_t size;
-   int len;
-   int fd;
+#ifdef HAVE_SPLICE
+   loff_t off;
+#endif
 
    if (!(offer = (E_Comp_Wl_Clipboard_Offer *)data))
      return ECORE_CALLBACK_CANCEL;
 
-   fd = ecore_main_fd_handler_fd_get(handler);
-
-   size = offer->source->contents.size;
-   p = (char *)offer->source->contents.data;
-   len = write(fd, p + offer->offset, size - offer->offset);
+   cc = offer->contents;
+   size = cc->size - offer->offset;
+   if (size > CLIPBOARD_CHUNK) size = CLIPBOARD_CHUNK;
+#ifdef HAVE_SPLICE
+   /* move data from the saved file into the receiving pipe in the kernel,
+    * falling back to copying if the receiver's fd isn't a pipe */
+   off = offer->offset;
+   len = splice(cc->mem_fd, &off, offer->fd, NULL, size, SPLICE_F_NONBLOCK);
+   if ((len < 0) && (errno == EINVAL))
+#endif
+     {
+        if (size > sizeof(buf)) size = sizeof(buf);
+        len = pread(cc->mem_fd, buf, size, offer->offset);
+        if (len > 0) len = write(offer->fd, buf, len);
+     }
    if (len > 0) offer->offset += len;
+   else if ((len < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+     return ECORE_CALLBACK_RENEW;
 
-   if ((offer->offset == size) || (len <= 0))
+   if ((offer->offset == cc->size) || (len <= 0))
      {
-        close(fd);
-        ecore_main_fd_handler_del(handler);
-        e_comp_wl_clipboard_source_unref(offer->source);
-        free(offer);
+        offer->fd_handler = NULL;
+        _e_comp_wl_clipboard_offer_free(offer);
+        return ECORE_CALLBACK_CANCEL;
      }
 
    return ECORE_CALLBACK_RENEW;
 }
 
 static void
-_e_comp_wl_clipboard_offer_create(E_Comp_Wl_Clipboard_Source *source, int fd)
+_e_comp_wl_clipboard_offer_start(E_Comp_Wl_Clipboard_Offer *offer)
+{
+   if ((offer->contents->failed) || (!offer->contents->size))
+     {
+        _e_comp_wl_clipboard_offer_free(offer);
+        return;
+     }
+   offer->fd_handler =
+     ecore_main_fd_handler_add(offer->fd, ECORE_FD_WRITE,
+                               _e_comp_wl_clipboard_offer_load, offer,
+                               NULL, NULL);
+   if (!offer->fd_handler) _e_comp_wl_clipboard_offer_free(offer);
+}
+
+static void
+_e_comp_wl_clipboard_offer_create(E_Comp_Wl_Clipboard_Contents *cc, int fd)
 {
    E_Comp_Wl_Clipboard_Offer *offer;
+   int flags;
 
    offer = E_NEW(E_Comp_Wl_Clipboard_Offer, 1);
+   if (!offer)
+     {
+        close(fd);
+        return;
+     }
 
+   flags = fcntl(fd, F_GETFL);
+   if (flags >= 0) fcntl(fd, F_SETFL, flags | O_NONBLOCK);
    offer->offset = 0;
-   offer->source = source;
-   source->ref++;
-   offer->fd_handler =
-     ecore_main_fd_handler_add(fd, ECORE_FD_WRITE,
-                               _e_comp_wl_clipboard_offer_load, offer,
-                               NULL, NULL);
+   offer->fd = fd;
+   offer->contents = cc;
+   offer->source = cc->source;
+   cc->source->ref++;
+   /* only send once everything is saved */
+   if (cc->done) _e_comp_wl_clipboard_offer_start(offer);
+   else cc->offers = eina_list_append(cc->offers, offer);
 }
 
-static Eina_Bool
-_e_comp_wl_clipboard_source_save(void *data EINA_UNUSED, Ecore_Fd_Handler *handler)
+static void
+_e_comp_wl_clipboard_contents_done(E_Comp_Wl_Clipboard_Contents *cc, Eina_Bool failed)
 {
    E_Comp_Wl_Clipboard_Source *source;
-   char *p;
-   int len, size;
+   E_Comp_Wl_Clipboard_Offer *offer;
 
-   if (!(source = (E_Comp_Wl_Clipboard_Source *)e_comp_wl->clipboard.source))
-     return ECORE_CALLBACK_CANCEL;
+   if (cc->fd_handler) ecore_main_fd_handler_del(cc->fd_handler);
+   cc->fd_handler = NULL;
+   E_FREE_FUNC(cc->timeout, ecore_timer_del);
+   close(cc->fd);
+   cc->fd = -1;
+   cc->done = EINA_TRUE;
+   cc->failed = failed;
+   /* the last offer may drop the last source ref */
+   source = cc->source;
+   source->ref++;
+   EINA_LIST_FREE(cc->offers, offer)
+     _e_comp_wl_clipboard_offer_start(offer);
+   e_comp_wl_clipboard_source_unref(source);
+}
 
-   /* extend contents buffer */
-   if ((source->contents.alloc - source->contents.size) < CLIPBOARD_CHUNK)
+static Eina_Bool
+_e_comp_wl_clipboard_source_save(void *data, Ecore_Fd_Handler *handler EINA_UNUSED)
+{
+   E_Comp_Wl_Clipboard_Contents *cc = data;
+   char buf[65536];
+   ssize_t len = -1;
+#ifdef HAVE_SPLICE
+   loff_t off;
+
+   /* move data from the owner's pipe into the saved file in the kernel,
+    * falling back to copying if splice isn't supported here */
+   off = cc->size;
+   len = splice(cc->fd, NULL, cc->mem_fd, &off, CLIPBOARD_CHUNK,
+                SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+   if ((len < 0) && (errno == EINVAL))
+#endif
      {
-        wl_array_add(&source->contents, CLIPBOARD_CHUNK);
-        source->contents.size -= CLIPBOARD_CHUNK;
+        len = read(cc->fd, buf, sizeof(buf));
+        if ((len > 0) && (pwrite(cc->mem_fd, buf, len, cc->size) != len))
+          len = -1;
      }
 
-   p = (char *)source->contents.data + source->contents.size;
-   size = source->contents.alloc - source->contents.size;
-   len = read(source->fd, p, size);
-
    if (len == 0)
-     {
-        ecore_main_fd_handler_del(handler);
-        close(source->fd);
-        source->fd_handler = NULL;
-     }
+     _e_comp_wl_clipboard_contents_done(cc, EINA_FALSE);
    else if (len < 0)
      {
-        e_comp_wl_clipboard_source_unref(source);
-        e_comp_wl->clipboard.source = NULL;
+        if ((errno == EAGAIN) || (errno == EINTR))
+          return ECORE_CALLBACK_RENEW;
+        _e_comp_wl_clipboard_contents_done(cc, EINA_TRUE);
      }
    else
      {
-        source->contents.size += len;
+        cc->size += len;
+        if (cc->timeout) ecore_timer_loop_reset(cc->timeout);
      }
 
    return ECORE_CALLBACK_RENEW;
 }
 
+static Eina_Bool
+_e_comp_wl_clipboard_source_timeout(void *data)
+{
+   E_Comp_Wl_Clipboard_Contents *cc = data;
+
+   /* an owner that never closes its pipe would keep this pinned forever */
+   cc->timeout = NULL;
+   _e_comp_wl_clipboard_contents_done(cc, EINA_TRUE);
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static E_Comp_Wl_Clipboard_Contents *
+_e_comp_wl_clipboard_contents_add(E_Comp_Wl_Clipboard_Source *source, const char *mime_type, int fd)
+{
+   E_Comp_Wl_Clipboard_Contents *cc;
+   int flags;
+
+   cc = E_NEW(E_Comp_Wl_Clipboard_Contents, 1);
+   if (!cc) return NULL;
+   cc->mem_fd = _e_comp_wl_clipboard_memfd_new();
+   if (cc->mem_fd < 0)
+     {
+        free(cc);
+        return NULL;
+     }
+   flags = fcntl(fd, F_GETFL);
+   if (flags >= 0) fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+   cc->fd_handler =
+     ecore_main_fd_handler_file_add(fd, ECORE_FD_READ | ECORE_FD_ERROR,
+                                    _e_comp_wl_clipboard_source_save,
+                                    cc, NULL, NULL);
+   if (!cc->fd_handler)
+     {
+        close(cc->mem_fd);
+        free(cc);
+        return NULL;
+     }
+   cc->timeout = ecore_timer_loop_add(CLIPBOARD_TIMEOUT,
+                                      _e_comp_wl_clipboard_source_timeout, cc);
+   cc->fd = fd;
+   cc->source = source;
+   cc->mime_type = eina_stringshare_add(mime_type);
+   source->contents = eina_list_append(source->contents, cc);
+   if (!source->data_source.mime_types)
+     source->data_source.mime_types = eina_array_new(1);
+   eina_array_push(source->data_source.mime_types,
+                   eina_stringshare_add(mime_type));
+   return cc;
+}
+
+static void
+_e_comp_wl_clipboard_contents_free(E_Comp_Wl_Clipboard_Contents *cc)
+{
+   E_Comp_Wl_Clipboard_Offer *offer;
+
+   /* waiting offers hold a source ref so there are none left here */
+   EINA_LIST_FREE(cc->offers, offer)
+     {
+        close(offer->fd);
+        free(offer);
+     }
+   if (cc->fd_handler) ecore_main_fd_handler_del(cc->fd_handler);
+   if (cc->timeout) ecore_timer_del(cc->timeout);
+   if (cc->fd >= 0) close(cc->fd);
+   close(cc->mem_fd);
+   eina_stringshare_del(cc->mime_type);
+   free(cc);
+}
+
 static void
 _e_comp_wl_clipboard_source_target_send(E_Comp_Wl_Data_Source *source EINA_UNUSED, uint32_t serial EINA_UNUSED, const char *mime_type EINA_UNUSED)
 {
@@ -894,16 +1055,21 @@ static void
 _e_comp_wl_clipboard_source_send_send(E_Comp_Wl_Data_Source *source, const char *mime_type, int fd)
 {
    E_Comp_Wl_Clipboard_Source *clip_source;
-   char *t;
+   E_Comp_Wl_Clipboard_Contents *cc;
+   Eina_List *l;
 
    clip_source = container_of(source, E_Comp_Wl_Clipboard_Source, data_source);
    if (!clip_source) return;
 
-   t = eina_array_data_get(source->mime_types, 0);
-   if (!strcmp(mime_type, t))
-     _e_comp_wl_clipboard_offer_create(clip_source, fd);
-   else
-     close(fd);
+   EINA_LIST_FOREACH(clip_source->contents, l, cc)
+     {
+        if (!strcmp(mime_type, cc->mime_type))
+          {
+             _e_comp_wl_clipboard_offer_create(cc, fd);
+             return;
+          }
+     }
+   close(fd);
 }
 
 static void
@@ -916,6 +1082,7 @@ _e_comp_wl_clipboard_selection_set(struct wl_listener *listener EINA_UNUSED, voi
 {
    E_Comp_Wl_Data_Source *sel_source;
    E_Comp_Wl_Clipboard_Source *clip_source;
+   unsigned int i, n;
    int p[2];
    char *mime_type;
 
@@ -937,19 +1104,32 @@ _e_comp_wl_clipboard_selection_set(struct wl_listener *listener EINA_UNUSED, voi
      e_comp_wl_clipboard_source_unref(clip_source);
 
    e_comp_wl->clipboard.source = NULL;
-   mime_type = eina_array_data_get(sel_source->mime_types, 0);
+   if (!sel_source->mime_types) return;
 
-   if (pipe2(p, O_CLOEXEC) == -1)
-     return;
+   clip_source =
+     e_comp_wl_clipboard_source_create(NULL, e_comp_wl->selection.serial, -1);
+   if (!clip_source) return;
 
-   sel_source->send(sel_source, mime_type, p[1]);
+   /* keep the first few types offered so pasting after the owner is gone
+    * still gets a choice */
+   n = eina_array_count(sel_source->mime_types);
+   for (i = 0; (i < n) && (i < CLIPBOARD_MIME_MAX); i++)
+     {
+        mime_type = eina_array_data_get(sel_source->mime_types, i);
+        if (pipe2(p, O_CLOEXEC) == -1) break;
+
+        sel_source->send(sel_source, mime_type, p[1]);
 
-   e_comp_wl->clipboard.source =
-     e_comp_wl_clipboard_source_create(mime_type,
-                                       e_comp_wl->selection.serial, p[0]);
+        if (!_e_comp_wl_clipboard_contents_add(clip_source, mime_type, p[0]))
+          close(p[0]);
+     }
 
-   if (!e_comp_wl->clipboard.source)
-     close(p[0]);
+   if (!clip_source->contents)
+     {
+        e_comp_wl_clipboard_source_unref(clip_source);
+        return;
+     }
+   e_comp_wl->clipboard.source = clip_source;
 }
 
 static void
@@ -1238,35 +1418,25 @@ e_comp_wl_clipboard_source_create(const char *mime_type, uint32_t serial, int fd
    source->data_source.send = _e_comp_wl_clipboard_source_send_send;
    source->data_source.cancelled = _e_comp_wl_clipboard_source_cancelled_send;
 
-   wl_array_init(&source->contents);
    wl_signal_init(&source->data_source.destroy_signal);
 
    source->ref = 1;
    source->serial = serial;
 
-   if (mime_type)
+   if ((mime_type) && (fd >= 0))
      {
-        if (!source->data_source.mime_types)
-          source->data_source.mime_types = eina_array_new(1);
-        eina_array_push(source->data_source.mime_types,
-                        eina_stringshare_add(mime_type));
-     }
-
-   if (fd > 0)
-     {
-        source->fd_handler =
-          ecore_main_fd_handler_file_add(fd, ECORE_FD_READ | ECORE_FD_ERROR,
-                                         _e_comp_wl_clipboard_source_save,
-                                         e_comp->wl_comp_data, NULL, NULL);
-        if (!source->fd_handler)
+        if (!_e_comp_wl_clipboard_contents_add(source, mime_type, fd))
           {
-             _mime_types_free(&source->data_source);
              free(source);
              return NULL;
           }
      }
-
-   source->fd = fd;
+   else if (mime_type)
+     {
+        source->data_source.mime_types = eina_array_new(1);
+        eina_array_push(source->data_source.mime_types,
+                        eina_stringshare_add(mime_type));
+     }
 
    return source;
 }
@@ -1274,15 +1444,14 @@ e_comp_wl_clipboard_source_create(const char *mime_type, uint32_t serial, int fd
 E_API void
 e_comp_wl_clipboard_source_unref(E_Comp_Wl_Clipboard_Source *source)
 {
+   E_Comp_Wl_Clipboard_Contents *cc;
+
    EINA_SAFETY_ON_NULL_RETURN(source);
    source->ref--;
    if (source->ref > 0) return;
 
-   if (source->fd_handler)
-     {
-        ecore_main_fd_handler_del(source->fd_handler);
-        close(source->fd);
-     }
+   EINA_LIST_FREE(source->contents, cc)
+     _e_comp_wl_clipboard_contents_free(cc);
 
    _mime_types_free(&source->data_source);
    if (source == e_comp_wl->clipboard.source)
@@ -1291,7 +1460,6 @@ e_comp_wl_clipboard_source_unref(E_Comp_Wl_Clipboard_Source *source)
      e_comp_wl->selection.data_source = NULL;
 
    wl_signal_emit(&source->data_source.destroy_signal, &source->data_source);
-   wl_array_release(&source->contents);
    free(source);
 }
 
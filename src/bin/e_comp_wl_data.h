@@ -30,12 +30,16 @@
 
 #  include "e_comp_wl.h"
 
-#  define CLIPBOARD_CHUNK 1024
+#  define CLIPBOARD_CHUNK (1 << 20) //bytes moved per pass in and out of the saved clipboard
+#  define CLIPBOARD_TIMEOUT 10.0 //give up on an owner that sends nothing for this long
+#  define CLIPBOARD_MIME_MAX 4
+
 
 typedef struct _E_Comp_Wl_Data_Source E_Comp_Wl_Data_Source;
 typedef struct _E_Comp_Wl_Data_Offer E_Comp_Wl_Data_Offer;
 typedef struct _E_Comp_Wl_Clipboard_Source E_Comp_Wl_Clipboard_Source;
 typedef struct _E_Comp_Wl_Clipboard_Offer E_Comp_Wl_Clipboard_Offer;
+typedef struct _E_Comp_Wl_Clipboard_Contents E_Comp_Wl_Clipboard_Contents;
 
 struct _E_Comp_Wl_Data_Source
 {
@@ -71,19 +75,33 @@ struct _E_Comp_Wl_Data_Offer
 struct _E_Comp_Wl_Clipboard_Source
 {
    E_Comp_Wl_Data_Source data_source;
-   Ecore_Fd_Handler *fd_handler;
    uint32_t serial;
 
-   struct wl_array contents; //for extendable buffer
+   Eina_List *contents; //E_Comp_Wl_Clipboard_Contents per saved mime type
    int ref;
-   int fd;
+};
+
+struct _E_Comp_Wl_Clipboard_Contents
+{
+   E_Comp_Wl_Clipboard_Source *source;
+   const char *mime_type;
+   Ecore_Fd_Handler *fd_handler; //reading from the selection owner
+   Ecore_Timer *timeout; //owner went quiet without closing its pipe
+   Eina_List *offers; //offers waiting for the data to be complete
+   size_t size;
+   int fd; //pipe from the selection owner
+   int mem_fd; //saved data
+   Eina_Bool done : 1;
+   Eina_Bool failed : 1;
 };
 
 struct _E_Comp_Wl_Clipboard_Offer
 {
    E_Comp_Wl_Clipboard_Source *source;
+   E_Comp_Wl_Clipboard_Contents *contents;
    Ecore_Fd_Handler *fd_handler;
    size_t offset;
+   int fd;
 };
 
 E_API void e_comp_wl_data_device_send_enter(E_Client *ec);
@@ -9,6 +9,7 @@
 #include "relative-pointer-unstable-v1-server-protocol.h"
 #include "pointer-constraints-unstable-v1-server-protocol.h"
 #include "action_route-server-protocol.h"
+#include "presentation-time-server-protocol.h"
 
 
 /* mutter uses 32, seems reasonable */
@@ -47,6 +48,13 @@ typedef struct Constraint
 
 static Eina_List *active_constraints;
 
+typedef struct Presentation_Feedback
+{
+   struct wl_resource *res;
+   unsigned int refresh; // mHz of the output the surface was on
+   int zone;
+} Presentation_Feedback;
+
 static void
 _e_comp_wl_extensions_client_move_begin(void *d EINA_UNUSED, E_Client *ec)
 {
@@ -939,6 +947,167 @@ static const struct zxdg_importer_v1_interface _e_zxdg_importer_v1_interface =
    _e_comp_wl_zxdg_importer_v1_import,
 };
 
+/////////////////////////////////////////////////////////
+
+static void _presentation_tick(void *data, const Efl_Event *event);
+
+static void
+_presentation_feedback_del(struct wl_resource *resource)
+{
+   E_Client *ec = wl_resource_get_user_data(resource);
+   Presentation_Feedback *pf;
+   Eina_List *l;
+
+   if (ec)
+     {
+        if (e_object_is_del(E_OBJECT(ec))) return;
+        ec->comp_data->pending.feedbacks =
+          eina_list_remove(ec->comp_data->pending.feedbacks, resource);
+        ec->comp_data->feedbacks =
+          eina_list_remove(ec->comp_data->feedbacks, resource);
+        if (ec->comp_data->sub.data)
+          ec->comp_data->sub.data->cached.feedbacks =
+            eina_list_remove(ec->comp_data->sub.data->cached.feedbacks, resource);
+        return;
+     }
+   EINA_LIST_FOREACH(e_comp_wl->extensions->wp_presentation.presenting, l, pf)
+     {
+        if (pf->res != resource) continue;
+        e_comp_wl->extensions->wp_presentation.presenting =
+          eina_list_remove_list(e_comp_wl->extensions->wp_presentation.presenting, l);
+        free(pf);
+        break;
+     }
+}
+
+static void
+_e_comp_wl_wp_presentation_destroy(struct wl_client *client EINA_UNUSED, struct wl_resource *resource)
+{
+   wl_resource_destroy(resource);
+}
+
+static void
+_e_comp_wl_wp_presentation_feedback(struct wl_client *client, struct wl_resource *resource, struct wl_resource *surface, uint32_t callback)
+{
+   E_Client *ec = wl_resource_get_user_data(surface);
+   struct wl_resource *res;
+
+   if ((!ec) || e_object_is_del(E_OBJECT(ec))) return;
+   res = wl_resource_create(client, &wp_presentation_feedback_interface,
+                            wl_resource_get_version(resource), callback);
+   if (!res)
+     {
+        wl_resource_post_no_memory(resource);
+        return;
+     }
+   wl_resource_set_implementation(res, NULL, ec, _presentation_feedback_del);
+   ec->comp_data->pending.feedbacks =
+     eina_list_append(ec->comp_data->pending.feedbacks, res);
+}
+
+static void
+_presentation_send(Presentation_Feedback *pf, double t, uint32_t flags)
+{
+   struct wl_client *wc = wl_resource_get_client(pf->res);
+   uint64_t sec = t, seq = e_comp_wl->extensions->wp_presentation.seq;
+   uint32_t nsec = (t - (double)sec) * 1000000000.0;
+   uint32_t refresh = 0;
+   Eina_List *l, *ll;
+   E_Zone *zone;
+
+   EINA_LIST_FOREACH(e_comp->zones, l, zone)
+     {
+        E_Comp_Wl_Output *wlo = zone->output;
+        struct wl_resource *res;
+
+        if ((zone->id != pf->zone) || (!wlo)) continue;
+        EINA_LIST_FOREACH(wlo->resources, ll, res)
+          {
+             if (wl_resource_get_client(res) == wc)
+               wp_presentation_feedback_send_sync_output(pf->res, res);
+          }
+     }
+   if (pf->refresh)
+     refresh = 1000000000000ULL / pf->refresh;
+   if (!(flags & WP_PRESENTATION_FEEDBACK_KIND_VSYNC)) seq = 0;
+   wp_presentation_feedback_send_presented(pf->res, sec >> 32, sec & 0xffffffff,
+                                           nsec, refresh, seq >> 32,
+                                           seq & 0xffffffff, flags);
+   wl_resource_destroy(pf->res);
+}
+
+static void
+_presentation_tick(void *data EINA_UNUSED, const Efl_Event *event EINA_UNUSED)
+{
+   Presentation_Feedback *pf;
+   Eina_List *l;
+   const char *engine;
+   uint32_t flags = 0;
+   double t = ecore_loop_time_get();
+
+   /* the previous frame's page flip completes at this refresh */
+   efl_event_callback_del(e_comp->evas, EFL_CANVAS_OBJECT_EVENT_ANIMATOR_TICK,
+                          _presentation_tick, NULL);
+   engine = ecore_evas_engine_name_get(e_comp->ee);
+   if (engine && strstr(engine, "drm"))
+     flags |= WP_PRESENTATION_FEEDBACK_KIND_VSYNC;
+   e_comp_wl->extensions->wp_presentation.seq++;
+   l = e_comp_wl->extensions->wp_presentation.presenting;
+   e_comp_wl->extensions->wp_presentation.presenting = NULL;
+   EINA_LIST_FREE(l, pf)
+     {
+        _presentation_send(pf, t, flags);
+        free(pf);
+     }
+}
+
+EINTERN void
+e_comp_wl_extension_presentation_feedback_discard(Eina_List **feedbacks)
+{
+   struct wl_resource *res;
+   Eina_List *l;
+
+   /* the resource destroy callback walks the list, so detach it first */
+   l = *feedbacks;
+   *feedbacks = NULL;
+   EINA_LIST_FREE(l, res)
+     {
+        wp_presentation_feedback_send_discarded(res);
+        wl_resource_destroy(res);
+     }
+}
+
+EINTERN void
+e_comp_wl_extension_presentation_rendered(E_Client *ec)
+{
+   Presentation_Feedback *pf;
+   struct wl_resource *res;
+   Eina_List *l;
+
+   if ((!ec->comp_data) || (!ec->comp_data->feedbacks)) return;
+   if (!e_comp_wl->extensions->wp_presentation.presenting)
+     efl_event_callback_add(e_comp->evas, EFL_CANVAS_OBJECT_EVENT_ANIMATOR_TICK,
+                            _presentation_tick, NULL);
+   l = ec->comp_data->feedbacks;
+   ec->comp_data->feedbacks = NULL;
+   EINA_LIST_FREE(l, res)
+     {
+        pf = E_NEW(Presentation_Feedback, 1);
+        pf->res = res;
+        pf->zone = -1;
+        if (ec->zone)
+          {
+             E_Comp_Wl_Output *wlo = ec->zone->output;
+
+             pf->zone = ec->zone->id;
+             if (wlo) pf->refresh = wlo->refresh;
+          }
+        wl_resource_set_user_data(res, NULL);
+        e_comp_wl->extensions->wp_presentation.presenting =
+          eina_list_append(e_comp_wl->extensions->wp_presentation.presenting, pf);
+     }
+}
+
 static const struct zwp_relative_pointer_manager_v1_interface _e_zwp_relative_pointer_manager_v1_interface =
 {
    _e_comp_wl_zwp_relative_pointer_manager_v1_destroy,
@@ -952,6 +1121,12 @@ static const struct zwp_pointer_constraints_v1_interface _e_zwp_pointer_constrai
    _e_comp_wl_zwp_pointer_constraints_v1_confine_pointer,
 };
 
+static const struct wp_presentation_interface _e_wp_presentation_interface =
+{
+   _e_comp_wl_wp_presentation_destroy,
+   _e_comp_wl_wp_presentation_feedback,
+};
+
 static const struct action_route_interface _e_action_route_interface =
 {
    _e_comp_wl_action_route_bind_action,
@@ -988,6 +1163,9 @@ GLOBAL_BIND_CB(zxdg_exporter_v1, zxdg_exporter_v1_interface)
 GLOBAL_BIND_CB(zxdg_importer_v1, zxdg_importer_v1_interface)
 GLOBAL_BIND_CB(zwp_relative_pointer_manager_v1, zwp_relative_pointer_manager_v1_interface)
 GLOBAL_BIND_CB(zwp_pointer_constraints_v1, zwp_pointer_constraints_v1_interface)
+GLOBAL_BIND_CB(wp_presentation, wp_presentation_interface,
+     wp_presentation_send_clock_id(res, CLOCK_MONOTONIC);
+)
 GLOBAL_BIND_CB(action_route, action_route_interface,
      e_binding_key_list_cb = _action_route_key_list_cb;
      key_bindings = eina_hash_string_superfast_new(NULL);
@@ -1087,6 +1265,7 @@ e_comp_wl_extensions_init(void)
    GLOBAL_CREATE_OR_RETURN(zwp_pointer_constraints_v1, zwp_pointer_constraints_v1_interface, 1);
    e_comp_wl->extensions->zwp_pointer_constraints_v1.constraints = eina_hash_pointer_new(NULL);
    GLOBAL_CREATE_OR_RETURN(action_route, action_route_interface, 1);
+   GLOBAL_CREATE_OR_RETURN(wp_presentation, wp_presentation_interface, 1);
 
    ecore_event_handler_add(ECORE_WL2_EVENT_SYNC_DONE, _dmabuf_add, NULL);
 
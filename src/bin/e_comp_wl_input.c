@@ -19,6 +19,22 @@ static struct xkb_context *cached_context;
 static struct xkb_keymap *cached_keymap;
 static xkb_layout_index_t choosen_group;
 
+//compiled keymaps by rule names, so switching between layouts used before
+//is a lookup instead of a compile. all share one xkb context
+typedef struct
+{
+   struct xkb_keymap *keymap;
+   char *string;
+   int size;
+   int fd; // sealed memfd with string handed to every client, or -1
+} E_Comp_Wl_Keymap;
+
+#define KEYMAP_CACHE_MAX 16
+
+static Eina_Hash *keymap_cache = NULL;
+static E_Comp_Wl_Keymap *keymap_current = NULL;
+static struct xkb_context *keymap_context = NULL;
+
 static void
 _e_comp_wl_input_update_seat_caps(void)
 {
@@ -382,6 +398,52 @@ _e_comp_wl_input_keymap_fd_get(void)
    return fd;
 }
 
+static void
+_e_comp_wl_input_keymap_cache_free(E_Comp_Wl_Keymap *km)
+{
+   if (km == keymap_current) keymap_current = NULL;
+   if (km->fd >= 0) close(km->fd);
+   free(km->string);
+   xkb_keymap_unref(km->keymap);
+   free(km);
+}
+
+static int
+_e_comp_wl_input_keymap_sealed_fd_get(E_Comp_Wl_Keymap *km)
+{
+#if defined(MFD_ALLOW_SEALING) && defined(F_ADD_SEALS)
+   int fd;
+   ssize_t done = 0, ret;
+
+   if (km->fd >= 0) return km->fd;
+   fd = memfd_create("e-wl-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+   if (fd < 0) return -1;
+   while (done < km->size)
+     {
+        ret = write(fd, km->string + done, km->size - done);
+        if (ret <= 0)
+          {
+             if ((ret < 0) && (errno == EINTR)) continue;
+             close(fd);
+             return -1;
+          }
+        done += ret;
+     }
+   /* once sealed nobody can change it so all clients can share one fd */
+   if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW |
+             F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+     {
+        close(fd);
+        return -1;
+     }
+   km->fd = fd;
+   return fd;
+#else
+   (void)km;
+   return -1;
+#endif
+}
+
 static void
 _e_comp_wl_input_state_update(void)
 {
@@ -412,6 +474,17 @@ e_comp_wl_input_keymap_send(struct wl_resource *res)
 {
    int fd;
 
+   if ((keymap_current) && (keymap_current->keymap == e_comp_wl->xkb.keymap))
+     {
+        fd = _e_comp_wl_input_keymap_sealed_fd_get(keymap_current);
+        if (fd >= 0)
+          {
+             wl_keyboard_send_keymap(res, WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1,
+                                     fd, keymap_current->size);
+             return;
+          }
+     }
+
    fd = _e_comp_wl_input_keymap_fd_get();
    if (fd == -1)
      return;
@@ -452,7 +525,11 @@ _e_comp_wl_input_keymap_update(struct xkb_keymap *keymap)
    /* update the state */
    _e_comp_wl_input_state_update();
 
-   if (!(e_comp_wl->xkb.map_string = xkb_map_get_as_string(keymap)))
+   if ((keymap_current) && (keymap_current->keymap == keymap))
+     e_comp_wl->xkb.map_string = strdup(keymap_current->string);
+   else
+     e_comp_wl->xkb.map_string = xkb_map_get_as_string(keymap);
+   if (!e_comp_wl->xkb.map_string)
      {
         ERR("Could not get keymap string");
         return;
@@ -545,6 +622,10 @@ e_comp_wl_input_shutdown(void)
    if (e_comp_wl->xkb.context)
      xkb_context_unref(e_comp_wl->xkb.context);
 
+   E_FREE_FUNC(keymap_cache, eina_hash_free);
+   if (keymap_context) xkb_context_unref(keymap_context);
+   keymap_context = NULL;
+
    /* destroy the global seat resource */
    if (e_comp_wl->seat.global)
      wl_global_destroy(e_comp_wl->seat.global);
@@ -740,9 +821,9 @@ e_comp_wl_input_keymap_index_set(xkb_layout_index_t index)
 E_API void
 e_comp_wl_input_keymap_set(const char *rules, const char *model, const char *layout, const char *variant, const char *options)
 {
-   struct xkb_keymap *keymap;
-   struct xkb_context *context;
    struct xkb_rule_names names;
+   E_Comp_Wl_Keymap *km;
+   char key[4096];
 
    /* DBG("COMP_WL: Keymap Set: %s %s %s", rules, model, layout); */
 
@@ -764,19 +845,49 @@ e_comp_wl_input_keymap_set(const char *rules, const char *model, const char *lay
    if (options) names.options = options;
    else names.options = NULL;
 
-   /* create a new xkb context */
-   context = xkb_context_new(0);
+   snprintf(key, sizeof(key), "%s\n%s\n%s\n%s\n%s", names.rules,
+            names.model, names.layout, names.variant ?: "",
+            names.options ?: "");
+   km = eina_hash_find(keymap_cache, key);
+   if (!km)
+     {
+        struct xkb_keymap *keymap;
 
-   /* fetch new keymap based on names */
-   keymap = xkb_map_new_from_names(context, &names, 0);
+        /* create the shared xkb context */
+        if (!keymap_context) keymap_context = xkb_context_new(0);
+        if (!keymap_context) return;
 
-   if (!keymap)
-     {
-        ERR("Failed to compile keymap");
-        return;
+        /* fetch new keymap based on names */
+        keymap = xkb_map_new_from_names(keymap_context, &names, 0);
+
+        if (!keymap)
+          {
+             ERR("Failed to compile keymap");
+             return;
+          }
+
+        km = E_NEW(E_Comp_Wl_Keymap, 1);
+        km->keymap = keymap;
+        km->fd = -1;
+        if (!(km->string = xkb_map_get_as_string(keymap)))
+          {
+             ERR("Could not get keymap string");
+             xkb_keymap_unref(keymap);
+             free(km);
+             return;
+          }
+        km->size = strlen(km->string) + 1;
+        if (!keymap_cache)
+          keymap_cache = eina_hash_string_superfast_new
+            (EINA_FREE_CB(_e_comp_wl_input_keymap_cache_free));
+        else if (eina_hash_population(keymap_cache) >= KEYMAP_CACHE_MAX)
+          eina_hash_free_buckets(keymap_cache);
+        eina_hash_add(keymap_cache, key, km);
      }
+   keymap_current = km;
 
-   _e_comp_wl_input_context_keymap_set(keymap, context);
+   _e_comp_wl_input_context_keymap_set(xkb_keymap_ref(km->keymap),
+                                       xkb_context_ref(keymap_context));
 }
 
 E_API void
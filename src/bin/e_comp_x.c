@@ -184,7 +184,12 @@ _e_comp_x_client_frame_update(E_Client *ec, int l, int r, int t, int b)
    _e_comp_x_client_data_get(ec)->frame_update = 0;
 }
 
-static Eina_List *iconshare = NULL;
+/* shared netwm icon store. windows of the same app tend to carry the
+ * same icons, so identical icon sets are kept only once and found by a
+ * hash of their pixels. each distinct size up to ICON_SIZE_MAX is kept,
+ * largest first, so users can pick the best fit with
+ * e_client_netwm_icon_get() */
+#define ICON_SIZE_MAX 256
 
 typedef struct _E_Client_Icon_Entry E_Client_Icon_Entry;
 
@@ -193,50 +198,127 @@ struct _E_Client_Icon_Entry
    Ecore_X_Icon *icons;
    int num_icons;
    int ref;
+   unsigned int hash;
 };
 
+static Eina_Hash *iconshare = NULL;
+static Eina_Hash *iconshare_icons = NULL;
+
+static int
+_e_comp_x_client_icon_key_hash(const void *key, int len EINA_UNUSED)
+{
+   const E_Client_Icon_Entry *ie = key;
+
+   return ie->hash;
+}
+
+static int
+_e_comp_x_client_icon_key_cmp(const void *key1, int len1 EINA_UNUSED, const void *key2, int len2 EINA_UNUSED)
+{
+   const E_Client_Icon_Entry *ie1 = key1, *ie2 = key2;
+   int i;
+
+   if (ie1->num_icons != ie2->num_icons) return 1;
+   for (i = 0; i < ie1->num_icons; i++)
+     {
+        if ((ie1->icons[i].width != ie2->icons[i].width) ||
+            (ie1->icons[i].height != ie2->icons[i].height) ||
+            (memcmp(ie1->icons[i].data, ie2->icons[i].data,
+                    ie1->icons[i].width * ie1->icons[i].height * 4)))
+          return 1;
+     }
+   return 0;
+}
+
+static int
+_e_comp_x_client_icon_sort_cb(const void *d1, const void *d2)
+{
+   const Ecore_X_Icon *ic1 = d1, *ic2 = d2;
+
+   return (int)(ic2->width * ic2->height) - (int)(ic1->width * ic1->height);
+}
+
+static int
+_e_comp_x_client_icon_prune(Ecore_X_Icon *icons, int num_icons)
+{
+   int i, n = 0, last = -1;
+   Eina_Bool fits = EINA_FALSE;
+
+   qsort(icons, num_icons, sizeof(Ecore_X_Icon), _e_comp_x_client_icon_sort_cb);
+   for (i = 0; i < num_icons; i++)
+     {
+        if ((!icons[i].width) || (!icons[i].height)) continue;
+        last = i;
+        if ((icons[i].width <= ICON_SIZE_MAX) &&
+            (icons[i].height <= ICON_SIZE_MAX))
+          fits = EINA_TRUE;
+     }
+   for (i = 0; i < num_icons; i++)
+     {
+        // drop empty and same sized icons, and oversized ones unless
+        // there is nothing else - then keep the smallest of them
+        if ((!icons[i].width) || (!icons[i].height) ||
+            ((n > 0) && (icons[n - 1].width == icons[i].width) &&
+             (icons[n - 1].height == icons[i].height)) ||
+            (((icons[i].width > ICON_SIZE_MAX) ||
+              (icons[i].height > ICON_SIZE_MAX)) &&
+             ((fits) || (i != last))))
+          {
+             free(icons[i].data);
+             continue;
+          }
+        icons[n++] = icons[i];
+     }
+   return n;
+}
+
 static Ecore_X_Icon *
-_e_comp_x_client_icon_deduplicate(Ecore_X_Icon *icons, int num_icons)
+_e_comp_x_client_icon_deduplicate(Ecore_X_Icon *icons, int *num_icons)
 {
+   E_Client_Icon_Entry *ie, tmp;
    int i;
-   Eina_List *l;
-   E_Client_Icon_Entry *ie;
 
-   // unless the rest of e uses border icons OTHER than icon #0
-   // then free the rest that we don't need anymore.
-   for (i = 1; i < num_icons; i++)
+   tmp.num_icons = _e_comp_x_client_icon_prune(icons, *num_icons);
+   if (!tmp.num_icons)
      {
-        E_FREE(icons[i].data);
+        free(icons);
+        *num_icons = 0;
+        return NULL;
+     }
+   tmp.icons = icons;
+   tmp.hash = tmp.num_icons;
+   for (i = 0; i < tmp.num_icons; i++)
+     tmp.hash = (tmp.hash * 31) ^
+       eina_hash_superfast((const char *)icons[i].data,
+                           icons[i].width * icons[i].height * 4);
+   if (!iconshare)
+     {
+        iconshare = eina_hash_new(NULL, _e_comp_x_client_icon_key_cmp,
+                                  _e_comp_x_client_icon_key_hash, NULL, 8);
+        iconshare_icons = eina_hash_pointer_new(NULL);
      }
    // lookup icon data in icons cache/share
-   EINA_LIST_FOREACH(iconshare, l, ie)
-     {
-        if ((ie->num_icons == num_icons) &&
-            (num_icons  > 0) &&
-            (ie->icons[0].width == icons[0].width) &&
-            (ie->icons[0].height == icons[0].height) &&
-            (!memcmp(ie->icons[0].data, icons[0].data,
-                     icons[0].width * icons[0].height * 4)))
-          {
-             // found so free the input icons
-             for (i = 0; i < num_icons; i++)
-               free(icons[i].data);
-             free(icons);
-             // ref the shared/cached one
-             ie->ref++;
-             iconshare = eina_list_promote_list(iconshare, l);
-             // and return that
-             return ie->icons;
-          }
+   ie = eina_hash_find(iconshare, &tmp);
+   if (ie)
+     {
+        // found so free the input icons
+        for (i = 0; i < tmp.num_icons; i++)
+          free(icons[i].data);
+        free(icons);
+        // ref the shared/cached one and return that
+        ie->ref++;
+        *num_icons = ie->num_icons;
+        return ie->icons;
      }
    // no hit - new entry to cache. add it
-   ie = calloc(1, sizeof(E_Client_Icon_Entry));
+   *num_icons = tmp.num_icons;
+   ie = malloc(sizeof(E_Client_Icon_Entry));
    if (ie)
      {
-        ie->icons = icons;
-        ie->num_icons = num_icons;
+        *ie = tmp;
         ie->ref = 1;
-        iconshare = eina_list_prepend(iconshare, ie);
+        eina_hash_direct_add(iconshare, ie, ie);
+        eina_hash_add(iconshare_icons, &ie->icons, ie);
      }
    return icons;
 }
@@ -245,32 +327,21 @@ static void
 _e_comp_x_client_icon_free(Ecore_X_Icon *icons, int num_icons)
 {
    int i;
-   Eina_List *l;
-   E_Client_Icon_Entry *ie;
+   E_Client_Icon_Entry *ie = NULL;
 
+   if (!icons) return;
    // lookup in icon share cache
-   EINA_LIST_FOREACH(iconshare, l, ie)
-     {
-        if ((ie->num_icons == num_icons) &&
-            (num_icons  > 0) &&
-            (ie->icons[0].width == icons[0].width) &&
-            (ie->icons[0].height == icons[0].height) &&
-            (!memcmp(ie->icons[0].data, icons[0].data,
-                     icons[0].width * icons[0].height * 4)))
-          {
-             // found so deref
-             ie->ref--;
-             if (ie->ref <= 0)
-               {
-                  // no refs left - free the icon from the share/cache
-                  iconshare = eina_list_remove_list(iconshare, l);
-                  for (i = 0; i < ie->num_icons; i++)
-                    free(ie->icons[i].data);
-                  free(ie->icons);
-                  free(ie);
-               }
-             return;
-          }
+   if (iconshare_icons) ie = eina_hash_find(iconshare_icons, &icons);
+   if (ie)
+     {
+        // found so deref
+        ie->ref--;
+        if (ie->ref > 0) return;
+        // no refs left - free the icon from the share/cache
+        eina_hash_del_by_key(iconshare_icons, &ie->icons);
+        eina_hash_del(iconshare, ie, ie);
+        num_icons = ie->num_icons;
+        free(ie);
      }
    // not found - so just free it ... odd - we should never be here
    for (i = 0; i < num_icons; i++)
@@ -278,6 +349,67 @@ _e_comp_x_client_icon_free(Ecore_X_Icon *icons, int num_icons)
    free(icons);
 }
 
+static void
+_e_comp_x_client_icons_set(E_Client *ec, Ecore_X_Icon *icons, int num_icons, Eina_Bool have_icons)
+{
+   _e_comp_x_client_icon_free(ec->netwm.icons, ec->netwm.num_icons);
+   ec->netwm.icons = NULL;
+   ec->netwm.num_icons = 0;
+   if (!have_icons) return;
+   if (icons)
+     ec->netwm.icons = _e_comp_x_client_icon_deduplicate(icons, &num_icons);
+   ec->netwm.num_icons = ec->netwm.icons ? num_icons : 0;
+   ec->changes.icon = 1;
+}
+
+static Eina_Bool
+_e_comp_x_client_strut_prefetch_get(E_Client *ec, Ecore_X_Window win)
+{
+   unsigned int strut[12], old[4];
+   int num = -1, old_num = -1;
+
+   // both strut properties are always prefetched together
+   if (!e_comp_x_prefetch_card32_get(win, ECORE_X_ATOM_NET_WM_STRUT_PARTIAL,
+                                     strut, 12, &num))
+     return EINA_FALSE;
+   if (!e_comp_x_prefetch_card32_get(win, ECORE_X_ATOM_NET_WM_STRUT,
+                                     old, 4, &old_num))
+     old_num = ecore_x_window_prop_card32_get(win, ECORE_X_ATOM_NET_WM_STRUT,
+                                              old, 4);
+   if (num == 12)
+     {
+        ec->netwm.strut.left = strut[0];
+        ec->netwm.strut.right = strut[1];
+        ec->netwm.strut.top = strut[2];
+        ec->netwm.strut.bottom = strut[3];
+        ec->netwm.strut.left_start_y = strut[4];
+        ec->netwm.strut.left_end_y = strut[5];
+        ec->netwm.strut.right_start_y = strut[6];
+        ec->netwm.strut.right_end_y = strut[7];
+        ec->netwm.strut.top_start_x = strut[8];
+        ec->netwm.strut.top_end_x = strut[9];
+        ec->netwm.strut.bottom_start_x = strut[10];
+        ec->netwm.strut.bottom_end_x = strut[11];
+        return EINA_TRUE;
+     }
+   if (old_num == 4)
+     {
+        ec->netwm.strut.left = old[0];
+        ec->netwm.strut.right = old[1];
+        ec->netwm.strut.top = old[2];
+        ec->netwm.strut.bottom = old[3];
+     }
+   ec->netwm.strut.left_start_y = 0;
+   ec->netwm.strut.left_end_y = 0;
+   ec->netwm.strut.right_start_y = 0;
+   ec->netwm.strut.right_end_y = 0;
+   ec->netwm.strut.top_start_x = 0;
+   ec->netwm.strut.top_end_x = 0;
+   ec->netwm.strut.bottom_start_x = 0;
+   ec->netwm.strut.bottom_end_x = 0;
+   return EINA_TRUE;
+}
+
 static void
 _e_comp_x_client_event_free(void *d EINA_UNUSED, void *e)
 {
@@ -586,6 +718,8 @@ _e_comp_x_client_new_helper(E_Client *ec)
              ec->e.fetch.video_position = 1;
              fprintf(stderr, "We found a video window \\o/ %x\n", win);
           }
+        // get all the properties the fetch hook wants on their way now
+        e_comp_x_prefetch_request(win, atoms, at_num);
         free(atoms);
 
         if (ec->re_manage && found_desk && found_zone)
@@ -636,6 +770,24 @@ _e_comp_x_client_find_by_window(Ecore_X_Window win)
    return ec;
 }
 
+static void
+_e_comp_x_client_icons_fetched(Ecore_X_Window win, Ecore_X_Icon *icons, int num_icons)
+{
+   E_Client *ec;
+   int i;
+
+   ec = _e_comp_x_client_find_by_window(win);
+   if (!ec)
+     {
+        for (i = 0; i < num_icons; i++)
+          free(icons[i].data);
+        free(icons);
+        return;
+     }
+   _e_comp_x_client_icons_set(ec, icons, num_icons, !!icons);
+   EC_CHANGED(ec);
+}
+
 /*
 static E_Client *
 _e_comp_x_client_find_all_by_window(Ecore_X_Window win)
@@ -1998,6 +2150,7 @@ _e_comp_x_property(void *data EINA_UNUSED, int type EINA_UNUSED, Ecore_X_Event_W
 
    ec = _e_comp_x_client_find_by_window(ev->win);
    if (!ec) return ECORE_CALLBACK_RENEW;
+   e_comp_x_prefetch_request(ev->win, &ev->atom, 1);
 
    if (ev->atom == ECORE_X_ATOM_WM_NAME)
      {
@@ -3506,8 +3659,12 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      {
         /* TODO: What do to if the client leader isn't mapped yet? */
         E_Client *ec_leader = NULL;
+        Ecore_X_Window leader;
 
-        ec->icccm.client_leader = ecore_x_icccm_client_leader_get(win);
+        if (!e_comp_x_prefetch_window_get(win, ECORE_X_ATOM_WM_CLIENT_LEADER,
+                                          &leader))
+          leader = ecore_x_icccm_client_leader_get(win);
+        ec->icccm.client_leader = leader;
         if (ec->icccm.client_leader)
           ec_leader = _e_comp_x_client_find_by_window(ec->icccm.client_leader);
         if (ec->leader)
@@ -3551,7 +3708,11 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      }
    if (ec->icccm.fetch.title)
      {
-        char *title = ecore_x_icccm_title_get(win);
+        char *title;
+
+        if (!e_comp_x_prefetch_text_get(win, ECORE_X_ATOM_WM_NAME,
+                                        EINA_FALSE, &title))
+          title = ecore_x_icccm_title_get(win);
         eina_stringshare_replace(&ec->icccm.title, title);
         free(title);
 
@@ -3563,7 +3724,9 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
    if (ec->netwm.fetch.name)
      {
         char *name;
-        ecore_x_netwm_name_get(win, &name);
+        if (!e_comp_x_prefetch_text_get(win, ECORE_X_ATOM_NET_WM_NAME,
+                                        EINA_TRUE, &name))
+          ecore_x_netwm_name_get(win, &name);
         eina_stringshare_replace(&ec->netwm.name, name);
         free(name);
 
@@ -3582,7 +3745,8 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
         const char *pname, *pclass;
         char *nname, *nclass;
 
-        ecore_x_icccm_name_class_get(win, &nname, &nclass);
+        if (!e_comp_x_prefetch_name_class_get(win, &nname, &nclass))
+          ecore_x_icccm_name_class_get(win, &nname, &nclass);
         pname = ec->icccm.name;
         pclass = ec->icccm.class;
         ec->icccm.name = eina_stringshare_add(nname);
@@ -3744,8 +3908,11 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      }
    if (ec->icccm.fetch.machine)
      {
-        char *machine = ecore_x_icccm_client_machine_get(win);
+        char *machine;
 
+        if (!e_comp_x_prefetch_text_get(win, ECORE_X_ATOM_WM_CLIENT_MACHINE,
+                                        EINA_FALSE, &machine))
+          machine = ecore_x_icccm_client_machine_get(win);
         if ((!machine) && (ec->icccm.client_leader))
           machine = ecore_x_icccm_client_machine_get(ec->icccm.client_leader);
 
@@ -3780,20 +3947,29 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      }
    if (ec->changes.prop || ec->icccm.fetch.hints)
      {
-        Eina_Bool accepts_focus, is_urgent;
+        Eina_Bool accepts_focus, is_urgent, have_hints;
         Ecore_X_Window_State_Hint state = ec->icccm.state;
 
         accepts_focus = EINA_TRUE;
         is_urgent = EINA_FALSE;
         ec->icccm.state = ECORE_X_WINDOW_STATE_HINT_NORMAL;
-        if (ecore_x_icccm_hints_get(win,
-                                    &accepts_focus,
-                                    &ec->icccm.state,
-                                    &ec->icccm.icon_pixmap,
-                                    &ec->icccm.icon_mask,
-                                    (Ecore_X_Window*)&ec->icccm.icon_window,
-                                    (Ecore_X_Window*)&ec->icccm.window_group,
-                                    &is_urgent))
+        if (!e_comp_x_prefetch_hints_get(win,
+                                         &accepts_focus,
+                                         &ec->icccm.state,
+                                         &ec->icccm.icon_pixmap,
+                                         &ec->icccm.icon_mask,
+                                         (Ecore_X_Window*)&ec->icccm.icon_window,
+                                         (Ecore_X_Window*)&ec->icccm.window_group,
+                                         &is_urgent, &have_hints))
+          have_hints = ecore_x_icccm_hints_get(win,
+                                               &accepts_focus,
+                                               &ec->icccm.state,
+                                               &ec->icccm.icon_pixmap,
+                                               &ec->icccm.icon_mask,
+                                               (Ecore_X_Window*)&ec->icccm.icon_window,
+                                               (Ecore_X_Window*)&ec->icccm.window_group,
+                                               &is_urgent);
+        if (have_hints)
           {
              if (ec->new_client)
                {
@@ -4014,7 +4190,8 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
         int i, num;
         Ecore_X_WM_Protocol *proto;
 
-        proto = ecore_x_window_prop_protocol_list_get(win, &num);
+        if (!e_comp_x_prefetch_protocols_get(win, &proto, &num))
+          proto = ecore_x_window_prop_protocol_list_get(win, &num);
         if (proto)
           {
              for (i = 0; i < num; i++)
@@ -4045,8 +4222,12 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      {
         /* TODO: What do to if the transient for isn't mapped yet? */
         E_Client *ec_parent = NULL;
+        Ecore_X_Window parent;
 
-        ec->icccm.transient_for = ecore_x_icccm_transient_for_get(win);
+        if (!e_comp_x_prefetch_window_get(win, ECORE_X_ATOM_WM_TRANSIENT_FOR,
+                                          &parent))
+          parent = ecore_x_icccm_transient_for_get(win);
+        ec->icccm.transient_for = parent;
         if (ec->icccm.transient_for)
           ec_parent = _e_comp_x_client_find_by_window(ec->icccm.transient_for);
 
@@ -4068,7 +4249,11 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      }
    if (ec->icccm.fetch.window_role)
      {
-        char *role = ecore_x_icccm_window_role_get(win);
+        char *role;
+
+        if (!e_comp_x_prefetch_text_get(win, ECORE_X_ATOM_WM_WINDOW_ROLE,
+                                        EINA_FALSE, &role))
+          role = ecore_x_icccm_window_role_get(win);
         eina_stringshare_replace(&ec->icccm.window_role, role);
         free(role);
 
@@ -4077,7 +4262,11 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      }
    if (ec->icccm.fetch.icon_name)
      {
-        char *icon_name = ecore_x_icccm_icon_name_get(win);
+        char *icon_name;
+
+        if (!e_comp_x_prefetch_text_get(win, ECORE_X_ATOM_WM_ICON_NAME,
+                                        EINA_FALSE, &icon_name))
+          icon_name = ecore_x_icccm_icon_name_get(win);
         eina_stringshare_replace(&ec->icccm.icon_name, icon_name);
         free(icon_name);
 
@@ -4091,7 +4280,9 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
    if (ec->netwm.fetch.icon_name)
      {
         char *icon_name;
-        ecore_x_netwm_icon_name_get(win, &icon_name);
+        if (!e_comp_x_prefetch_text_get(win, ECORE_X_ATOM_NET_WM_ICON_NAME,
+                                        EINA_TRUE, &icon_name))
+          ecore_x_netwm_icon_name_get(win, &icon_name);
         eina_stringshare_replace(&ec->netwm.icon_name, icon_name);
         free(icon_name);
 
@@ -4118,40 +4309,48 @@ _e_comp_x_hook_client_fetch(void *d EINA_UNUSED, E_Client *ec)
      }
    if (ec->netwm.fetch.icon)
      {
-        _e_comp_x_client_icon_free(ec->netwm.icons, ec->netwm.num_icons);
-        ec->netwm.icons = NULL;
-        ec->netwm.num_icons = 0;
-        if (ecore_x_netwm_icons_get(win,
-                                    &ec->netwm.icons,
-                                    &ec->netwm.num_icons))
+        // the old icons stay until the new ones have been read
+        if (!e_comp_x_prefetch_icons_request(win, _e_comp_x_client_icons_fetched))
           {
-             if (ec->netwm.icons)
-               ec->netwm.icons = _e_comp_x_client_icon_deduplicate
-                 (ec->netwm.icons, ec->netwm.num_icons);
-             ec->changes.icon = 1;
+             Ecore_X_Icon *icons = NULL;
+             int num_icons = 0;
+             Eina_Bool have_icons;
+
+             have_icons = ecore_x_netwm_icons_get(win, &icons, &num_icons);
+             _e_comp_x_client_icons_set(ec, icons, num_icons, have_icons);
           }
         ec->netwm.fetch.icon = 0;
      }
    if (ec->netwm.fetch.user_time)
      {
-        ecore_x_netwm_user_time_get(win, &ec->netwm.user_time);
+        unsigned int user_time;
+        int num;
+
+        if (e_comp_x_prefetch_card32_get(win, ECORE_X_ATOM_NET_WM_USER_TIME,
+                                         &user_time, 1, &num))
+          {
+             if (num > 0) ec->netwm.user_time = user_time;
+          }
+        else
+          ecore_x_netwm_user_time_get(win, &ec->netwm.user_time);
         ec->netwm.fetch.user_time = 0;
      }
    if (ec->netwm.fetch.strut)
      {
-        if (!ecore_x_netwm_strut_partial_get(win,
-                                             &ec->netwm.strut.left,
-                                             &ec->netwm.strut.right,
-                                             &ec->netwm.strut.top,
-                                             &ec->netwm.strut.bottom,
-                                             &ec->netwm.strut.left_start_y,
-                                             &ec->netwm.strut.left_end_y,
-                                             &ec->netwm.strut.right_start_y,
-                                             &ec->netwm.strut.right_end_y,
-                                             &ec->netwm.strut.top_start_x,
-                                             &ec->netwm.strut.top_end_x,
-                                             &ec->netwm.strut.bottom_start_x,
-                                             &ec->netwm.strut.bottom_end_x))
+        if ((!_e_comp_x_client_strut_prefetch_get(ec, win)) &&
+            (!ecore_x_netwm_strut_partial_get(win,
+                                              &ec->netwm.strut.left,
+                                              &ec->netwm.strut.right,
+                                              &ec->netwm.strut.top,
+                                              &ec->netwm.strut.bottom,
+                                              &ec->netwm.strut.left_start_y,
+                                              &ec->netwm.strut.left_end_y,
+                                              &ec->netwm.strut.right_start_y,
+                                              &ec->netwm.strut.right_end_y,
+                                              &ec->netwm.strut.top_start_x,
+                                              &ec->netwm.strut.top_end_x,
+                                              &ec->netwm.strut.bottom_start_x,
+                                              &ec->netwm.strut.bottom_end_x)))
           {
              ecore_x_netwm_strut_get(win,
                                      &ec->netwm.strut.left, &ec->netwm.strut.right,
@@ -4983,6 +5182,7 @@ _e_comp_x_hook_client_del(void *d EINA_UNUSED, E_Client *ec)
    pwin = e_client_util_pwin_get(ec);
    cd = _e_comp_x_client_data_get(ec);
 
+   e_comp_x_prefetch_window_del(win);
    if (mouse_client == ec) mouse_client = NULL;
    if (focus_job_client == ec) focus_job_client = NULL;
    if (unfocus_job_client == ec) unfocus_job_client = NULL;
@@ -5892,6 +6092,7 @@ e_comp_x_init(void)
         return EINA_FALSE;
      }
    if (!e_atoms_init()) return 0;
+   e_comp_x_prefetch_init();
 
    clients_win_hash = eina_hash_int32_new(NULL);
    damages_hash = eina_hash_int32_new(NULL);
@@ -6038,6 +6239,7 @@ e_comp_x_shutdown(void)
    E_FREE_FUNC(pending_configures, eina_hash_free);
    E_FREE_FUNC(frame_extents, eina_hash_free);
    E_FREE_FUNC(mouse_in_fix_check_timer, ecore_timer_del);
+   e_comp_x_prefetch_shutdown();
    e_xsettings_shutdown();
    if (x_fatal) return;
    if (e_comp->comp_type == E_PIXMAP_TYPE_X)
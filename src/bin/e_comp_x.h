@@ -122,5 +122,19 @@ E_API E_Pixmap *e_comp_x_client_pixmap_get(const E_Client *ec);
 EINTERN Eina_Bool _e_comp_x_screensaver_on();
 EINTERN Eina_Bool _e_comp_x_screensaver_off();
 
+typedef void (*E_Comp_X_Prefetch_Icons_Cb)(Ecore_X_Window win, Ecore_X_Icon *icons, int num_icons);
+
+EINTERN void e_comp_x_prefetch_init(void);
+EINTERN void e_comp_x_prefetch_shutdown(void);
+EINTERN void e_comp_x_prefetch_request(Ecore_X_Window win, const Ecore_X_Atom *atoms, int num);
+EINTERN void e_comp_x_prefetch_window_del(Ecore_X_Window win);
+EINTERN Eina_Bool e_comp_x_prefetch_text_get(Ecore_X_Window win, Ecore_X_Atom atom, Eina_Bool utf8_only, char **text);
+EINTERN Eina_Bool e_comp_x_prefetch_name_class_get(Ecore_X_Window win, char **name, char **clas);
+EINTERN Eina_Bool e_comp_x_prefetch_window_get(Ecore_X_Window win, Ecore_X_Atom atom, Ecore_X_Window *ret);
+EINTERN Eina_Bool e_comp_x_prefetch_card32_get(Ecore_X_Window win, Ecore_X_Atom atom, unsigned int *val, unsigned int len, int *ret);
+EINTERN Eina_Bool e_comp_x_prefetch_hints_get(Ecore_X_Window win, Eina_Bool *accepts_focus, Ecore_X_Window_State_Hint *initial_state, Ecore_X_Pixmap *icon_pixmap, Ecore_X_Pixmap *icon_mask, Ecore_X_Window *icon_window, Ecore_X_Window *window_group, Eina_Bool *is_urgent, Eina_Bool *ret);
+EINTERN Eina_Bool e_comp_x_prefetch_protocols_get(Ecore_X_Window win, Ecore_X_WM_Protocol **protos, int *num);
+EINTERN Eina_Bool e_comp_x_prefetch_icons_request(Ecore_X_Window win, E_Comp_X_Prefetch_Icons_Cb cb);
+
 # endif
 #endif
@@ -0,0 +1,727 @@
+#include "e.h"
+#ifdef HAVE_X11_XCB
+# include <X11/Xlib-xcb.h>
+# include <X11/Xatom.h>
+# include <X11/Xutil.h>
+#endif
+
+/* pipelined property prefetch for x clients
+ *
+ * the client fetch hook reads a pile of properties per window and every
+ * ecore_x_*_get() is a full round trip to the server. so instead every
+ * GetProperty for a window is sent out in one go when the window is
+ * managed or a property changes, and the fetch hook collects the replies
+ * later on. anything without a prefetched reply (or in an encoding only
+ * xlib can convert like compound text) falls back to plain ecore_x calls.
+ *
+ * all the getters return EINA_TRUE if they answered from a prefetched
+ * reply - with the same results the matching ecore_x call would give.
+ *
+ * _NET_WM_ICON is different - it can be megabytes and some clients change
+ * it all the time. it is read in chunks in the background and handed to a
+ * callback once complete, so the main loop never waits for it */
+
+#ifdef HAVE_X11_XCB
+
+# define PREFETCH_ATOMS 14
+// _NET_WM_ICON is read in chunks of this many CARDINALs
+# define ICON_CHUNK 16384
+
+typedef struct _E_Comp_X_Prefetch
+{
+   Ecore_X_Window win;
+   unsigned int   num;
+   struct
+   {
+      Ecore_X_Atom              atom;
+      xcb_get_property_cookie_t cookie;
+   } req[PREFETCH_ATOMS];
+} E_Comp_X_Prefetch;
+
+typedef struct _E_Comp_X_Icon_Fetch
+{
+   Ecore_X_Window             win;
+   E_Comp_X_Prefetch_Icons_Cb cb;
+   unsigned int               seq;
+   uint32_t                  *data;
+   unsigned int               num, size;
+   xcb_get_property_reply_t  *reply; // picked up but not handled yet
+   xcb_generic_error_t       *err;
+   Eina_Bool                  waiting E_BITFIELD;
+   Eina_Bool                  ready E_BITFIELD;
+   Eina_Bool                  again E_BITFIELD;
+} E_Comp_X_Icon_Fetch;
+
+static xcb_connection_t *_conn = NULL;
+static Eina_Hash *_prefetches = NULL;
+static Eina_Hash *_icon_fetches = NULL;
+static Ecore_Fd_Handler *_icon_fetch_handler = NULL;
+static int _icon_fetch_fd = -1;
+static Ecore_X_Atom _atoms[PREFETCH_ATOMS];
+
+static void _e_comp_x_icon_fetch_free(void *data);
+
+static void
+_e_comp_x_prefetch_free(void *data)
+{
+   E_Comp_X_Prefetch *pf = data;
+   unsigned int i;
+
+   for (i = 0; i < pf->num; i++)
+     xcb_discard_reply(_conn, pf->req[i].cookie.sequence);
+   free(pf);
+}
+
+static Eina_Bool
+_e_comp_x_prefetch_atom_wanted(Ecore_X_Atom atom)
+{
+   unsigned int i;
+
+   for (i = 0; i < PREFETCH_ATOMS; i++)
+     if (_atoms[i] == atom) return EINA_TRUE;
+   return EINA_FALSE;
+}
+
+static void
+_e_comp_x_prefetch_send(E_Comp_X_Prefetch **pf, Ecore_X_Window win, Ecore_X_Atom atom)
+{
+   xcb_get_property_cookie_t cookie;
+   unsigned int i;
+
+   if (!*pf)
+     {
+        *pf = E_NEW(E_Comp_X_Prefetch, 1);
+        if (!*pf) return;
+        (*pf)->win = win;
+        eina_hash_add(_prefetches, &win, *pf);
+     }
+   cookie = xcb_get_property(_conn, 0, win, atom, XCB_GET_PROPERTY_TYPE_ANY,
+                             0, 0x7fffffff);
+   // a newer request for the same property replaces the older one
+   for (i = 0; i < (*pf)->num; i++)
+     {
+        if ((*pf)->req[i].atom != atom) continue;
+        xcb_discard_reply(_conn, (*pf)->req[i].cookie.sequence);
+        (*pf)->req[i].cookie = cookie;
+        return;
+     }
+   (*pf)->req[(*pf)->num].atom = atom;
+   (*pf)->req[(*pf)->num].cookie = cookie;
+   (*pf)->num++;
+}
+
+static xcb_get_property_reply_t *
+_e_comp_x_prefetch_take(Ecore_X_Window win, Ecore_X_Atom atom, Eina_Bool *found)
+{
+   E_Comp_X_Prefetch *pf;
+   xcb_get_property_cookie_t cookie;
+   xcb_get_property_reply_t *reply;
+   xcb_generic_error_t *err = NULL;
+   unsigned int i;
+
+   *found = EINA_FALSE;
+   if (!_prefetches) return NULL;
+   pf = eina_hash_find(_prefetches, &win);
+   if (!pf) return NULL;
+   for (i = 0; i < pf->num; i++)
+     {
+        if (pf->req[i].atom != atom) continue;
+        cookie = pf->req[i].cookie;
+        pf->req[i] = pf->req[--pf->num];
+        if (!pf->num) eina_hash_del_by_key(_prefetches, &win);
+        // usually already here - at worst this waits for the one round
+        // trip that all the requests of this window share
+        reply = xcb_get_property_reply(_conn, cookie, &err);
+        if (err)
+          {
+             // eg. BadWindow - same as ecore_x finding nothing
+             free(err);
+             free(reply);
+             reply = NULL;
+          }
+        *found = EINA_TRUE;
+        return reply;
+     }
+   return NULL;
+}
+
+EINTERN void
+e_comp_x_prefetch_init(void)
+{
+   unsigned int i = 0;
+
+   if (getenv("E_NO_X_PREFETCH")) return;
+   _conn = XGetXCBConnection((Display *)ecore_x_display_get());
+   if (!_conn) return;
+   _atoms[i++] = ECORE_X_ATOM_WM_NAME;
+   _atoms[i++] = ECORE_X_ATOM_NET_WM_NAME;
+   _atoms[i++] = ECORE_X_ATOM_WM_CLASS;
+   _atoms[i++] = ECORE_X_ATOM_WM_ICON_NAME;
+   _atoms[i++] = ECORE_X_ATOM_NET_WM_ICON_NAME;
+   _atoms[i++] = ECORE_X_ATOM_WM_CLIENT_MACHINE;
+   _atoms[i++] = ECORE_X_ATOM_WM_WINDOW_ROLE;
+   _atoms[i++] = ECORE_X_ATOM_WM_TRANSIENT_FOR;
+   _atoms[i++] = ECORE_X_ATOM_WM_CLIENT_LEADER;
+   _atoms[i++] = ECORE_X_ATOM_WM_HINTS;
+   _atoms[i++] = ECORE_X_ATOM_WM_PROTOCOLS;
+   _atoms[i++] = ECORE_X_ATOM_NET_WM_USER_TIME;
+   _atoms[i++] = ECORE_X_ATOM_NET_WM_STRUT;
+   _atoms[i++] = ECORE_X_ATOM_NET_WM_STRUT_PARTIAL;
+   _prefetches = eina_hash_int32_new(_e_comp_x_prefetch_free);
+   _icon_fetches = eina_hash_int32_new(_e_comp_x_icon_fetch_free);
+}
+
+EINTERN void
+e_comp_x_prefetch_shutdown(void)
+{
+   E_FREE_FUNC(_prefetches, eina_hash_free);
+   E_FREE_FUNC(_icon_fetches, eina_hash_free);
+   E_FREE_FUNC(_icon_fetch_handler, ecore_main_fd_handler_del);
+   if (_icon_fetch_fd >= 0) close(_icon_fetch_fd);
+   _icon_fetch_fd = -1;
+   _conn = NULL;
+}
+
+EINTERN void
+e_comp_x_prefetch_request(Ecore_X_Window win, const Ecore_X_Atom *atoms, int num)
+{
+   E_Comp_X_Prefetch *pf;
+   Eina_Bool sent = EINA_FALSE;
+   int i;
+
+   if (!_prefetches) return;
+   pf = eina_hash_find(_prefetches, &win);
+   for (i = 0; i < num; i++)
+     {
+        if (!_e_comp_x_prefetch_atom_wanted(atoms[i])) continue;
+        // anything xlib still has buffered goes out before our requests
+        if (!sent) ecore_x_flush();
+        sent = EINA_TRUE;
+        // the strut fetch always reads both the partial and the old strut
+        if ((atoms[i] == ECORE_X_ATOM_NET_WM_STRUT) ||
+            (atoms[i] == ECORE_X_ATOM_NET_WM_STRUT_PARTIAL))
+          {
+             _e_comp_x_prefetch_send(&pf, win, ECORE_X_ATOM_NET_WM_STRUT_PARTIAL);
+             _e_comp_x_prefetch_send(&pf, win, ECORE_X_ATOM_NET_WM_STRUT);
+          }
+        else
+          _e_comp_x_prefetch_send(&pf, win, atoms[i]);
+     }
+   if (sent) xcb_flush(_conn);
+}
+
+EINTERN void
+e_comp_x_prefetch_window_del(Ecore_X_Window win)
+{
+   if (!_prefetches) return;
+   eina_hash_del_by_key(_prefetches, &win);
+   eina_hash_del_by_key(_icon_fetches, &win);
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_text_get(Ecore_X_Window win, Ecore_X_Atom atom, Eina_Bool utf8_only, char **text)
+{
+   xcb_get_property_reply_t *reply;
+   Eina_Bool found;
+   unsigned char *s;
+   char *d;
+   int i, len;
+
+   reply = _e_comp_x_prefetch_take(win, atom, &found);
+   if (!found) return EINA_FALSE;
+   *text = NULL;
+   if ((!reply) || (reply->format != 8) ||
+       ((len = xcb_get_property_value_length(reply)) <= 0))
+     goto done;
+   s = xcb_get_property_value(reply);
+   if (reply->type == ECORE_X_ATOM_UTF8_STRING)
+     *text = eina_strndup((char *)s, len);
+   else if (utf8_only)
+     goto done;
+   else if (reply->type == XA_STRING)
+     {
+        // latin-1 to utf8 - what xlib would do for a STRING property
+        *text = d = malloc((len * 2) + 1);
+        if (!d) goto done;
+        for (i = 0; (i < len) && (s[i]); i++)
+          {
+             if (s[i] < 0x80) *d++ = s[i];
+             else
+               {
+                  *d++ = 0xc0 | (s[i] >> 6);
+                  *d++ = 0x80 | (s[i] & 0x3f);
+               }
+          }
+        *d = 0;
+     }
+   else
+     {
+        // compound text and friends need xlib's locale converters
+        free(reply);
+        return EINA_FALSE;
+     }
+done:
+   free(reply);
+   return EINA_TRUE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_name_class_get(Ecore_X_Window win, char **name, char **clas)
+{
+   xcb_get_property_reply_t *reply;
+   Eina_Bool found;
+   const char *s;
+   int len, n;
+
+   reply = _e_comp_x_prefetch_take(win, ECORE_X_ATOM_WM_CLASS, &found);
+   if (!found) return EINA_FALSE;
+   *name = *clas = NULL;
+   if ((reply) && (reply->type == XA_STRING) && (reply->format == 8))
+     {
+        // "name\0class\0" - a missing class is an empty one like in xlib
+        s = xcb_get_property_value(reply);
+        len = xcb_get_property_value_length(reply);
+        n = strnlen(s, len);
+        *name = eina_strndup(s, n);
+        if ((n + 1) < len)
+          *clas = eina_strndup(s + n + 1, strnlen(s + n + 1, len - n - 1));
+        else
+          *clas = strdup("");
+     }
+   free(reply);
+   return EINA_TRUE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_window_get(Ecore_X_Window win, Ecore_X_Atom atom, Ecore_X_Window *ret)
+{
+   xcb_get_property_reply_t *reply;
+   Eina_Bool found;
+
+   reply = _e_comp_x_prefetch_take(win, atom, &found);
+   if (!found) return EINA_FALSE;
+   *ret = 0;
+   if ((reply) && (reply->type == XA_WINDOW) && (reply->format == 32) &&
+       (reply->value_len >= 1))
+     *ret = ((uint32_t *)xcb_get_property_value(reply))[0];
+   free(reply);
+   return EINA_TRUE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_card32_get(Ecore_X_Window win, Ecore_X_Atom atom, unsigned int *val, unsigned int len, int *ret)
+{
+   xcb_get_property_reply_t *reply;
+   Eina_Bool found;
+   uint32_t *data;
+   unsigned int i, num;
+
+   reply = _e_comp_x_prefetch_take(win, atom, &found);
+   if (!found) return EINA_FALSE;
+   // same as ecore_x_window_prop_card32_get(): -1 if not there at all
+   *ret = -1;
+   if ((reply) && (reply->type == XA_CARDINAL) && (reply->format == 32))
+     {
+        // value_len counts format sized items - not bytes
+        num = reply->value_len;
+        data = xcb_get_property_value(reply);
+        if (num > len) num = len;
+        for (i = 0; i < num; i++) val[i] = data[i];
+        *ret = num;
+     }
+   free(reply);
+   return EINA_TRUE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_hints_get(Ecore_X_Window win,
+                            Eina_Bool *accepts_focus,
+                            Ecore_X_Window_State_Hint *initial_state,
+                            Ecore_X_Pixmap *icon_pixmap,
+                            Ecore_X_Pixmap *icon_mask,
+                            Ecore_X_Window *icon_window,
+                            Ecore_X_Window *window_group,
+                            Eina_Bool *is_urgent,
+                            Eina_Bool *ret)
+{
+   xcb_get_property_reply_t *reply;
+   Eina_Bool found;
+   uint32_t *h;
+   unsigned int num;
+
+   reply = _e_comp_x_prefetch_take(win, ECORE_X_ATOM_WM_HINTS, &found);
+   if (!found) return EINA_FALSE;
+   *accepts_focus = EINA_TRUE;
+   *initial_state = ECORE_X_WINDOW_STATE_HINT_NORMAL;
+   *icon_pixmap = *icon_mask = 0;
+   *icon_window = *window_group = 0;
+   *is_urgent = EINA_FALSE;
+   *ret = EINA_FALSE;
+   // flags, input, initial_state, icon_pixmap, icon_window, icon_x, icon_y,
+   // icon_mask, window_group - old clients may leave off the window_group
+   if ((!reply) || (reply->type != XA_WM_HINTS) || (reply->format != 32) ||
+       ((num = reply->value_len) < 8))
+     goto done;
+   h = xcb_get_property_value(reply);
+   if (h[0] & InputHint) *accepts_focus = !!h[1];
+   if (h[0] & StateHint)
+     {
+        if (h[2] == WithdrawnState)
+          *initial_state = ECORE_X_WINDOW_STATE_HINT_WITHDRAWN;
+        else if (h[2] == NormalState)
+          *initial_state = ECORE_X_WINDOW_STATE_HINT_NORMAL;
+        else if (h[2] == IconicState)
+          *initial_state = ECORE_X_WINDOW_STATE_HINT_ICONIC;
+     }
+   if (h[0] & IconPixmapHint) *icon_pixmap = h[3];
+   if (h[0] & IconWindowHint) *icon_window = h[4];
+   if (h[0] & IconMaskHint) *icon_mask = h[7];
+   if ((h[0] & WindowGroupHint) && (num > 8)) *window_group = h[8];
+   if (h[0] & XUrgencyHint) *is_urgent = EINA_TRUE;
+   *ret = EINA_TRUE;
+done:
+   free(reply);
+   return EINA_TRUE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_protocols_get(Ecore_X_Window win, Ecore_X_WM_Protocol **protos, int *num)
+{
+   xcb_get_property_reply_t *reply;
+   Eina_Bool found;
+   Ecore_X_Atom *atoms;
+   int i, n;
+
+   reply = _e_comp_x_prefetch_take(win, ECORE_X_ATOM_WM_PROTOCOLS, &found);
+   if (!found) return EINA_FALSE;
+   *protos = NULL;
+   *num = 0;
+   if ((!reply) || (reply->type != XA_ATOM) || (reply->format != 32) ||
+       ((n = reply->value_len) <= 0))
+     goto done;
+   *protos = malloc(n * sizeof(Ecore_X_WM_Protocol));
+   if (!*protos) goto done;
+   atoms = xcb_get_property_value(reply);
+   for (i = 0; i < n; i++)
+     {
+        if (atoms[i] == ECORE_X_ATOM_WM_DELETE_WINDOW)
+          (*protos)[i] = ECORE_X_WM_PROTOCOL_DELETE_REQUEST;
+        else if (atoms[i] == ECORE_X_ATOM_WM_TAKE_FOCUS)
+          (*protos)[i] = ECORE_X_WM_PROTOCOL_TAKE_FOCUS;
+        else if (atoms[i] == ECORE_X_ATOM_NET_WM_PING)
+          (*protos)[i] = ECORE_X_NET_WM_PROTOCOL_PING;
+        else if (atoms[i] == ECORE_X_ATOM_NET_WM_SYNC_REQUEST)
+          (*protos)[i] = ECORE_X_NET_WM_PROTOCOL_SYNC_REQUEST;
+        else
+          (*protos)[i] = (Ecore_X_WM_Protocol)-1;
+     }
+   *num = n;
+done:
+   free(reply);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_e_comp_x_prefetch_icons_parse(const uint32_t *data, int n, Ecore_X_Icon **icons, int *num)
+{
+   const uint32_t *p, *ps, *pe;
+   unsigned int *pd;
+   unsigned int len, a, r, g, b;
+   int i, count = 0;
+
+   *icons = NULL;
+   *num = 0;
+   if (n < 2) return EINA_FALSE;
+   // w, h, w * h argb pixels, w, h, ... - the whole list has to be sane
+   for (p = data; p < (data + n); count++)
+     {
+        if ((p + 2) > (data + n)) return EINA_FALSE;
+        len = p[0] * p[1];
+        if ((p[0] && ((len / p[0]) != p[1])) ||
+            (len > (unsigned int)((data + n) - (p + 2))))
+          return EINA_FALSE;
+        p += len + 2;
+     }
+   *icons = malloc(count * sizeof(Ecore_X_Icon));
+   if (!*icons) return EINA_FALSE;
+   for (p = data, i = 0; i < count; i++)
+     {
+        len = p[0] * p[1];
+        (*icons)[i].width = p[0];
+        (*icons)[i].height = p[1];
+        (*icons)[i].data = pd = malloc((len ? len : 1) * sizeof(unsigned int));
+        if (!pd)
+          {
+             while (i) free((*icons)[--i].data);
+             E_FREE(*icons);
+             return EINA_FALSE;
+          }
+        // premultiply like ecore_x_netwm_icons_get() does
+        for (ps = p + 2, pe = ps + len; ps < pe; ps++, pd++)
+          {
+             a = (*ps >> 24) & 0xff;
+             r = (((*ps >> 16) & 0xff) * a) / 255;
+             g = (((*ps >> 8) & 0xff) * a) / 255;
+             b = (((*ps) & 0xff) * a) / 255;
+             *pd = (a << 24) | (r << 16) | (g << 8) | b;
+          }
+        p += len + 2;
+     }
+   *num = count;
+   return EINA_TRUE;
+}
+
+static void
+_e_comp_x_icon_fetch_free(void *data)
+{
+   E_Comp_X_Icon_Fetch *fe = data;
+
+   if (fe->waiting) xcb_discard_reply(_conn, fe->seq);
+   free(fe->reply);
+   free(fe->err);
+   free(fe->data);
+   free(fe);
+}
+
+static void
+_e_comp_x_icon_fetch_send(E_Comp_X_Icon_Fetch *fe)
+{
+   xcb_get_property_cookie_t cookie;
+
+   cookie = xcb_get_property(_conn, 0, fe->win, ECORE_X_ATOM_NET_WM_ICON,
+                             XA_CARDINAL, fe->num, ICON_CHUNK);
+   fe->seq = cookie.sequence;
+   fe->waiting = EINA_TRUE;
+}
+
+static Eina_Bool
+_e_comp_x_icon_fetch_check(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata)
+{
+   E_Comp_X_Icon_Fetch *fe = data;
+   Eina_Bool *ready = fdata;
+
+   // xlib may have read our reply off the socket along with its events so
+   // the queue in xcb is checked, not just the fd
+   if ((fe->waiting) &&
+       (xcb_poll_for_reply(_conn, fe->seq, (void **)&fe->reply, &fe->err)))
+     {
+        fe->waiting = EINA_FALSE;
+        fe->ready = EINA_TRUE;
+     }
+   if (fe->ready) *ready = EINA_TRUE;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_e_comp_x_icon_fetch_poll(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED, void *data, void *fdata)
+{
+   E_Comp_X_Icon_Fetch *fe = data;
+   Eina_List **done = fdata;
+   xcb_get_property_reply_t *reply = fe->reply;
+   xcb_generic_error_t *err = fe->err;
+   unsigned int n, total;
+   uint32_t *tmp;
+
+   if (!fe->ready) return EINA_TRUE;
+   fe->ready = EINA_FALSE;
+   fe->reply = NULL;
+   fe->err = NULL;
+   if (fe->again)
+     {
+        // changed while we were reading it - start over from the top
+        fe->again = EINA_FALSE;
+        fe->num = 0;
+        _e_comp_x_icon_fetch_send(fe);
+        goto end;
+     }
+   if ((err) || (!reply) || (reply->type != XA_CARDINAL) ||
+       (reply->format != 32))
+     {
+        fe->num = 0;
+        *done = eina_list_append(*done, fe);
+        goto end;
+     }
+   n = reply->value_len; // CARDINALs, not bytes
+   // the first reply tells us how much is left so size the buffer once
+   total = fe->num + n + (reply->bytes_after / 4);
+   if (total > fe->size)
+     {
+        tmp = realloc(fe->data, total * sizeof(uint32_t));
+        if (!tmp)
+          {
+             fe->num = 0;
+             *done = eina_list_append(*done, fe);
+             goto end;
+          }
+        fe->data = tmp;
+        fe->size = total;
+     }
+   memcpy(fe->data + fe->num, xcb_get_property_value(reply),
+          n * sizeof(uint32_t));
+   fe->num += n;
+   if ((n > 0) && (reply->bytes_after > 0))
+     _e_comp_x_icon_fetch_send(fe);
+   else
+     *done = eina_list_append(*done, fe);
+end:
+   free(err);
+   free(reply);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_e_comp_x_icon_fetch_buf_cb(void *data EINA_UNUSED, Ecore_Fd_Handler *fdh EINA_UNUSED)
+{
+   Eina_Bool ready = EINA_FALSE;
+
+   eina_hash_foreach(_icon_fetches, _e_comp_x_icon_fetch_check, &ready);
+   return ready;
+}
+
+static Eina_Bool
+_e_comp_x_icon_fetch_fd_cb(void *data EINA_UNUSED, Ecore_Fd_Handler *fdh EINA_UNUSED)
+{
+   E_Comp_X_Icon_Fetch *fe;
+   E_Comp_X_Prefetch_Icons_Cb cb;
+   Ecore_X_Window win;
+   Ecore_X_Icon *icons;
+   Eina_List *done = NULL;
+   Eina_Bool ready = EINA_FALSE;
+   int num;
+
+   eina_hash_foreach(_icon_fetches, _e_comp_x_icon_fetch_check, &ready);
+   eina_hash_foreach(_icon_fetches, _e_comp_x_icon_fetch_poll, &done);
+   xcb_flush(_conn);
+   EINA_LIST_FREE(done, fe)
+     {
+        _e_comp_x_prefetch_icons_parse(fe->data, fe->num, &icons, &num);
+        cb = fe->cb;
+        win = fe->win;
+        eina_hash_del_by_key(_icon_fetches, &win);
+        cb(win, icons, num);
+     }
+   if (eina_hash_population(_icon_fetches) > 0) return ECORE_CALLBACK_RENEW;
+   _icon_fetch_handler = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_icons_request(Ecore_X_Window win, E_Comp_X_Prefetch_Icons_Cb cb)
+{
+   E_Comp_X_Icon_Fetch *fe;
+
+   if (!_icon_fetches) return EINA_FALSE;
+   fe = eina_hash_find(_icon_fetches, &win);
+   if (fe)
+     {
+        // chatty clients update their icons over and over - let the fetch
+        // in flight finish and then read it again once
+        fe->again = EINA_TRUE;
+        fe->cb = cb;
+        return EINA_TRUE;
+     }
+   fe = E_NEW(E_Comp_X_Icon_Fetch, 1);
+   if (!fe) return EINA_FALSE;
+   fe->win = win;
+   fe->cb = cb;
+   ecore_x_flush();
+   _e_comp_x_icon_fetch_send(fe);
+   xcb_flush(_conn);
+   eina_hash_add(_icon_fetches, &win, fe);
+   if (!_icon_fetch_handler)
+     {
+        // ecore_x already watches the connection fd and the main loop
+        // won't take the same fd twice - a dup of it will do
+        if (_icon_fetch_fd < 0)
+          {
+             _icon_fetch_fd = dup(xcb_get_file_descriptor(_conn));
+             if (_icon_fetch_fd >= 0)
+               eina_file_close_on_exec(_icon_fetch_fd, EINA_TRUE);
+          }
+        if (_icon_fetch_fd >= 0)
+          _icon_fetch_handler =
+            ecore_main_fd_handler_add(_icon_fetch_fd, ECORE_FD_READ,
+                                      _e_comp_x_icon_fetch_fd_cb, NULL,
+                                      _e_comp_x_icon_fetch_buf_cb, NULL);
+        if (!_icon_fetch_handler)
+          {
+             eina_hash_del_by_key(_icon_fetches, &win);
+             return EINA_FALSE;
+          }
+     }
+   return EINA_TRUE;
+}
+
+#else
+
+EINTERN void
+e_comp_x_prefetch_init(void)
+{
+}
+
+EINTERN void
+e_comp_x_prefetch_shutdown(void)
+{
+}
+
+EINTERN void
+e_comp_x_prefetch_request(Ecore_X_Window win EINA_UNUSED, const Ecore_X_Atom *atoms EINA_UNUSED, int num EINA_UNUSED)
+{
+}
+
+EINTERN void
+e_comp_x_prefetch_window_del(Ecore_X_Window win EINA_UNUSED)
+{
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_text_get(Ecore_X_Window win EINA_UNUSED, Ecore_X_Atom atom EINA_UNUSED, Eina_Bool utf8_only EINA_UNUSED, char **text EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_name_class_get(Ecore_X_Window win EINA_UNUSED, char **name EINA_UNUSED, char **clas EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_window_get(Ecore_X_Window win EINA_UNUSED, Ecore_X_Atom atom EINA_UNUSED, Ecore_X_Window *ret EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_card32_get(Ecore_X_Window win EINA_UNUSED, Ecore_X_Atom atom EINA_UNUSED, unsigned int *val EINA_UNUSED, unsigned int len EINA_UNUSED, int *ret EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_hints_get(Ecore_X_Window win EINA_UNUSED,
+                            Eina_Bool *accepts_focus EINA_UNUSED,
+                            Ecore_X_Window_State_Hint *initial_state EINA_UNUSED,
+                            Ecore_X_Pixmap *icon_pixmap EINA_UNUSED,
+                            Ecore_X_Pixmap *icon_mask EINA_UNUSED,
+                            Ecore_X_Window *icon_window EINA_UNUSED,
+                            Ecore_X_Window *window_group EINA_UNUSED,
+                            Eina_Bool *is_urgent EINA_UNUSED,
+                            Eina_Bool *ret EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_protocols_get(Ecore_X_Window win EINA_UNUSED, Ecore_X_WM_Protocol **protos EINA_UNUSED, int *num EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+EINTERN Eina_Bool
+e_comp_x_prefetch_icons_request(Ecore_X_Window win EINA_UNUSED, E_Comp_X_Prefetch_Icons_Cb cb EINA_UNUSED)
+{
+   return EINA_FALSE;
+}
+
+#endif
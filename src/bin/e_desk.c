@@ -137,11 +137,41 @@ e_desk_client_top_visible_get(const E_Desk *desk)
    E_OBJECT_CHECK_RETURN(desk, NULL);
    E_OBJECT_TYPE_CHECK_RETURN(desk, E_DESK_TYPE, NULL);
 
+   /* walk down from the top of the stack - the answer is usually close to
+    * it, and the per desk lists carry no stacking order to use instead */
    E_CLIENT_REVERSE_FOREACH(ec)
      if (e_client_util_desk_visible(ec, desk) && evas_object_visible_get(ec->frame)) return ec;
    return NULL;
 }
 
+EINTERN void
+e_desk_client_add(E_Desk *desk, E_Client *ec)
+{
+   desk->clients = eina_list_append(desk->clients, ec);
+}
+
+EINTERN void
+e_desk_client_del(E_Desk *desk, E_Client *ec)
+{
+   desk->clients = eina_list_remove(desk->clients, ec);
+}
+
+E_API void
+e_desk_client_sticky_update(E_Client *ec)
+{
+   const Eina_List *l;
+   E_Zone *zone;
+
+   E_OBJECT_CHECK(ec);
+   E_OBJECT_TYPE_CHECK(ec, E_CLIENT_TYPE);
+
+   EINA_LIST_FOREACH(e_comp->zones, l, zone)
+     zone->sticky_clients = eina_list_remove(zone->sticky_clients, ec);
+   if ((!ec->sticky) || (!ec->zone) || (e_object_is_del(E_OBJECT(ec))))
+     return;
+   ec->zone->sticky_clients = eina_list_append(ec->zone->sticky_clients, ec);
+}
+
 E_API void
 e_desk_name_set(E_Desk *desk, const char *name)
 {
@@ -699,6 +729,7 @@ _e_desk_free(E_Desk *desk)
         E_Object *obs = (void*)EINA_INLIST_CONTAINER_GET(desk->obstacles, E_Zone_Obstacle);
         e_object_del(obs);
      }
+   desk->clients = eina_list_free(desk->clients);
    eina_stringshare_del(desk->name);
    desk->name = NULL;
    free(desk);
@@ -802,6 +833,7 @@ static void
 _e_desk_show_begin(E_Desk *desk, int dx, int dy)
 {
    E_Client *ec;
+   Eina_List *list;
 
    if (dx < 0) dx = -1;
    if (dx > 0) dx = 1;
@@ -814,16 +846,21 @@ _e_desk_show_begin(E_Desk *desk, int dx, int dy)
         _e_desk_flip_cb(_e_desk_flip_data, desk, dx, dy, 1);
         return;
      }
-   E_CLIENT_FOREACH(ec)
+   /* a window being moved comes along to the new desk */
+   ec = e_client_moving_get();
+   if ((ec) && (ec->moving) && (ec->desk) && (!e_client_util_ignored_get(ec)) &&
+       (ec->desk->zone == desk->zone) && (!ec->iconic))
      {
-        if (e_client_util_ignored_get(ec) || (ec->desk->zone != desk->zone) || (ec->iconic)) continue;
-        if (ec->moving)
-          {
-             e_client_desk_set(ec, desk);
-             evas_object_show(ec->frame);
-             continue;
-          }
-        if ((ec->desk != desk) || (ec->sticky)) continue;
+        e_client_desk_set(ec, desk);
+        evas_object_show(ec->frame);
+     }
+   /* showing/hiding can move transients between desks - walk a copy */
+   list = eina_list_clone(desk->clients);
+   EINA_LIST_FREE(list, ec)
+     {
+        if (e_object_is_del(E_OBJECT(ec))) continue;
+        if (e_client_util_ignored_get(ec) || (ec->iconic)) continue;
+        if ((ec->moving) || (ec->sticky)) continue;
         if ((!starting) && (!ec->new_client) && _e_desk_transition_setup(ec, dx, dy, 1))
           {
              e_comp_object_effect_stop(ec->frame, _e_desk_hide_end);
@@ -844,6 +881,7 @@ static void
 _e_desk_hide_begin(E_Desk *desk, int dx, int dy)
 {
    E_Client *ec;
+   Eina_List *list;
 
    if (dx < 0) dx = -1;
    if (dx > 0) dx = 1;
@@ -856,11 +894,12 @@ _e_desk_hide_begin(E_Desk *desk, int dx, int dy)
         _e_desk_flip_cb(_e_desk_flip_data, desk, dx, dy, 0);
         return;
      }
-   E_CLIENT_FOREACH(ec)
+   list = eina_list_clone(desk->clients);
+   EINA_LIST_FREE(list, ec)
      {
-        if (e_client_util_ignored_get(ec) || (ec->desk->zone != desk->zone) || (ec->iconic)) continue;
-        if (ec->moving) continue;
-        if ((ec->desk != desk) || (ec->sticky)) continue;
+        if (e_object_is_del(E_OBJECT(ec))) continue;
+        if (e_client_util_ignored_get(ec) || (ec->iconic)) continue;
+        if ((ec->moving) || (ec->sticky)) continue;
         if ((!starting) && (!ec->new_client) && _e_desk_transition_setup(ec, -dx, -dy, 0))
           {
              e_comp_object_effect_stop(ec->frame, _e_desk_show_end);
@@ -33,6 +33,7 @@ struct _E_Desk
    unsigned char        visible E_BITFIELD;
    unsigned int         deskshow_toggle E_BITFIELD;
    Eina_List            *fullscreen_clients;
+   Eina_List            *clients; /* every client with ec->desk == desk */
 
    Evas_Object         *bg_object;
 
@@ -76,6 +77,9 @@ E_API void         e_desk_show(E_Desk *desk);
 E_API void         e_desk_deskshow(E_Zone *zone);
 E_API E_Client    *e_desk_last_focused_focus(E_Desk *desk);
 E_API E_Client    *e_desk_client_top_visible_get(const E_Desk *desk);
+EINTERN void       e_desk_client_add(E_Desk *desk, E_Client *ec);
+EINTERN void       e_desk_client_del(E_Desk *desk, E_Client *ec);
+E_API void         e_desk_client_sticky_update(E_Client *ec);
 E_API E_Desk      *e_desk_current_get(E_Zone *zone);
 E_API E_Desk      *e_desk_at_xy_get(const E_Zone *zone, int x, int y);
 E_API E_Desk      *e_desk_at_pos_get(E_Zone *zone, int pos);
@@ -2,6 +2,10 @@
 
 #define SMART_NAME "e_deskmirror"
 
+/* clients are mirrored with reduced resolution copies once the deskmirror
+ * is at most 1/SCALED_RATIO of its zone's size */
+#define SCALED_RATIO 4
+
 #define INTERNAL_ENTRY E_Smart_Data *sd; sd = evas_object_smart_data_get(obj); if (!sd) return;
 
 #define API_ENTRY(X)   E_Smart_Data *sd; \
@@ -32,6 +36,7 @@ typedef struct E_Smart_Data
 
    Eina_Bool resize E_BITFIELD;
    Eina_Bool force E_BITFIELD;
+   Eina_Bool scaled E_BITFIELD;
 } E_Smart_Data;
 
 typedef struct Mirror
@@ -61,6 +66,7 @@ static void _e_deskmirror_mirror_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Ob
 static void _e_deskmirror_mirror_color_set_cb(void *data, Evas_Object *obj, void *event_info EINA_UNUSED);
 
 static void _e_deskmirror_mirror_setup(Mirror *m);
+static Evas_Object *_e_deskmirror_mirror_image_add(E_Smart_Data *sd, Evas_Object *comp_object);
 static void _comp_object_dirty(void *data, Evas_Object *obj, void *event_info EINA_UNUSED);
 static void _comp_object_hide(Mirror *m, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED);
 static void _comp_object_show(Mirror *m, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED);
@@ -132,6 +138,34 @@ _mirror_unref(Mirror *m)
    free(m);
 }
 
+static Eina_Bool
+_e_deskmirror_scaled_get(E_Smart_Data *sd)
+{
+   if (e_comp_config_get()->mirror_scaled_fps <= 0.0) return EINA_FALSE;
+   /* not sized yet: pagers and taskbars always end up small */
+   if ((sd->w < 1) || (sd->h < 1)) return sd->pager || sd->taskbar;
+   return ((sd->w * SCALED_RATIO) <= sd->desk->zone->w) &&
+          ((sd->h * SCALED_RATIO) <= sd->desk->zone->h);
+}
+
+static void
+_mirror_image_swap(Mirror *m)
+{
+   Mirror_Border *mb;
+   Evas_Object *o;
+
+   if ((!m->ec) || (!m->mirror) || (!m->comp_object) || (!m->added)) return;
+   mb = evas_object_smart_data_get(m->mirror);
+   if ((!mb) || (!mb->mirror)) return;
+   o = _e_deskmirror_mirror_image_add(m->sd, m->comp_object);
+   if (!o) return;
+   evas_object_del(mb->mirror);
+   mb->mirror = o;
+   evas_object_name_set(o, "mirror");
+   edje_object_part_swallow(mb->frame, "e.swallow.client", o);
+   if (!evas_object_visible_get(m->sd->clip)) evas_object_hide(o);
+}
+
 static void
 _e_deskmirror_smart_reconfigure(E_Smart_Data *sd)
 {
@@ -153,6 +187,12 @@ _e_deskmirror_smart_reconfigure(E_Smart_Data *sd)
           evas_object_resize(sd->events, sd->w, sd->h);
         EINA_INLIST_FOREACH(sd->mirrors, m)
           _mirror_scale_set(m, (float)sd->h / (float)sd->desk->zone->h);
+        if (sd->scaled != _e_deskmirror_scaled_get(sd))
+          {
+             sd->scaled = !sd->scaled;
+             EINA_INLIST_FOREACH(sd->mirrors, m)
+               _mirror_image_swap(m);
+          }
      }
    e_layout_thaw(sd->layout);
    sd->resize = 0;
@@ -614,7 +654,7 @@ _comp_object_check(Mirror *m)
    if ((w < 2) || (h < 2)) return EINA_FALSE;
    if (!m->mirror)
      {
-        m->mirror = e_comp_object_util_mirror_add(m->comp_object);
+        m->mirror = _e_deskmirror_mirror_image_add(m->sd, m->comp_object);
         if (!m->mirror) return EINA_FALSE;
      }
    evas_object_smart_callback_del(m->comp_object, "dirty", _comp_object_dirty);
@@ -681,6 +721,17 @@ _comp_object_dirty(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EI
    _comp_object_check(data);
 }
 
+static Evas_Object *
+_e_deskmirror_mirror_image_add(E_Smart_Data *sd, Evas_Object *comp_object)
+{
+   Evas_Object *o = NULL;
+
+   if (sd->scaled && e_comp_object_client_get(comp_object))
+     o = e_comp_object_util_mirror_scaled_add(comp_object);
+   if (!o) o = e_comp_object_util_mirror_add(comp_object);
+   return o;
+}
+
 static Mirror *
 _e_deskmirror_mirror_add(E_Smart_Data *sd, Evas_Object *obj)
 {
@@ -717,7 +768,7 @@ _e_deskmirror_mirror_add(E_Smart_Data *sd, Evas_Object *obj)
    evas_object_geometry_get(obj, NULL, NULL, &w, &h);
    if ((w > 1) && (h > 1))
      {
-        o = e_comp_object_util_mirror_add(obj);
+        o = _e_deskmirror_mirror_image_add(sd, obj);
         evas_object_name_set(o, "m->mirror");
      }
    m = calloc(1, sizeof(Mirror));
@@ -826,6 +877,7 @@ e_deskmirror_add(E_Desk *desk, Eina_Bool pager, Eina_Bool taskbar)
    sd->pager = !!pager;
    sd->taskbar = !!taskbar;
    sd->desk = desk;
+   sd->scaled = _e_deskmirror_scaled_get(sd);
    sd->mirror_hash = eina_hash_pointer_new((Eina_Free_Cb)_e_deskmirror_mirror_del_hash);
    sd->desk_delfn = e_object_delfn_add(E_OBJECT(desk), (Ecore_End_Cb)_e_deskmirror_delfn, sd);
    if (pager || taskbar)
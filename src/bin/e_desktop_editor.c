@@ -169,14 +169,14 @@ e_desktop_client_create(E_Client *ec)
    if (ec->netwm.icons)
      {
         /* FIXME
-         * - Find the icon with the best size
          * - Should use mkstemp
          */
         char file[PATH_MAX];
 
         snprintf(file, sizeof(file), "%s-%.6f.png", bname ?: "", ecore_time_get());
         snprintf(path, sizeof(path), "%s/%s", icon_dir, file);
-        if (_e_util_icon_save(&(ec->netwm.icons[0]), path))
+        // the largest one - that scales best wherever the .desktop is used
+        if (_e_util_icon_save(e_client_netwm_icon_get(ec, 0), path))
           desktop->icon = strdup(file);
         else
           fprintf(stderr, "Could not save file from ARGB: %s\n", path);
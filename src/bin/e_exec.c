@@ -12,6 +12,7 @@
 typedef struct _E_Exec_Launch E_Exec_Launch;
 typedef struct _E_Exec_Search E_Exec_Search;
 typedef struct _E_Exec_Watch  E_Exec_Watch;
+typedef struct _E_Exec_Path_Scan E_Exec_Path_Scan;
 
 struct _E_Exec_Launch
 {
@@ -34,6 +35,12 @@ struct _E_Exec_Watch
    Eina_Bool   delete_me E_BITFIELD;
 };
 
+struct _E_Exec_Path_Scan
+{
+   char      *path; // copy of $PATH to scan
+   Eina_Hash *hash; // basename -> full path, built in the thread
+};
+
 struct _E_Config_Dialog_Data
 {
    Efreet_Desktop       *desktop;
@@ -66,10 +73,21 @@ static Evas_Object     *_advanced_create_widgets(E_Config_Dialog *cfd, Evas *eva
 static Evas_Object     *_dialog_scrolltext_create(Evas *evas, char *title, Ecore_Exe_Event_Data_Line *lines);
 static void             _dialog_save_cb(void *data, void *data2);
 static Eina_Bool        _e_exec_instance_free(E_Exec_Instance *inst);
+static void             _e_exec_instance_index_add(E_Exec_Instance *inst);
+static void             _e_exec_instance_index_del(E_Exec_Instance *inst);
+static void             _e_exec_instance_pid_del(E_Exec_Instance *inst);
+static void             _e_exec_path_index_init(void);
+static char            *_e_exec_path_resolve(const char *exec);
+static void             _e_exec_path_index_check(void);
+static void             _e_exec_path_index_shutdown(void);
 
 /* local subsystem globals */
 static Eina_List *e_exec_start_pending = NULL;
 static Eina_Hash *e_exec_instances = NULL;
+/* lookup indexes over e_exec_instances: startup id -> list of instances,
+ * pid -> instance (only real, still running exes) */
+static Eina_Hash *e_exec_startup_ids = NULL;
+static Eina_Hash *e_exec_pids = NULL;
 static int startup_id = 0;
 
 static Ecore_Event_Handler *_e_exec_exit_handler = NULL;
@@ -78,6 +96,14 @@ static Ecore_Event_Handler *_e_exec_desktop_update_handler = NULL;
 static E_Exec_Instance *(*_e_exec_executor_func)(void *data, E_Zone * zone, Efreet_Desktop * desktop, const char *exec, Eina_List *files, const char *launch_method) = NULL;
 static void *_e_exec_executor_data = NULL;
 
+/* index of executables found in $PATH: basename -> full path */
+static Eina_Hash *_e_exec_path_hash = NULL;
+static Eina_List *_e_exec_path_monitors = NULL;
+static Ecore_Thread *_e_exec_path_thread = NULL;
+static Ecore_Timer *_e_exec_path_timer = NULL;
+static Eina_Bool _e_exec_path_dirty = EINA_FALSE;
+static char *_e_exec_path_env = NULL; /* the $PATH that is watched */
+
 E_API int E_EVENT_EXEC_NEW = -1;
 E_API int E_EVENT_EXEC_NEW_CLIENT = -1;
 E_API int E_EVENT_EXEC_DEL = -1;
@@ -87,6 +113,8 @@ EINTERN int
 e_exec_init(void)
 {
    e_exec_instances = eina_hash_string_superfast_new(NULL);
+   e_exec_startup_ids = eina_hash_int32_new(EINA_FREE_CB(eina_list_free));
+   e_exec_pids = eina_hash_int32_new(NULL);
 
    _e_exec_exit_handler =
      ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _e_exec_cb_exit, NULL);
@@ -96,6 +124,8 @@ e_exec_init(void)
    E_EVENT_EXEC_NEW = ecore_event_type_new();
    E_EVENT_EXEC_NEW_CLIENT = ecore_event_type_new();
    E_EVENT_EXEC_DEL = ecore_event_type_new();
+
+   _e_exec_path_index_init();
    return 1;
 }
 
@@ -106,7 +136,10 @@ e_exec_shutdown(void)
    if (_e_exec_desktop_update_handler)
      ecore_event_handler_del(_e_exec_desktop_update_handler);
    eina_hash_free(e_exec_instances);
+   E_FREE_FUNC(e_exec_startup_ids, eina_hash_free);
+   E_FREE_FUNC(e_exec_pids, eina_hash_free);
    eina_list_free(e_exec_start_pending);
+   _e_exec_path_index_shutdown();
    return 1;
 }
 
@@ -279,6 +312,7 @@ e_exec_phony(E_Client *ec)
    lnew = eina_list_append(l, inst);
    if (l) eina_hash_modify(e_exec_instances, inst->key, lnew);
    else eina_hash_add(e_exec_instances, inst->key, lnew);
+   _e_exec_instance_index_add(inst);
    inst->ref++;
    ecore_event_add(E_EVENT_EXEC_NEW, inst, _e_exec_cb_exec_new_free, inst);
    e_exec_instance_client_add(inst, ec);
@@ -288,14 +322,16 @@ e_exec_phony(E_Client *ec)
 E_API E_Exec_Instance *
 e_exec_startup_id_pid_instance_find(int id, pid_t pid)
 {
-   E_Exec_Search search;
+   Eina_List *l;
 
-   search.inst = NULL;
-   search.desktop = NULL;
-   search.startup_id = id;
-   search.pid = pid;
-   eina_hash_foreach(e_exec_instances, _e_exec_startup_id_pid_find, &search);
-   return search.inst;
+   if (id > 0)
+     {
+        l = eina_hash_find(e_exec_startup_ids, &id);
+        if (l) return eina_list_data_get(l);
+     }
+   if (pid > 1)
+     return eina_hash_find(e_exec_pids, &pid);
+   return NULL;
 }
 
 E_API Efreet_Desktop *
@@ -401,7 +437,270 @@ e_exec_instance_watcher_del(E_Exec_Instance *inst, void (*func)(void *data, E_Ex
      }
 }
 
+/*
+ * Look up an executable by name in $PATH. Returns its full path (to be freed
+ * with free()) or NULL if nothing executable with that name is in $PATH.
+ * Names containing a '/' are checked directly. Lookups are served from an
+ * index built in a thread at init and refreshed when a $PATH directory
+ * changes; until it is ready this falls back to searching $PATH.
+ */
+E_API char *
+e_exec_path_find(const char *name)
+{
+   const char *env, *found;
+   char **split, buf[PATH_MAX];
+   int i;
+
+   if ((!name) || (!name[0])) return NULL;
+   if (strchr(name, '/'))
+     {
+        if (ecore_file_exists(name) && ecore_file_can_exec(name))
+          return strdup(name);
+        return NULL;
+     }
+   _e_exec_path_index_check();
+   if ((_e_exec_path_hash) && (!_e_exec_path_dirty))
+     {
+        found = eina_hash_find(_e_exec_path_hash, name);
+        if (found) return strdup(found);
+        return NULL;
+     }
+
+   env = getenv("PATH");
+   if (!env) return NULL;
+   split = eina_str_split(env, ":", 0);
+   if (!split) return NULL;
+   for (i = 0; split[i]; i++)
+     {
+        if (!split[i][0]) continue;
+        snprintf(buf, sizeof(buf), "%s/%s", split[i], name);
+        if (ecore_file_exists(buf) && ecore_file_can_exec(buf))
+          {
+             free(split[0]);
+             free(split);
+             return strdup(buf);
+          }
+     }
+   free(split[0]);
+   free(split);
+   return NULL;
+}
+
 /* local subsystem functions */
+
+/* a plain word the shell takes as is - no quoting, expansion or path */
+static Eina_Bool
+_e_exec_path_char_plain(char c)
+{
+   return isalnum((unsigned char)c) || strchr("-_.+", c);
+}
+
+/* if the command starts with a plain program name that the $PATH index
+ * knows, return the command with that name replaced by its full path so
+ * the exec does not search $PATH again. argv[0] becomes the full path, its
+ * basename stays the same. NULL means run it as it is */
+static char *
+_e_exec_path_resolve(const char *exec)
+{
+   const char *p, *found;
+   char name[PATH_MAX], *ret;
+   size_t len;
+
+   if (!exec) return NULL;
+   _e_exec_path_index_check();
+   if ((!_e_exec_path_hash) || (_e_exec_path_dirty)) return NULL;
+   for (p = exec; (*p == ' ') || (*p == '\t'); p++);
+   for (len = 0; p[len] && (p[len] != ' ') && (p[len] != '\t'); len++)
+     {
+        /* anything the shell would interpret (or a path) is left alone */
+        if (!_e_exec_path_char_plain(p[len])) return NULL;
+     }
+   if ((len == 0) || (len >= sizeof(name))) return NULL;
+   memcpy(name, p, len);
+   name[len] = 0;
+   found = eina_hash_find(_e_exec_path_hash, name);
+   if (!found) return NULL;
+   /* the path goes into a shell command line - only substitute it if it
+    * needs no quoting there */
+   for (len = 0; found[len]; len++)
+     {
+        if ((found[len] != '/') && (!_e_exec_path_char_plain(found[len])))
+          return NULL;
+     }
+   len = strlen(name);
+   ret = malloc(strlen(found) + strlen(p + len) + 1);
+   if (!ret) return NULL;
+   strcpy(ret, found);
+   strcat(ret, p + len);
+   return ret;
+}
+
+static void
+_e_exec_path_scan_free(E_Exec_Path_Scan *scan)
+{
+   if (scan->hash) eina_hash_free(scan->hash);
+   free(scan->path);
+   free(scan);
+}
+
+static void
+_e_exec_path_cb_scan(void *data, Ecore_Thread *th)
+{
+   E_Exec_Path_Scan *scan = data;
+   Eina_Iterator *it;
+   Eina_File_Direct_Info *info;
+   char **split;
+   struct stat st;
+   int i;
+
+   split = eina_str_split(scan->path, ":", 0);
+   if (!split) return;
+   for (i = 0; split[i]; i++)
+     {
+        if (ecore_thread_check(th)) break;
+        if (!split[i][0]) continue;
+        it = eina_file_direct_ls(split[i]);
+        if (!it) continue;
+        EINA_ITERATOR_FOREACH(it, info)
+          {
+             const char *base = info->path + info->name_start;
+
+             /* earlier $PATH entries win, as with execvp() */
+             if (eina_hash_find(scan->hash, base)) continue;
+             if (info->type == EINA_FILE_DIR) continue;
+             if (stat(info->path, &st) || (!S_ISREG(st.st_mode))) continue;
+             if (access(info->path, X_OK)) continue;
+             eina_hash_add(scan->hash, base, strdup(info->path));
+          }
+        eina_iterator_free(it);
+     }
+   free(split[0]);
+   free(split);
+}
+
+static void
+_e_exec_path_scan_start(void);
+
+static void
+_e_exec_path_cb_scan_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Exec_Path_Scan *scan = data;
+
+   _e_exec_path_thread = NULL;
+   if (_e_exec_path_hash) eina_hash_free(_e_exec_path_hash);
+   _e_exec_path_hash = scan->hash;
+   scan->hash = NULL;
+   _e_exec_path_scan_free(scan);
+   /* something changed while we were scanning */
+   if (_e_exec_path_dirty) _e_exec_path_scan_start();
+}
+
+static void
+_e_exec_path_cb_scan_cancel(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   _e_exec_path_thread = NULL;
+   _e_exec_path_scan_free(data);
+}
+
+static void
+_e_exec_path_scan_start(void)
+{
+   E_Exec_Path_Scan *scan;
+   const char *env;
+
+   if (_e_exec_path_thread) return;
+   env = getenv("PATH");
+   if (!env) return;
+   scan = E_NEW(E_Exec_Path_Scan, 1);
+   if (!scan) return;
+   scan->path = strdup(env);
+   scan->hash = eina_hash_string_superfast_new(free);
+   _e_exec_path_dirty = EINA_FALSE;
+   _e_exec_path_thread =
+     ecore_thread_run(_e_exec_path_cb_scan, _e_exec_path_cb_scan_end,
+                      _e_exec_path_cb_scan_cancel, scan);
+}
+
+static Eina_Bool
+_e_exec_path_cb_timer(void *data EINA_UNUSED)
+{
+   _e_exec_path_timer = NULL;
+   if (_e_exec_path_thread) _e_exec_path_dirty = EINA_TRUE;
+   else _e_exec_path_scan_start();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_e_exec_path_cb_monitor(void *data EINA_UNUSED, Ecore_File_Monitor *em EINA_UNUSED, Ecore_File_Event event EINA_UNUSED, const char *path EINA_UNUSED)
+{
+   /* lookups go back to searching $PATH until the index is rebuilt; package
+    * installs touch many files at once so wait for things to settle */
+   _e_exec_path_dirty = EINA_TRUE;
+   if (_e_exec_path_timer)
+     ecore_timer_loop_reset(_e_exec_path_timer);
+   else
+     _e_exec_path_timer = ecore_timer_loop_add(1.0, _e_exec_path_cb_timer, NULL);
+}
+
+static void
+_e_exec_path_watch(void)
+{
+   Ecore_File_Monitor *mon;
+   const char *env;
+   char **split;
+   int i;
+
+   E_FREE_LIST(_e_exec_path_monitors, ecore_file_monitor_del);
+   E_FREE(_e_exec_path_env);
+   env = getenv("PATH");
+   if (!env) return;
+   _e_exec_path_env = strdup(env);
+   split = eina_str_split(env, ":", 0);
+   if (!split) return;
+   for (i = 0; split[i]; i++)
+     {
+        if ((!split[i][0]) || (!ecore_file_is_dir(split[i]))) continue;
+        mon = ecore_file_monitor_add(split[i], _e_exec_path_cb_monitor, NULL);
+        if (mon)
+          _e_exec_path_monitors = eina_list_append(_e_exec_path_monitors, mon);
+     }
+   free(split[0]);
+   free(split);
+}
+
+static void
+_e_exec_path_index_init(void)
+{
+   _e_exec_path_watch();
+   _e_exec_path_scan_start();
+}
+
+static void
+_e_exec_path_index_check(void)
+{
+   const char *env = getenv("PATH");
+
+   if ((!env) && (!_e_exec_path_env)) return;
+   if ((env) && (_e_exec_path_env) && (!strcmp(env, _e_exec_path_env)))
+     return;
+   /* $PATH was changed (eg. through e_env) - watch and index the new one,
+    * lookups search $PATH directly until that is done */
+   _e_exec_path_watch();
+   _e_exec_path_dirty = EINA_TRUE;
+   if (!_e_exec_path_thread) _e_exec_path_scan_start();
+}
+
+static void
+_e_exec_path_index_shutdown(void)
+{
+   E_FREE_LIST(_e_exec_path_monitors, ecore_file_monitor_del);
+   E_FREE(_e_exec_path_env);
+   E_FREE_FUNC(_e_exec_path_timer, ecore_timer_del);
+   if (_e_exec_path_thread) ecore_thread_cancel(_e_exec_path_thread);
+   _e_exec_path_thread = NULL;
+   E_FREE_FUNC(_e_exec_path_hash, eina_hash_free);
+}
+
 static E_Exec_Instance *
 _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
 {
@@ -409,7 +708,8 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
    E_Exec_Launch *launch;
    Eina_List *l, *lnew;
    Ecore_Exe *exe = NULL;
-   char buf[4096];
+   char buf[4096], *run;
+   const char *cmd;
 
    launch = data;
    inst = E_NEW(E_Exec_Instance, 1);
@@ -435,10 +735,13 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
 //			    ECORE_EXE_PIPE_AUTO | ECORE_EXE_PIPE_READ | ECORE_EXE_PIPE_ERROR |
 //			    ECORE_EXE_PIPE_READ_LINE_BUFFERED | ECORE_EXE_PIPE_ERROR_LINE_BUFFERED,
 //			    inst);
+   run = _e_exec_path_resolve(exec);
+   cmd = run ? run : exec;
    if ((desktop) && (desktop->path) && (desktop->path[0]))
      {
         if (!getcwd(buf, sizeof(buf)))
           {
+             free(run);
              free(inst);
              e_util_dialog_show
                (_("Run Error"),
@@ -447,6 +750,7 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
           }
         if (chdir(desktop->path))
           {
+             free(run);
              free(inst);
              e_util_dialog_show
                (_("Run Error"),
@@ -456,7 +760,7 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
                desktop->path);
              return NULL;
           }
-        exe = e_util_exe_safe_run(exec, inst);
+        exe = e_util_exe_safe_run(cmd, inst);
         if (chdir(buf))
           {
              e_util_dialog_show
@@ -494,11 +798,11 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
                          }
                     }
                   else
-                    exe = e_util_exe_safe_run(exec, inst);
+                    exe = e_util_exe_safe_run(cmd, inst);
                   efreet_desktop_free(tdesktop);
                }
              else
-               exe = e_util_exe_safe_run(exec, inst);
+               exe = e_util_exe_safe_run(cmd, inst);
           }
         else if (desktop && desktop->url)
           {
@@ -513,8 +817,9 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
              free(sb);
           }
         else
-          exe = e_util_exe_safe_run(exec, inst);
+          exe = e_util_exe_safe_run(cmd, inst);
      }
+   free(run);
 
    if (!exe)
      {
@@ -552,6 +857,7 @@ _e_exec_cb_exec(void *data, Efreet_Desktop *desktop, char *exec, int remaining)
    lnew = eina_list_append(l, inst);
    if (l) eina_hash_modify(e_exec_instances, inst->key, lnew);
    else eina_hash_add(e_exec_instances, inst->key, lnew);
+   _e_exec_instance_index_add(inst);
    if (inst->desktop && inst->desktop->exec)
      {
         e_exec_start_pending = eina_list_append(e_exec_start_pending,
@@ -603,6 +909,7 @@ _e_exec_instance_free(E_Exec_Instance *inst)
              else
                eina_hash_del_by_key(e_exec_instances, inst->key);
           }
+        _e_exec_instance_index_del(inst);
         eina_stringshare_replace(&inst->key, NULL);
      }
    if (!inst->deleted)
@@ -617,6 +924,57 @@ _e_exec_instance_free(E_Exec_Instance *inst)
    return EINA_TRUE;
 }
 
+static void
+_e_exec_instance_index_add(E_Exec_Instance *inst)
+{
+   Eina_List *l;
+   pid_t pid;
+
+   if (inst->startup_id > 0)
+     {
+        l = eina_hash_find(e_exec_startup_ids, &inst->startup_id);
+        if (l)
+          eina_hash_modify(e_exec_startup_ids, &inst->startup_id,
+                           eina_list_append(l, inst));
+        else
+          eina_hash_add(e_exec_startup_ids, &inst->startup_id,
+                        eina_list_append(NULL, inst));
+     }
+   if ((inst->phony) || (!inst->exe)) return;
+   pid = ecore_exe_pid_get(inst->exe);
+   if (pid > 1) eina_hash_set(e_exec_pids, &pid, inst);
+}
+
+static void
+_e_exec_instance_pid_del(E_Exec_Instance *inst)
+{
+   pid_t pid;
+
+   if ((inst->phony) || (!inst->exe)) return;
+   pid = ecore_exe_pid_get(inst->exe);
+   /* the pid may already belong to a newer instance */
+   if (eina_hash_find(e_exec_pids, &pid) == inst)
+     eina_hash_del_by_key(e_exec_pids, &pid);
+}
+
+static void
+_e_exec_instance_index_del(E_Exec_Instance *inst)
+{
+   Eina_List *l;
+
+   if (inst->startup_id > 0)
+     {
+        l = eina_hash_find(e_exec_startup_ids, &inst->startup_id);
+        /* deleting the key frees the list with it */
+        if ((l) && (!eina_list_next(l)) && (eina_list_data_get(l) == inst))
+          eina_hash_del_by_key(e_exec_startup_ids, &inst->startup_id);
+        else if (l)
+          eina_hash_modify(e_exec_startup_ids, &inst->startup_id,
+                           eina_list_remove(l, inst));
+     }
+   _e_exec_instance_pid_del(inst);
+}
+
 /*
    static Eina_Bool
    _e_exec_cb_instance_finish(void *data)
@@ -758,6 +1116,7 @@ _e_exec_cb_exit(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
    else
  */
    inst->ref--;
+   _e_exec_instance_pid_del(inst);
    inst->exe = NULL;
    _e_exe_instance_watchers_call(inst, E_EXEC_WATCH_STOPPED);
    _e_exec_instance_free(inst);
@@ -45,6 +45,8 @@ E_API void e_exec_instance_watcher_add(E_Exec_Instance *inst, void (*func) (void
 E_API void e_exec_instance_watcher_del(E_Exec_Instance *inst, void (*func) (void *data, E_Exec_Instance *inst, E_Exec_Watch_Type type), const void *data);
 E_API const Eina_List *e_exec_desktop_instances_find(const Efreet_Desktop *desktop);
 
+E_API char *e_exec_path_find(const char *name);
+
 E_API const Eina_Hash *e_exec_instances_get(void);
 E_API void e_exec_instance_client_add(E_Exec_Instance *inst, E_Client *ec);
 
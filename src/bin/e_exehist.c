@@ -6,6 +6,8 @@ E_API int E_EVENT_EXEHIST_UPDATE = 0;
 /* local subsystem functions */
 typedef struct _E_Exehist      E_Exehist;
 typedef struct _E_Exehist_Item E_Exehist_Item;
+typedef struct _E_Exehist_Index E_Exehist_Index;
+typedef struct _E_Exehist_Mime E_Exehist_Mime;
 
 struct _E_Exehist
 {
@@ -20,25 +22,59 @@ struct _E_Exehist_Item
    const char  *normalized_exe;
    const char  *launch_method;
    double       exetime;
+};
+
+/* running totals per normalized exe, kept in step with the history */
+struct _E_Exehist_Index
+{
+   const char  *normalized_exe;
+   const char  *exe; /* the most recent exe line run under this name */
+   double       exetime; /* newest run */
    unsigned int count;
+   unsigned int pos; /* slot in _e_exehist_popular */
+};
+
+/* what is known about one mime type, built on first use */
+struct _E_Exehist_Mime
+{
+   Efreet_Desktop *preferred; /* the user's choice from the history */
+   Eina_List      *desktops; /* preferred first, then efreet's handlers */
 };
 
-static void        _e_exehist_unload_queue(void);
+static void        _e_exehist_save_queue(void);
 static void        _e_exehist_load(void);
 static void        _e_exehist_clear(void);
 static void        _e_exehist_unload(void);
 static void        _e_exehist_limit(void);
 static const char *_e_exehist_normalize_exe(const char *exe);
-static void        _e_exehist_cb_unload(void *data);
+static void        _e_exehist_cb_save(void *data);
 static int         _e_exehist_sort_exe_cb(const void *d1, const void *d2);
-static int         _e_exehist_sort_pop_cb(const void *d1, const void *d2);
+static void        _e_exehist_index_item_add(E_Exehist_Item *ei);
+static void        _e_exehist_index_item_del(E_Exehist_Item *ei);
+static void        _e_exehist_index_rebuild(void);
+static void        _e_exehist_index_flush(void);
+static void        _e_exehist_mime_item_del(E_Exehist_Item *ei);
+static E_Exehist_Mime *_e_exehist_mime_get(const char *mime);
+static void        _e_exehist_mime_free(void *data);
+static Eina_Bool   _e_exehist_cb_efreet_cache_update(void *data, int ev_type, void *ev);
 
 /* local subsystem globals */
 static E_Config_DD *_e_exehist_config_edd = NULL;
 static E_Config_DD *_e_exehist_config_item_edd = NULL;
 static E_Exehist *_e_exehist = NULL;
-static E_Powersave_Deferred_Action *_e_exehist_unload_defer = NULL;
+static E_Powersave_Deferred_Action *_e_exehist_save_defer = NULL;
 static int _e_exehist_changes = 0;
+/* the history stays loaded once used - queries go through these */
+static Eina_Hash *_e_exehist_index = NULL;
+static E_Exehist_Index **_e_exehist_popular = NULL; /* most run first */
+static unsigned int _e_exehist_popular_count = 0;
+static unsigned int _e_exehist_popular_alloc = 0;
+/* mime -> entry in _e_exehist->mimes */
+static Eina_Hash *_e_exehist_mimes = NULL;
+/* mime -> E_Exehist_Mime merging the history's choice with efreet's
+ * handlers, dropped whenever efreet's desktop cache changes */
+static Eina_Hash *_e_exehist_mime_desktops = NULL;
+static Eina_List *_e_exehist_handlers = NULL;
 
 static void
 _upgrade_defaults_to_mimeapps(void)
@@ -78,6 +114,10 @@ e_exehist_init(void)
    E_CONFIG_VAL(D, T, startup_id, INT);
 
    E_EVENT_EXEHIST_UPDATE = ecore_event_type_new();
+   E_LIST_HANDLER_APPEND(_e_exehist_handlers, EFREET_EVENT_DESKTOP_CACHE_UPDATE,
+                         _e_exehist_cb_efreet_cache_update, NULL);
+   E_LIST_HANDLER_APPEND(_e_exehist_handlers, EFREET_EVENT_DESKTOP_CACHE_BUILD,
+                         _e_exehist_cb_efreet_cache_update, NULL);
 
    _upgrade_defaults_to_mimeapps();
 
@@ -87,12 +127,14 @@ e_exehist_init(void)
 EINTERN int
 e_exehist_shutdown(void)
 {
-   if (_e_exehist_unload_defer)
+   if (_e_exehist_save_defer)
      {
-        e_powersave_deferred_action_del(_e_exehist_unload_defer);
-        _e_exehist_unload_defer = NULL;
+        e_powersave_deferred_action_del(_e_exehist_save_defer);
+        _e_exehist_save_defer = NULL;
      }
-   _e_exehist_cb_unload(NULL);
+   E_FREE_LIST(_e_exehist_handlers, ecore_event_handler_del);
+   _e_exehist_cb_save(NULL);
+   _e_exehist_unload();
    E_CONFIG_DD_FREE(_e_exehist_config_item_edd);
    E_CONFIG_DD_FREE(_e_exehist_config_edd);
    return 1;
@@ -105,7 +147,7 @@ e_exehist_startup_id_set(int id)
    if (!_e_exehist) return;
    _e_exehist->startup_id = id;
    _e_exehist_changes++;
-   _e_exehist_unload_queue();
+   _e_exehist_save_queue();
 }
 
 E_API int
@@ -115,7 +157,6 @@ e_exehist_startup_id_get(void)
    _e_exehist_load();
    if (!_e_exehist) return 0;
    id = _e_exehist->startup_id;
-   _e_exehist_unload_queue();
    return id;
 }
 
@@ -127,32 +168,29 @@ e_exehist_add(const char *launch_method, const char *exe)
    _e_exehist_load();
    if (!_e_exehist) return;
    ei = E_NEW(E_Exehist_Item, 1);
-   if (!ei)
-     {
-        _e_exehist_unload_queue();
-        return;
-     }
+   if (!ei) return;
    ei->launch_method = eina_stringshare_add(launch_method);
    ei->exe = eina_stringshare_add(exe);
    ei->normalized_exe = _e_exehist_normalize_exe(exe);
    ei->exetime = ecore_time_unix_get();
    _e_exehist->history = eina_list_append(_e_exehist->history, ei);
+   _e_exehist_index_item_add(ei);
    _e_exehist_limit();
    _e_exehist_changes++;
    ecore_event_add(E_EVENT_EXEHIST_UPDATE, NULL, NULL, NULL);
-   _e_exehist_unload_queue();
+   _e_exehist_save_queue();
 }
 
 E_API void
 e_exehist_del(const char *exe)
 {
    E_Exehist_Item *ei;
-   Eina_List *l;
+   Eina_List *l, *ll;
    Eina_Bool ok = EINA_FALSE;
 
    _e_exehist_load();
    if (!_e_exehist) return;
-   EINA_LIST_FOREACH(_e_exehist->history, l, ei)
+   EINA_LIST_FOREACH_SAFE(_e_exehist->history, l, ll, ei)
      {
         if ((ei->exe) && (!strcmp(exe, ei->exe)))
           {
@@ -163,12 +201,16 @@ e_exehist_del(const char *exe)
              _e_exehist->history = eina_list_remove_list(_e_exehist->history,
                                                          l);
              _e_exehist_changes++;
-             _e_exehist_unload_queue();
              ok = EINA_TRUE;
           }
      }
    if (ok)
-     ecore_event_add(E_EVENT_EXEHIST_UPDATE, NULL, NULL, NULL);
+     {
+        /* the newest run of a name may have gone - recount */
+        _e_exehist_index_rebuild();
+        _e_exehist_save_queue();
+        ecore_event_add(E_EVENT_EXEHIST_UPDATE, NULL, NULL, NULL);
+     }
 }
 
 E_API void
@@ -179,54 +221,39 @@ e_exehist_clear(void)
    _e_exehist_clear();
    _e_exehist_changes++;
    ecore_event_add(E_EVENT_EXEHIST_UPDATE, NULL, NULL, NULL);
-   _e_exehist_unload_queue();
+   _e_exehist_save_queue();
 }
 
 E_API int
 e_exehist_popularity_get(const char *exe)
 {
-   Eina_List *l;
-   E_Exehist_Item *ei;
+   E_Exehist_Index *idx;
    const char *normal;
-   int count = 0;
 
    _e_exehist_load();
    if (!_e_exehist) return 0;
    normal = _e_exehist_normalize_exe(exe);
    if (!normal) return 0;
-   EINA_LIST_FOREACH(_e_exehist->history, l, ei)
-     {
-        if ((ei->normalized_exe) && (!strcmp(normal, ei->normalized_exe)))
-          count++;
-     }
+   idx = eina_hash_find(_e_exehist_index, normal);
    eina_stringshare_del(normal);
-   _e_exehist_unload_queue();
-   return count;
+   if (!idx) return 0;
+   return idx->count;
 }
 
 E_API double
 e_exehist_newest_run_get(const char *exe)
 {
-   Eina_List *l;
-   E_Exehist_Item *ei;
+   E_Exehist_Index *idx;
    const char *normal;
 
    _e_exehist_load();
    if (!_e_exehist) return 0.0;
    normal = _e_exehist_normalize_exe(exe);
    if (!normal) return 0.0;
-   EINA_LIST_REVERSE_FOREACH(_e_exehist->history, l, ei)
-     {
-        if ((ei->normalized_exe) && (!strcmp(normal, ei->normalized_exe)))
-          {
-             eina_stringshare_del(normal);
-             _e_exehist_unload_queue();
-             return ei->exetime;
-          }
-     }
+   idx = eina_hash_find(_e_exehist_index, normal);
    eina_stringshare_del(normal);
-   _e_exehist_unload_queue();
-   return 0.0;
+   if (!idx) return 0.0;
+   return idx->exetime;
 }
 
 E_API Eina_List *
@@ -238,18 +265,25 @@ e_exehist_list_get(void)
 E_API Eina_List *
 e_exehist_sorted_list_get(E_Exehist_Sort sort_type, int max)
 {
-   Eina_List *list = NULL, *pop = NULL, *l = NULL, *m;
+   Eina_List *list = NULL, *l = NULL;
    Eina_Iterator *iter;
+   Eina_Hash *seen;
    E_Exehist_Item *ei;
+   unsigned int i;
    int count = 1;
-   E_Exehist_Item *prev = NULL;
 
    if (!max) max = 20;
    _e_exehist_load();
+   if (!_e_exehist) return NULL;
+   if (sort_type == E_EXEHIST_SORT_BY_POPULARITY)
+     {
+        for (i = 0; (i < _e_exehist_popular_count) && (count <= max); i++, count++)
+          list = eina_list_append(list, _e_exehist_popular[i]->exe);
+        return list;
+     }
    switch (sort_type)
      {
       case E_EXEHIST_SORT_BY_EXE:
-      case E_EXEHIST_SORT_BY_POPULARITY:
         l = eina_list_clone(_e_exehist->history);
         l = eina_list_sort(l, 0, _e_exehist_sort_exe_cb);
         iter = eina_list_iterator_new(l);
@@ -259,56 +293,21 @@ e_exehist_sorted_list_get(E_Exehist_Sort sort_type, int max)
         iter = eina_list_iterator_reversed_new(_e_exehist->history);
         break;
      }
+   /* exe strings are stringshared so the pointer identifies them */
+   seen = eina_hash_pointer_new(NULL);
    EINA_ITERATOR_FOREACH(iter, ei)
      {
-        int bad = 0;
-
         if (!(ei->normalized_exe)) continue;
-        if (sort_type == E_EXEHIST_SORT_BY_POPULARITY)
-          {
-             if (!prev || (strcmp(prev->normalized_exe, ei->normalized_exe)))
-               {
-                  prev = ei;
-                  pop = eina_list_append(pop, ei);
-               }
-             prev->count++;
-          }
-        else
-          {
-             const char *exe;
-
-             EINA_LIST_FOREACH(list, m, exe)
-               {
-                  if (!exe) continue;
-                  if (!strcmp(exe, ei->exe))
-                    {
-                       bad = 1;
-                       break;
-                    }
-               }
-             if (!(bad))
-               {
-                  list = eina_list_append(list, ei->exe);
-                  count++;
-               }
-          }
+        if (!ei->exe) continue;
+        if (eina_hash_find(seen, &ei->exe)) continue;
+        eina_hash_add(seen, &ei->exe, ei);
+        list = eina_list_append(list, ei->exe);
+        count++;
         if (count > max) break;
      }
-   if (sort_type == E_EXEHIST_SORT_BY_POPULARITY)
-     {
-        count = 1;
-        pop = eina_list_sort(pop, 0, _e_exehist_sort_pop_cb);
-        EINA_LIST_FOREACH(pop, l, prev)
-          {
-             list = eina_list_append(list, prev->exe);
-             count++;
-             if (count > max) break;
-          }
-        eina_list_free(pop);
-     }
+   eina_hash_free(seen);
    eina_list_free(l);
    eina_iterator_free(iter);
-   _e_exehist_unload_queue();
    return list;
 }
 
@@ -317,7 +316,6 @@ e_exehist_mime_desktop_add(const char *mime, Efreet_Desktop *desktop)
 {
    const char *f;
    E_Exehist_Item *ei;
-   Eina_List *l;
    char buf[PATH_MAX];
    Efreet_Ini *ini;
 
@@ -329,6 +327,10 @@ e_exehist_mime_desktop_add(const char *mime, Efreet_Desktop *desktop)
    f = efreet_util_path_to_file_id(desktop->orig_path);
    if (!f) return;
 
+   /* already the preferred app - nothing to write */
+   ei = eina_hash_find(_e_exehist_mimes, mime);
+   if ((ei) && (ei->exe) && (!strcmp(f, ei->exe))) return;
+
    snprintf(buf, sizeof(buf), "%s/mimeapps.list",
             efreet_config_home_get());
    ini = efreet_ini_new(buf);
@@ -347,91 +349,84 @@ e_exehist_mime_desktop_add(const char *mime, Efreet_Desktop *desktop)
         efreet_ini_free(ini);
      }
 
-   EINA_LIST_FOREACH(_e_exehist->mimes, l, ei)
+   if (ei)
      {
-        if ((ei->launch_method) && (!strcmp(mime, ei->launch_method)))
-          {
-             if ((ei->exe) && (!strcmp(f, ei->exe)))
-               {
-                  _e_exehist_unload_queue();
-                  return;
-               }
-             if (ei->exe) eina_stringshare_del(ei->exe);
-             if (ei->launch_method) eina_stringshare_del(ei->launch_method);
-             free(ei);
-             _e_exehist->mimes = eina_list_remove_list(_e_exehist->mimes, l);
-             _e_exehist_changes++;
-             break;
-          }
+        _e_exehist_mime_item_del(ei);
+        _e_exehist->mimes = eina_list_remove(_e_exehist->mimes, ei);
+        if (ei->exe) eina_stringshare_del(ei->exe);
+        if (ei->launch_method) eina_stringshare_del(ei->launch_method);
+        free(ei);
+        _e_exehist_changes++;
      }
    ei = E_NEW(E_Exehist_Item, 1);
-   if (!ei)
-     {
-        _e_exehist_unload_queue();
-        return;
-     }
+   if (!ei) return;
    ei->launch_method = eina_stringshare_add(mime);
    ei->exe = eina_stringshare_add(f);
    ei->exetime = ecore_time_unix_get();
    _e_exehist->mimes = eina_list_append(_e_exehist->mimes, ei);
+   if (!_e_exehist_mimes)
+     _e_exehist_mimes = eina_hash_string_superfast_new(NULL);
+   eina_hash_set(_e_exehist_mimes, ei->launch_method, ei);
+   if (_e_exehist_mime_desktops)
+     eina_hash_del_by_key(_e_exehist_mime_desktops, mime);
    _e_exehist_limit();
    _e_exehist_changes++;
-   _e_exehist_unload_queue();
+   _e_exehist_save_queue();
 }
 
 E_API Efreet_Desktop *
 e_exehist_mime_desktop_get(const char *mime)
 {
+   E_Exehist_Mime *em;
+
+   em = _e_exehist_mime_get(mime);
+   if ((!em) || (!em->preferred)) return NULL;
+   efreet_desktop_ref(em->preferred);
+   return em->preferred;
+}
+
+E_API Eina_List *
+e_exehist_mime_desktops_get(const char *mime)
+{
+   E_Exehist_Mime *em;
    Efreet_Desktop *desktop;
-   E_Exehist_Item *ei;
-   Eina_List *l;
+   Eina_List *l, *list = NULL;
 
-   //fprintf(stderr, "e_exehist_mime_desktop_get(%s)\n", mime);
-   if (!mime) return NULL;
-   _e_exehist_load();
-   //fprintf(stderr, "x\n");
-   if (!_e_exehist) return NULL;
-   EINA_LIST_FOREACH(_e_exehist->mimes, l, ei)
+   em = _e_exehist_mime_get(mime);
+   if (!em) return NULL;
+   EINA_LIST_FOREACH(em->desktops, l, desktop)
      {
-        //fprintf(stderr, "look for %s == %s\n", mime, ei->launch_method);
-        if ((ei->launch_method) && (!strcmp(mime, ei->launch_method)))
-          {
-             desktop = NULL;
-             if (ei->exe) desktop = efreet_util_desktop_file_id_find(ei->exe);
-             //fprintf(stderr, "  desk = %p\n", desktop);
-             if (desktop)
-               {
-                  _e_exehist_unload_queue();
-                  return desktop;
-               }
-          }
+        efreet_desktop_ref(desktop);
+        list = eina_list_append(list, desktop);
      }
-   _e_exehist_unload_queue();
-   return NULL;
+   return list;
 }
 
 /* local subsystem functions */
 static void
-_e_exehist_unload_queue(void)
+_e_exehist_save_queue(void)
 {
-   if (_e_exehist_unload_defer)
-     e_powersave_deferred_action_del(_e_exehist_unload_defer);
-   _e_exehist_unload_defer =
-     e_powersave_deferred_action_add(_e_exehist_cb_unload, NULL);
+   if (_e_exehist_save_defer)
+     e_powersave_deferred_action_del(_e_exehist_save_defer);
+   _e_exehist_save_defer =
+     e_powersave_deferred_action_add(_e_exehist_cb_save, NULL);
 }
 
 static void
 _e_exehist_load(void)
 {
-   if (!_e_exehist)
-     _e_exehist = e_config_domain_load("exehist", _e_exehist_config_edd);
+   if (_e_exehist) return;
+   _e_exehist = e_config_domain_load("exehist", _e_exehist_config_edd);
    if (!_e_exehist)
      _e_exehist = E_NEW(E_Exehist, 1);
+   if (!_e_exehist) return;
+   _e_exehist_index_rebuild();
 }
 
 static void
 _e_exehist_clear(void)
 {
+   _e_exehist_index_flush();
    if (_e_exehist)
      {
         E_Exehist_Item *ei;
@@ -473,6 +468,7 @@ _e_exehist_limit(void)
              E_Exehist_Item *ei;
 
              ei = eina_list_data_get(_e_exehist->history);
+             _e_exehist_index_item_del(ei);
              eina_stringshare_del(ei->exe);
              eina_stringshare_del(ei->normalized_exe);
              eina_stringshare_del(ei->launch_method);
@@ -484,6 +480,7 @@ _e_exehist_limit(void)
              E_Exehist_Item *ei;
 
              ei = eina_list_data_get(_e_exehist->mimes);
+             _e_exehist_mime_item_del(ei);
              eina_stringshare_del(ei->exe);
              eina_stringshare_del(ei->launch_method);
              free(ei);
@@ -540,15 +537,14 @@ _e_exehist_normalize_exe(const char *exe)
 }
 
 static void
-_e_exehist_cb_unload(void *data EINA_UNUSED)
+_e_exehist_cb_save(void *data EINA_UNUSED)
 {
-   if (_e_exehist_changes)
+   if ((_e_exehist_changes) && (_e_exehist))
      {
         e_config_domain_save("exehist", _e_exehist_config_edd, _e_exehist);
         _e_exehist_changes = 0;
      }
-   _e_exehist_unload();
-   _e_exehist_unload_defer = NULL;
+   _e_exehist_save_defer = NULL;
 }
 
 static int
@@ -565,14 +561,196 @@ _e_exehist_sort_exe_cb(const void *d1, const void *d2)
    return strcmp(ei1->normalized_exe, ei2->normalized_exe);
 }
 
-static int
-_e_exehist_sort_pop_cb(const void *d1, const void *d2)
+static E_Exehist_Mime *
+_e_exehist_mime_get(const char *mime)
 {
-   const E_Exehist_Item *ei1, *ei2;
+   E_Exehist_Mime *em;
+   E_Exehist_Item *ei;
+   Efreet_Desktop *desktop;
+   Eina_List *handlers;
 
-   if (!(ei1 = d1)) return 1;
-   if (!(ei2 = d2)) return -1;
+   if (!mime) return NULL;
+   _e_exehist_load();
+   if (!_e_exehist) return NULL;
+   if (!_e_exehist_mime_desktops)
+     _e_exehist_mime_desktops = eina_hash_string_superfast_new(_e_exehist_mime_free);
+   em = eina_hash_find(_e_exehist_mime_desktops, mime);
+   if (em) return em;
+
+   /* resolve once - mimes nothing handles are remembered too */
+   em = E_NEW(E_Exehist_Mime, 1);
+   if (!em) return NULL;
+   ei = eina_hash_find(_e_exehist_mimes, mime);
+   if ((ei) && (ei->exe))
+     em->preferred = efreet_util_desktop_file_id_find(ei->exe);
+   if (em->preferred)
+     {
+        efreet_desktop_ref(em->preferred);
+        em->desktops = eina_list_append(em->desktops, em->preferred);
+     }
+   handlers = efreet_util_desktop_mime_list(mime);
+   EINA_LIST_FREE(handlers, desktop)
+     {
+        if (desktop == em->preferred) efreet_desktop_free(desktop);
+        else em->desktops = eina_list_append(em->desktops, desktop);
+     }
+   eina_hash_add(_e_exehist_mime_desktops, mime, em);
+   return em;
+}
 
-   return ei2->count - ei1->count;
+static void
+_e_exehist_mime_free(void *data)
+{
+   E_Exehist_Mime *em = data;
+   Efreet_Desktop *desktop;
+
+   if (em->preferred) efreet_desktop_free(em->preferred);
+   EINA_LIST_FREE(em->desktops, desktop)
+     efreet_desktop_free(desktop);
+   free(em);
 }
 
+static void
+_e_exehist_index_free(void *data)
+{
+   E_Exehist_Index *idx = data;
+
+   eina_stringshare_del(idx->normalized_exe);
+   eina_stringshare_del(idx->exe);
+   free(idx);
+}
+
+static void
+_e_exehist_popular_fix(E_Exehist_Index *idx)
+{
+   E_Exehist_Index *o;
+   unsigned int pos = idx->pos;
+
+   /* only one count changes at a time, so a few swaps restore the order */
+   while ((pos > 0) && (_e_exehist_popular[pos - 1]->count < idx->count))
+     {
+        o = _e_exehist_popular[pos - 1];
+        _e_exehist_popular[pos] = o;
+        o->pos = pos;
+        pos--;
+     }
+   while ((pos + 1 < _e_exehist_popular_count) &&
+          (_e_exehist_popular[pos + 1]->count > idx->count))
+     {
+        o = _e_exehist_popular[pos + 1];
+        _e_exehist_popular[pos] = o;
+        o->pos = pos;
+        pos++;
+     }
+   _e_exehist_popular[pos] = idx;
+   idx->pos = pos;
+}
+
+static void
+_e_exehist_index_item_add(E_Exehist_Item *ei)
+{
+   E_Exehist_Index *idx, **popular;
+   unsigned int alloc;
+
+   if (!ei->normalized_exe) return;
+   if (!_e_exehist_index)
+     _e_exehist_index = eina_hash_stringshared_new(_e_exehist_index_free);
+   idx = eina_hash_find(_e_exehist_index, ei->normalized_exe);
+   if (!idx)
+     {
+        if (_e_exehist_popular_count == _e_exehist_popular_alloc)
+          {
+             alloc = _e_exehist_popular_alloc ? _e_exehist_popular_alloc * 2 : 64;
+             popular = realloc(_e_exehist_popular, alloc * sizeof(E_Exehist_Index *));
+             if (!popular) return;
+             _e_exehist_popular = popular;
+             _e_exehist_popular_alloc = alloc;
+          }
+        idx = E_NEW(E_Exehist_Index, 1);
+        if (!idx) return;
+        idx->normalized_exe = eina_stringshare_ref(ei->normalized_exe);
+        idx->pos = _e_exehist_popular_count++;
+        _e_exehist_popular[idx->pos] = idx;
+        eina_hash_direct_add(_e_exehist_index, idx->normalized_exe, idx);
+     }
+   idx->count++;
+   if ((!idx->exe) || (ei->exetime >= idx->exetime))
+     {
+        idx->exetime = ei->exetime;
+        eina_stringshare_replace(&idx->exe, ei->exe);
+     }
+   _e_exehist_popular_fix(idx);
+}
+
+static void
+_e_exehist_index_item_del(E_Exehist_Item *ei)
+{
+   E_Exehist_Index *idx;
+   unsigned int i;
+
+   if (!ei->normalized_exe) return;
+   idx = eina_hash_find(_e_exehist_index, ei->normalized_exe);
+   if (!idx) return;
+   if (--idx->count)
+     {
+        _e_exehist_popular_fix(idx);
+        return;
+     }
+   _e_exehist_popular_count--;
+   for (i = idx->pos; i < _e_exehist_popular_count; i++)
+     {
+        _e_exehist_popular[i] = _e_exehist_popular[i + 1];
+        _e_exehist_popular[i]->pos = i;
+     }
+   eina_hash_del_by_key(_e_exehist_index, idx->normalized_exe);
+}
+
+static void
+_e_exehist_index_flush(void)
+{
+   E_FREE_FUNC(_e_exehist_index, eina_hash_free);
+   E_FREE_FUNC(_e_exehist_mimes, eina_hash_free);
+   E_FREE_FUNC(_e_exehist_mime_desktops, eina_hash_free);
+   E_FREE(_e_exehist_popular);
+   _e_exehist_popular_count = 0;
+   _e_exehist_popular_alloc = 0;
+}
+
+static void
+_e_exehist_index_rebuild(void)
+{
+   E_Exehist_Item *ei;
+   Eina_List *l;
+
+   _e_exehist_index_flush();
+   if (!_e_exehist) return;
+   EINA_LIST_FOREACH(_e_exehist->history, l, ei)
+     _e_exehist_index_item_add(ei);
+   _e_exehist_mimes = eina_hash_string_superfast_new(NULL);
+   /* mime_desktop_add keeps one entry per mime; should a file carry
+    * more, the newest one wins */
+   EINA_LIST_REVERSE_FOREACH(_e_exehist->mimes, l, ei)
+     {
+        if (!ei->launch_method) continue;
+        if (eina_hash_find(_e_exehist_mimes, ei->launch_method)) continue;
+        eina_hash_add(_e_exehist_mimes, ei->launch_method, ei);
+     }
+}
+
+static void
+_e_exehist_mime_item_del(E_Exehist_Item *ei)
+{
+   if (!ei->launch_method) return;
+   if (eina_hash_find(_e_exehist_mimes, ei->launch_method) == ei)
+     eina_hash_del_by_key(_e_exehist_mimes, ei->launch_method);
+   if (_e_exehist_mime_desktops)
+     eina_hash_del_by_key(_e_exehist_mime_desktops, ei->launch_method);
+}
+
+static Eina_Bool
+_e_exehist_cb_efreet_cache_update(void *data EINA_UNUSED, int ev_type EINA_UNUSED, void *ev EINA_UNUSED)
+{
+   /* desktop files may have come or gone - resolve again on demand */
+   E_FREE_FUNC(_e_exehist_mime_desktops, eina_hash_free);
+   return ECORE_CALLBACK_PASS_ON;
+}
@@ -25,6 +25,7 @@ E_API Eina_List *e_exehist_list_get(void);
 E_API Eina_List *e_exehist_sorted_list_get(E_Exehist_Sort sort_type, int max);
 E_API void e_exehist_mime_desktop_add(const char *mime, Efreet_Desktop *desktop);
 E_API Efreet_Desktop *e_exehist_mime_desktop_get(const char *mime);
+E_API Eina_List *e_exehist_mime_desktops_get(const char *mime);
 
 extern E_API int E_EVENT_EXEHIST_UPDATE;
 
@@ -831,6 +831,7 @@ e_fm2_init(void)
    e_fm2_custom_file_init();
    e_fm2_op_registry_init();
    efreet_mime_init();
+   e_fm_mime_init();
 
    /* XXX: move this to a central/global place? */
    _e_fm2_mime_flush = ecore_timer_loop_add(60.0, _e_fm2_mime_flush_cb, NULL);
@@ -893,6 +894,7 @@ e_fm2_shutdown(void)
    e_fm2_custom_file_shutdown();
    _e_storage_volume_edd_shutdown();
    e_fm2_op_registry_shutdown();
+   e_fm_mime_shutdown();
    efreet_mime_shutdown();
    ecore_shutdown();
    eina_shutdown();
@@ -15,14 +15,160 @@ static Eina_Bool _e_fm_mime_icon_foreach(const Eina_Hash *hash EINA_UNUSED, cons
 static Eina_Hash *icon_map = NULL;
 static Eina_Hash *_mime_handlers = NULL;
 static Eina_Hash *_glob_handlers = NULL;
+static Eina_List *_mime_icon_handlers = NULL;
+static Eina_Bool icon_map_dirty = EINA_FALSE;
+
+#define MIME_ICON_CACHE_VERSION 1
 
-/* externally accessible functions */
 E_API const char *
 e_fm_mime_filename_get(const char *fname)
 {
    return efreet_mime_globs_type_get(fname);
 }
 
+/* everything the icon lookup below depends on besides the mime string:
+ * if any of it changes the on-disk cache is stale */
+static void
+_e_fm_mime_icon_cache_stamp(char *buf, size_t size)
+{
+   const char *theme;
+   char path[PATH_MAX], path2[PATH_MAX];
+   Eina_Strbuf *sb;
+   Eina_List *l;
+   E_Config_Mime_Icon *mi;
+   int cfg = 0;
+
+   sb = eina_strbuf_new();
+   EINA_LIST_FOREACH(e_config->mime_icons, l, mi)
+     eina_strbuf_append_printf(sb, "%s=%s\n", mi->mime, mi->icon);
+   if (eina_strbuf_length_get(sb))
+     cfg = eina_hash_superfast(eina_strbuf_string_get(sb),
+                               eina_strbuf_length_get(sb));
+   eina_strbuf_free(sb);
+
+   theme = e_theme_edje_file_get("base/theme/fileman", "e/icons/fileman/mime/");
+   e_user_dir_concat_static(path, "icons");
+   e_prefix_data_concat_static(path2, "data/icons");
+   snprintf(buf, size, "%i|%s|%lli|%lli|%lli|%i", MIME_ICON_CACHE_VERSION,
+            theme ? theme : "", theme ? (long long)ecore_file_mod_time(theme) : 0,
+            (long long)ecore_file_mod_time(path),
+            (long long)ecore_file_mod_time(path2), cfg);
+}
+
+static void
+_e_fm_mime_icon_cache_path(char *buf, size_t size)
+{
+   e_user_dir_snprintf(buf, size, "fileman/mime_icons.eet");
+}
+
+static void
+_e_fm_mime_icon_cache_load(void)
+{
+   char path[PATH_MAX], stamp[PATH_MAX + 128];
+   const char *p, *end, *icon;
+   Eet_File *ef;
+   char *str;
+   int size = 0;
+
+   _e_fm_mime_icon_cache_path(path, sizeof(path));
+   ef = eet_open(path, EET_FILE_MODE_READ);
+   if (!ef) return;
+   _e_fm_mime_icon_cache_stamp(stamp, sizeof(stamp));
+   str = eet_read(ef, "stamp", &size);
+   if ((!str) || (size != (int)strlen(stamp) + 1) || (strcmp(str, stamp)))
+     {
+        free(str);
+        eet_close(ef);
+        return;
+     }
+   free(str);
+   /* "mime\0icon\0mime\0icon\0...", an empty icon is a cached miss */
+   str = eet_read(ef, "map", &size);
+   eet_close(ef);
+   if (!str) return;
+   if ((size < 1) || (str[size - 1]))
+     {
+        free(str);
+        return;
+     }
+   if (!icon_map) icon_map = eina_hash_string_superfast_new(NULL);
+   end = str + size;
+   for (p = str; p < end; p = icon + strlen(icon) + 1)
+     {
+        icon = p + strlen(p) + 1;
+        if (icon >= end) break;
+        if (!eina_hash_find(icon_map, p))
+          eina_hash_add(icon_map, p, eina_stringshare_add(icon));
+     }
+   free(str);
+}
+
+static Eina_Bool
+_e_fm_mime_icon_cache_save_foreach(const Eina_Hash *hash EINA_UNUSED, const void *key, void *data, void *fdata)
+{
+   Eina_Binbuf *bb = fdata;
+
+   eina_binbuf_append_length(bb, key, strlen(key) + 1);
+   eina_binbuf_append_length(bb, data, strlen(data) + 1);
+   return 1;
+}
+
+static void
+_e_fm_mime_icon_cache_save(void)
+{
+   char path[PATH_MAX], tmp[PATH_MAX], stamp[PATH_MAX + 128];
+   Eina_Binbuf *bb;
+   Eet_File *ef;
+   Eina_Bool ok;
+
+   if ((!icon_map_dirty) || (!icon_map)) return;
+   _e_fm_mime_icon_cache_path(path, sizeof(path));
+   snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+   ef = eet_open(tmp, EET_FILE_MODE_WRITE);
+   if (!ef) return;
+   _e_fm_mime_icon_cache_stamp(stamp, sizeof(stamp));
+   bb = eina_binbuf_new();
+   eina_hash_foreach(icon_map, _e_fm_mime_icon_cache_save_foreach, bb);
+   ok = eet_write(ef, "stamp", stamp, strlen(stamp) + 1, 0) > 0;
+   ok &= eet_write(ef, "map", eina_binbuf_string_get(bb),
+                   eina_binbuf_length_get(bb), 1) > 0;
+   eina_binbuf_free(bb);
+   if ((eet_close(ef) == EET_ERROR_NONE) && (ok))
+     {
+        if (!rename(tmp, path)) icon_map_dirty = EINA_FALSE;
+     }
+   else
+     ecore_file_unlink(tmp);
+}
+
+static Eina_Bool
+_e_fm_mime_cb_icon_theme(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   e_fm_mime_icon_cache_flush();
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+/* externally accessible functions */
+EINTERN int
+e_fm_mime_init(void)
+{
+   _e_fm_mime_icon_cache_load();
+   E_LIST_HANDLER_APPEND(_mime_icon_handlers, E_EVENT_CONFIG_ICON_THEME,
+                         _e_fm_mime_cb_icon_theme, NULL);
+   E_LIST_HANDLER_APPEND(_mime_icon_handlers, EFREET_EVENT_ICON_CACHE_UPDATE,
+                         _e_fm_mime_cb_icon_theme, NULL);
+   return 1;
+}
+
+EINTERN int
+e_fm_mime_shutdown(void)
+{
+   E_FREE_LIST(_mime_icon_handlers, ecore_event_handler_del);
+   _e_fm_mime_icon_cache_save();
+   e_fm_mime_icon_cache_flush();
+   return 1;
+}
+
 /* returns:
  * NULL == don't know
  * "THUMB" == generate a thumb
@@ -41,9 +187,9 @@ e_fm_mime_icon_get(const char *mime)
    /* 0.0 clean out hash cache once it has more than 512 entries in it */
    if (eina_hash_population(icon_map) > 512) e_fm_mime_icon_cache_flush();
 
-   /* 0. look in mapping cache */
+   /* 0. look in mapping cache, an empty string is a cached miss */
    val = eina_hash_find(icon_map, mime);
-   if (val) return val;
+   if (val) return val[0] ? val : NULL;
 
    eina_strlcpy(buf2, mime, sizeof(buf2));
    val = strchr(buf2, '/');
@@ -108,7 +254,7 @@ try_theme:
 try_efreet_icon_generic:
    len = e_prefix_data_snprintf(buf, sizeof(buf), "data/icons/%s.edj", buf2);
    if (len >= sizeof(buf))
-     goto try_efreet_icon_generic;
+     goto miss;
 
    if (ecore_file_exists(buf)) goto ok;
    memcpy(buf + len - (sizeof("edj") - 1), "svg", sizeof("svg"));
@@ -116,13 +262,16 @@ try_efreet_icon_generic:
    memcpy(buf + len - (sizeof("edj") - 1), "png", sizeof("png"));
    if (ecore_file_exists(buf)) goto ok;
 
-   return NULL;
+miss:
+   /* remember misses too so unknown types don't redo all the above */
+   buf[0] = 0;
 
 ok:
    val = (char *)eina_stringshare_add(buf);
    if (!icon_map) icon_map = eina_hash_string_superfast_new(NULL);
    eina_hash_add(icon_map, mime, val);
-   return val;
+   icon_map_dirty = EINA_TRUE;
+   return val[0] ? val : NULL;
 }
 
 E_API void
@@ -134,6 +283,7 @@ e_fm_mime_icon_cache_flush(void)
    E_FREE_LIST(freelist, eina_stringshare_del);
    eina_hash_free(icon_map);
    icon_map = NULL;
+   icon_map_dirty = EINA_FALSE;
 }
 
 /* create (allocate), set properties, and return a new mime handler */
@@ -15,6 +15,8 @@ struct _E_Fm2_Mime_Handler
    void *test_data;
 };
 
+EINTERN int e_fm_mime_init(void);
+EINTERN int e_fm_mime_shutdown(void);
 E_API const char *e_fm_mime_filename_get(const char *fname);
 E_API const char *e_fm_mime_icon_get(const char *mime);
 E_API void e_fm_mime_icon_cache_flush(void);
@@ -4,18 +4,29 @@
 #define API_ENTRY      E_Smart_Data * sd; sd = evas_object_smart_data_get(obj); if ((!obj) || (!sd) || (evas_object_type_get(obj) && strcmp(evas_object_type_get(obj), SMART_NAME)))
 #define INTERNAL_ENTRY E_Smart_Data * sd; sd = evas_object_smart_data_get(obj); if (!sd) return;
 
+/* row objects are recycled per theme group: header/item x even/odd */
+#define ROW_KIND(header, odd) ((!!(header) << 1) | !!(odd))
+
 typedef struct _E_Smart_Data E_Smart_Data;
 struct _E_Smart_Data
 {
    Evas_Coord    x, y, w, h, iw, ih;
-   Evas_Object  *o_smart, *o_edje, *o_box;
-   Eina_List    *items;
+   Evas_Coord    mw, mh;
+   Evas_Object  *o_smart, *o_edje, *o_clip, *o_hidden;
+   E_Ilist_Item **items;
+   unsigned int  count, alloc;
+   /* rows in [vis_start, vis_end) have objects */
+   unsigned int  vis_start, vis_end;
+   Eina_List    *items_list;
+   Eina_List    *pool[4];
    Eina_List    *selected_items;
    int           selected;
    const char   *theme;
    unsigned char selector E_BITFIELD;
    unsigned char multi_select E_BITFIELD;
    unsigned char on_hold E_BITFIELD;
+   unsigned char layout_dirty E_BITFIELD;
+   unsigned char items_list_dirty E_BITFIELD;
 
    struct
    {
@@ -36,6 +47,7 @@ static void          _e_smart_resize(Evas_Object *obj, Evas_Coord w, Evas_Coord
 static void          _e_smart_color_set(Evas_Object *obj, int r, int g, int b, int a);
 static void          _e_smart_clip_set(Evas_Object *obj, Evas_Object *clip);
 static void          _e_smart_clip_unset(Evas_Object *obj);
+static void          _e_smart_calculate(Evas_Object *obj);
 static void          _e_smart_reconfigure(E_Smart_Data *sd);
 static void          _e_smart_event_mouse_down(void *data, Evas *evas, Evas_Object *obj, void *event_info);
 static void          _e_smart_event_mouse_up(void *data, Evas *evas, Evas_Object *obj, void *event_info);
@@ -49,7 +61,15 @@ static void          _e_typebuf_timer_delete(Evas_Object *obj);
 static void          _e_typebuf_clean(Evas_Object *obj);
 
 static E_Ilist_Item *_e_ilist_item_new(E_Smart_Data *sd, Evas_Object *icon, Evas_Object *end, const char *label, int header, Ecore_End_Cb func, Ecore_End_Cb func_hilight, void *data, void *data2);
-static void          _e_ilist_item_theme_set(E_Ilist_Item *si, Eina_Bool custom, Eina_Bool header, Eina_Bool even);
+static void          _e_ilist_item_free(E_Ilist_Item *si);
+static Eina_Bool     _e_ilist_item_insert(E_Smart_Data *sd, E_Ilist_Item *si, unsigned int pos);
+static void          _e_ilist_item_measure(E_Ilist_Item *si);
+static void          _e_ilist_item_realize(E_Ilist_Item *si);
+static void          _e_ilist_item_unrealize(E_Ilist_Item *si);
+static void          _e_ilist_unrealize_all(E_Smart_Data *sd);
+static void          _e_ilist_pool_flush(E_Smart_Data *sd);
+static void          _e_ilist_layout(E_Smart_Data *sd);
+static void          _e_ilist_item_theme_set(E_Smart_Data *sd, Evas_Object *o, Eina_Bool custom, Eina_Bool header, Eina_Bool even);
 static void          _e_ilist_widget_hack_cb(E_Smart_Data *sd, Evas_Object *obj EINA_UNUSED, Evas_Object *scr);
 
 static void          _item_select(E_Ilist_Item *si);
@@ -68,125 +88,76 @@ E_API void
 e_ilist_append(Evas_Object *obj, Evas_Object *icon, Evas_Object *end, const char *label, int header, void (*func)(void *data, void *data2), void (*func_hilight)(void *data, void *data2), void *data, void *data2)
 {
    E_Ilist_Item *si;
-   Evas_Coord mw = 0, mh = 0;
-   const char *stacking;
 
    API_ENTRY return;
    si = _e_ilist_item_new(sd, icon, end, label, header, func, func_hilight, data, data2);
-   sd->items = eina_list_append(sd->items, si);
-
-   edje_object_size_min_calc(si->o_base, &mw, &mh);
-   evas_object_size_hint_min_set(si->o_base, mw, mh);
-   elm_box_pack_end(sd->o_box, si->o_base);
-   stacking = edje_object_data_get(si->o_base, "stacking");
-   if (stacking)
-     {
-        if (!strcmp(stacking, "below")) evas_object_lower(si->o_base);
-        else if (!strcmp(stacking, "above"))
-          evas_object_raise(si->o_base);
-     }
-
-   evas_object_lower(sd->o_box);
-
-   evas_object_show(si->o_base);
+   if (!si) return;
+   if (!_e_ilist_item_insert(sd, si, sd->count))
+     _e_ilist_item_free(si);
 }
 
 E_API void
 e_ilist_append_relative(Evas_Object *obj, Evas_Object *icon, Evas_Object *end, const char *label, int header, void (*func)(void *data, void *data2), void (*func_hilight)(void *data, void *data2), void *data, void *data2, int relative)
 {
-   E_Ilist_Item *si, *ri;
-   Evas_Coord mw = 0, mh = 0;
-   const char *stacking;
+   E_Ilist_Item *si;
+   unsigned int pos;
 
    API_ENTRY return;
    si = _e_ilist_item_new(sd, icon, end, label, header, func, func_hilight, data, data2);
-
-   ri = eina_list_nth(sd->items, relative);
-   if (ri)
-     sd->items = eina_list_append_relative(sd->items, si, ri);
-   else
-     sd->items = eina_list_append(sd->items, si);
-
-   edje_object_size_min_calc(si->o_base, &mw, &mh);
-   evas_object_size_hint_min_set(si->o_base, mw, mh);
-   if (ri)
-     elm_box_pack_after(sd->o_box, si->o_base, ri->o_base);
-   else
-     elm_box_pack_end(sd->o_box, si->o_base);
-   stacking = edje_object_data_get(si->o_base, "stacking");
-   if (stacking)
-     {
-        if (!strcmp(stacking, "below")) evas_object_lower(si->o_base);
-        else if (!strcmp(stacking, "above"))
-          evas_object_raise(si->o_base);
-     }
-
-   evas_object_lower(sd->o_box);
-   evas_object_show(si->o_base);
+   if (!si) return;
+   pos = sd->count;
+   if ((relative >= 0) && ((unsigned int)relative < sd->count))
+     pos = relative + 1;
+   if (!_e_ilist_item_insert(sd, si, pos))
+     _e_ilist_item_free(si);
 }
 
 E_API void
 e_ilist_prepend(Evas_Object *obj, Evas_Object *icon, Evas_Object *end, const char *label, int header, void (*func)(void *data, void *data2), void (*func_hilight)(void *data, void *data2), void *data, void *data2)
 {
    E_Ilist_Item *si;
-   Evas_Coord mw = 0, mh = 0;
 
    API_ENTRY return;
    si = _e_ilist_item_new(sd, icon, end, label, header, func, func_hilight, data, data2);
-   sd->items = eina_list_prepend(sd->items, si);
-
-   edje_object_size_min_calc(si->o_base, &mw, &mh);
-   evas_object_size_hint_min_set(si->o_base, mw, mh);
-   elm_box_pack_start(sd->o_box, si->o_base);
-
-   evas_object_lower(sd->o_box);
-   evas_object_show(si->o_base);
+   if (!si) return;
+   if (!_e_ilist_item_insert(sd, si, 0))
+     _e_ilist_item_free(si);
 }
 
 E_API void
 e_ilist_prepend_relative(Evas_Object *obj, Evas_Object *icon, Evas_Object *end, const char *label, int header, void (*func)(void *data, void *data2), void (*func_hilight)(void *data, void *data2), void *data, void *data2, int relative)
 {
-   E_Ilist_Item *si, *ri;
-   Evas_Coord mw = 0, mh = 0;
+   E_Ilist_Item *si;
+   unsigned int pos;
 
    API_ENTRY return;
    si = _e_ilist_item_new(sd, icon, end, label, header, func, func_hilight, data, data2);
-
-   ri = eina_list_nth(sd->items, relative);
-   if (ri)
-     sd->items = eina_list_prepend_relative(sd->items, si, ri);
-   else
-     sd->items = eina_list_prepend(sd->items, si);
-
-   edje_object_size_min_calc(si->o_base, &mw, &mh);
-   evas_object_size_hint_min_set(si->o_base, mw, mh);
-   if (ri)
-     elm_box_pack_before(sd->o_box, si->o_base, ri->o_base);
-   else
-     elm_box_pack_end(sd->o_box, si->o_base);
-
-   evas_object_lower(sd->o_box);
-   evas_object_show(si->o_base);
+   if (!si) return;
+   pos = sd->count;
+   if ((relative >= 0) && ((unsigned int)relative < sd->count))
+     pos = relative;
+   if (!_e_ilist_item_insert(sd, si, pos))
+     _e_ilist_item_free(si);
 }
 
 E_API void
 e_ilist_clear(Evas_Object *obj)
 {
-   E_Ilist_Item *si = NULL;
+   unsigned int i;
 
    API_ENTRY return;
 
    e_ilist_freeze(obj);
-   EINA_LIST_FREE(sd->items, si)
-     {
-        if (!si) continue;
-        if (si->o_icon) evas_object_del(si->o_icon);
-        if (si->o_end) evas_object_del(si->o_end);
-        if (si->label) eina_stringshare_del(si->label);
-        evas_object_del(si->o_base);
-        E_FREE(si);
-     }
+   _e_ilist_unrealize_all(sd);
+   for (i = 0; i < sd->count; i++)
+     _e_ilist_item_free(sd->items[i]);
+   E_FREE(sd->items);
+   sd->count = sd->alloc = 0;
+   sd->items_list = eina_list_free(sd->items_list);
+   sd->items_list_dirty = 0;
    if (sd->selected_items) sd->selected_items = eina_list_free(sd->selected_items);
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
    e_ilist_thaw(obj);
    sd->selected = -1;
 }
@@ -207,7 +178,7 @@ E_API int
 e_ilist_count(Evas_Object *obj)
 {
    API_ENTRY return 0;
-   return eina_list_count(sd->items);
+   return sd->count;
 }
 
 E_API int
@@ -242,8 +213,9 @@ E_API void
 e_ilist_size_min_get(Evas_Object *obj, Evas_Coord *w, Evas_Coord *h)
 {
    API_ENTRY return;
-   elm_box_recalculate(sd->o_box);
-   evas_object_size_hint_min_get(sd->o_box, w, h);
+   _e_ilist_layout(sd);
+   if (w) *w = sd->mw;
+   if (h) *h = sd->mh;
 }
 
 E_API void
@@ -251,7 +223,7 @@ e_ilist_unselect(Evas_Object *obj)
 {
    API_ENTRY return;
 
-   if (!sd->items) return;
+   if (!sd->count) return;
    if (sd->selected < 0) return;
    while (sd->selected_items)
      _item_unselect(sd->selected_items->data);
@@ -265,21 +237,21 @@ e_ilist_selected_set(Evas_Object *obj, int n)
    int i;
 
    API_ENTRY return;
-   if (!sd->items) return;
+   if (!sd->count) return;
 
-   i = eina_list_count(sd->items);
+   i = sd->count;
    if (n >= i) n = i - 1;
    else if (n < 0)
      n = 0;
 
    e_ilist_unselect(obj);
-   if (!(si = eina_list_nth(sd->items, n))) return;
+   si = sd->items[n];
 
    /* NB: Remove this if headers ever become selectable */
    while (si->header && ((++n) < i))
-     if (!(si = eina_list_nth(sd->items, n))) return;
+     si = sd->items[n];
    while (si->header && ((--n) >= 0))
-     if (!(si = eina_list_nth(sd->items, n))) return;
+     si = sd->items[n];
    if (si->header) return;
 
    _item_select(si);
@@ -304,43 +276,35 @@ e_ilist_selected_get(Evas_Object *obj)
 {
    Eina_List *l = NULL;
    E_Ilist_Item *li = NULL;
-   int i, j;
+   int j;
 
    API_ENTRY return -1;
-   if (!sd->items) return -1;
+   if (!sd->count) return -1;
    if (!sd->multi_select)
      return sd->selected;
    j = -1;
-   i = 0;
    /* Return the index the of last selected item */
-   EINA_LIST_FOREACH(sd->items, l, li)
-     {
-        if (li && li->selected) j = i;
-        i++;
-     }
+   EINA_LIST_FOREACH(sd->selected_items, l, li)
+     if (li->idx > j) j = li->idx;
    return j;
 }
 
+static E_Ilist_Item *
+_e_ilist_nth(E_Smart_Data *sd, int n)
+{
+   if ((n < 0) || ((unsigned int)n >= sd->count)) return NULL;
+   return sd->items[n];
+}
+
 E_API const char *
 e_ilist_selected_label_get(Evas_Object *obj)
 {
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
    if (sd->multi_select) return NULL;
-   if (sd->selected < 0) return NULL;
-   si = eina_list_nth(sd->items, sd->selected);
-   if (si)
-     {
-        if (!si->label)
-          {
-             si->label =
-               eina_stringshare_add(edje_object_part_text_get(si->o_base,
-                                                              "e.text.label"));
-          }
-        if (si->label) return si->label;
-     }
+   si = _e_ilist_nth(sd, sd->selected);
+   if (si) return si->label;
    return NULL;
 }
 
@@ -350,10 +314,8 @@ e_ilist_selected_data_get(Evas_Object *obj)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
    if (sd->multi_select) return NULL;
-   if (sd->selected < 0) return NULL;
-   si = eina_list_nth(sd->items, sd->selected);
+   si = _e_ilist_nth(sd, sd->selected);
    if (si) return si->data;
    return NULL;
 }
@@ -364,10 +326,8 @@ e_ilist_selected_data2_get(Evas_Object *obj)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
    if (sd->multi_select) return NULL;
-   if (sd->selected < 0) return NULL;
-   si = eina_list_nth(sd->items, sd->selected);
+   si = _e_ilist_nth(sd, sd->selected);
    if (si) return si->data2;
    return NULL;
 }
@@ -378,10 +338,8 @@ e_ilist_selected_icon_get(Evas_Object *obj)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
    if (sd->multi_select) return NULL;
-   if (sd->selected < 0) return NULL;
-   si = eina_list_nth(sd->items, sd->selected);
+   si = _e_ilist_nth(sd, sd->selected);
    if (si) return si->o_icon;
    return NULL;
 }
@@ -392,10 +350,8 @@ e_ilist_selected_end_get(Evas_Object *obj)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
    if (sd->multi_select) return NULL;
-   if (sd->selected < 0) return NULL;
-   si = eina_list_nth(sd->items, sd->selected);
+   si = _e_ilist_nth(sd, sd->selected);
    if (si) return si->o_end;
    return NULL;
 }
@@ -403,22 +359,15 @@ e_ilist_selected_end_get(Evas_Object *obj)
 E_API void
 e_ilist_selected_geometry_get(Evas_Object *obj, Evas_Coord *x, Evas_Coord *y, Evas_Coord *w, Evas_Coord *h)
 {
-   E_Ilist_Item *si = NULL;
-
    API_ENTRY return;
-   if (!sd->items) return;
-   if (sd->selected < 0) return;
-   if (!(si = eina_list_nth(sd->items, sd->selected))) return;
-   evas_object_geometry_get(si->o_base, x, y, w, h);
-   *x -= sd->x;
-   *y -= sd->y;
+   e_ilist_nth_geometry_get(obj, sd->selected, x, y, w, h);
 }
 
 E_API int
 e_ilist_selected_count_get(Evas_Object *obj)
 {
    API_ENTRY return 0;
-   if (!sd->items) return 0;
+   if (!sd->count) return 0;
    return eina_list_count(sd->selected_items);
 }
 
@@ -426,39 +375,34 @@ E_API void
 e_ilist_remove_num(Evas_Object *obj, int n)
 {
    E_Ilist_Item *si = NULL;
-   Eina_List *item;
-   int w, h;
-   Eina_Bool resize = EINA_FALSE;
+   unsigned int i;
+   int h;
 
    API_ENTRY return;
-   if (!sd->items) return;
-   item = eina_list_nth_list(sd->items, n);
-   if (!item) return;
-   si = eina_list_data_get(item);
-   if (!si) return;
-   sd->items = eina_list_remove_list(sd->items, item);
+   if (!(si = _e_ilist_nth(sd, n))) return;
+   /* every row after this one moves up and changes parity */
+   _e_ilist_unrealize_all(sd);
+   sd->count--;
+   memmove(&sd->items[n], &sd->items[n + 1],
+           (sd->count - n) * sizeof(E_Ilist_Item *));
+   for (i = n; i < sd->count; i++)
+     sd->items[i]->idx = i;
    if (si->selected) sd->selected_items = eina_list_remove(sd->selected_items, si);
+   sd->items_list_dirty = 1;
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
 
-   evas_object_geometry_get(sd->o_box, NULL, NULL, &w, &h);
-   if ((sd->w == w) && (sd->h == h))
-     {
-        resize = EINA_TRUE;
-        evas_object_geometry_get(si->o_base, NULL, NULL, &w, &h);
-     }
-
+   h = si->mh;
    if (sd->selected == n) sd->selected = -1;
-   if (si->o_icon) evas_object_del(si->o_icon);
-   if (si->o_end) evas_object_del(si->o_end);
-   if (si->label) eina_stringshare_del(si->label);
-   evas_object_del(si->o_base);
-   E_FREE(si);
+   else if (sd->selected > n)
+     sd->selected--;
+   _e_ilist_item_free(si);
 
    /* if ilist size is size of box (e_widget_ilist),
     * autoresize here to prevent skewed perspective as in ticket #1678
     */
-   if (!resize) return;
-   if (!sd->items) return;
-   evas_object_resize(sd->o_smart, w, sd->h - h);
+   if (!sd->count) return;
+   evas_object_resize(sd->o_smart, sd->w, sd->h - h);
 }
 
 E_API const char *
@@ -467,27 +411,24 @@ e_ilist_nth_label_get(Evas_Object *obj, int n)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
-   si = eina_list_nth(sd->items, n);
-   if (si)
-     {
-        if (!si->label)
-          {
-             si->label =
-               eina_stringshare_add(edje_object_part_text_get(si->o_base,
-                                                              "e.text.label"));
-          }
-        if (si->label) return si->label;
-     }
+   si = _e_ilist_nth(sd, n);
+   if (si) return si->label;
    return NULL;
 }
 
 E_API void
 e_ilist_item_label_set(E_Ilist_Item *si, const char *label)
 {
+   E_Smart_Data *sd;
+
    EINA_SAFETY_ON_NULL_RETURN(si);
+   sd = si->sd;
    eina_stringshare_replace(&si->label, label);
-   edje_object_part_text_set(si->o_base, "e.text.label", label);
+   if (si->o_base)
+     edje_object_part_text_set(si->o_base, "e.text.label", label);
+   _e_ilist_item_measure(si);
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
 }
 
 E_API void
@@ -499,8 +440,7 @@ e_ilist_nth_label_set(Evas_Object *obj, int n, const char *label)
     * API_ENTRY check first */
    if (!label) return;
    API_ENTRY return;
-   if (!sd->items) return;
-   si = eina_list_nth(sd->items, n);
+   si = _e_ilist_nth(sd, n);
    if (si) e_ilist_item_label_set(si, label);
 }
 
@@ -510,8 +450,7 @@ e_ilist_nth_icon_get(Evas_Object *obj, int n)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
-   si = eina_list_nth(sd->items, n);
+   si = _e_ilist_nth(sd, n);
    if (si) return si->o_icon;
    return NULL;
 }
@@ -522,22 +461,27 @@ e_ilist_nth_icon_set(Evas_Object *obj, int n, Evas_Object *icon)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return;
-   if (!sd->items) return;
-   if (!(si = eina_list_nth(sd->items, n))) return;
+   if (!(si = _e_ilist_nth(sd, n))) return;
    if (si->o_icon)
      {
-        edje_object_part_unswallow(si->o_base, si->o_icon);
+        if (si->o_base) edje_object_part_unswallow(si->o_base, si->o_icon);
         evas_object_del(si->o_icon);
      }
    si->o_icon = icon;
-   E_WEIGHT(si->o_icon, 1, 0);
-   E_FILL(si->o_icon);
    if (si->o_icon)
      {
+        E_WEIGHT(si->o_icon, 1, 0);
+        E_FILL(si->o_icon);
         evas_object_size_hint_min_set(si->o_icon, sd->iw, sd->ih);
-        edje_object_part_swallow(si->o_base, "e.swallow.icon", si->o_icon);
+        if (si->o_base)
+          edje_object_part_swallow(si->o_base, "e.swallow.icon", si->o_icon);
+        else
+          evas_object_clip_set(si->o_icon, sd->o_hidden);
         evas_object_show(si->o_icon);
      }
+   _e_ilist_item_measure(si);
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
 }
 
 E_API Evas_Object *
@@ -546,8 +490,7 @@ e_ilist_nth_end_get(Evas_Object *obj, int n)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return NULL;
-   if (!sd->items) return NULL;
-   si = eina_list_nth(sd->items, n);
+   si = _e_ilist_nth(sd, n);
    if (si) return si->o_end;
    return NULL;
 }
@@ -558,20 +501,25 @@ e_ilist_nth_end_set(Evas_Object *obj, int n, Evas_Object *end)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return;
-   if (!sd->items) return;
-   if (!(si = eina_list_nth(sd->items, n))) return;
+   if (!(si = _e_ilist_nth(sd, n))) return;
    if (si->o_end)
      {
-        edje_object_part_unswallow(si->o_base, si->o_end);
+        if (si->o_base) edje_object_part_unswallow(si->o_base, si->o_end);
         evas_object_del(si->o_end);
      }
    si->o_end = end;
    if (si->o_end)
      {
         evas_object_size_hint_min_set(si->o_end, sd->iw, sd->ih);
-        edje_object_part_swallow(si->o_base, "e.swallow.end", si->o_end);
+        if (si->o_base)
+          edje_object_part_swallow(si->o_base, "e.swallow.end", si->o_end);
+        else
+          evas_object_clip_set(si->o_end, sd->o_hidden);
         evas_object_show(si->o_end);
      }
+   _e_ilist_item_measure(si);
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
 }
 
 E_API Eina_Bool
@@ -580,8 +528,7 @@ e_ilist_nth_is_header(Evas_Object *obj, int n)
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return 0;
-   if (!sd->items) return 0;
-   si = eina_list_nth(sd->items, n);
+   si = _e_ilist_nth(sd, n);
    if (si) return si->header;
    return 0;
 }
@@ -592,31 +539,31 @@ e_ilist_nth_geometry_get(Evas_Object *obj, int n, Evas_Coord *x, Evas_Coord *y,
    E_Ilist_Item *si = NULL;
 
    API_ENTRY return;
-   if (!sd->items) return;
-   if (!(si = eina_list_nth(sd->items, n))) return;
-   evas_object_geometry_get(si->o_base, x, y, w, h);
-   *x -= sd->x;
-   *y -= sd->y;
+   if (!(si = _e_ilist_nth(sd, n))) return;
+   /* rows are laid out from their cached sizes so this works for rows
+    * that have no objects */
+   _e_ilist_layout(sd);
+   if (x) *x = 0;
+   if (y) *y = si->y;
+   if (w) *w = sd->w;
+   if (h) *h = si->mh;
 }
 
 E_API void
 e_ilist_icon_size_set(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
 {
-   Eina_List *l = NULL;
    E_Ilist_Item *si = NULL;
+   unsigned int i;
 
    API_ENTRY return;
    if ((sd->iw == w) && (sd->ih == h)) return;
    sd->iw = w;
    sd->ih = h;
-   EINA_LIST_FOREACH(sd->items, l, si)
+   for (i = 0; i < sd->count; i++)
      {
-        Evas_Coord mw = 0, mh = 0;
-
-        if (!si) continue;
+        si = sd->items[i];
         if (!si->o_icon) continue;
         evas_object_size_hint_min_set(si->o_icon, w, h);
-        edje_object_part_swallow(si->o_base, "e.swallow.icon", si->o_icon);
 
         if (si->o_end)
           {
@@ -631,16 +578,27 @@ e_ilist_icon_size_set(Evas_Object *obj, Evas_Coord w, Evas_Coord h)
              evas_object_size_hint_min_set(si->o_end, ew, eh);
           }
 
-        edje_object_size_min_calc(si->o_base, &mw, &mh);
-        evas_object_size_hint_min_set(si->o_icon, mw, mh);
+        _e_ilist_item_measure(si);
      }
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
 }
 
 E_API const Eina_List *
 e_ilist_items_get(Evas_Object *obj)
 {
+   unsigned int i;
+
    API_ENTRY return NULL;
-   return sd->items;
+   /* the array is the real store - only build a list when asked for one */
+   if (sd->items_list_dirty)
+     {
+        sd->items_list = eina_list_free(sd->items_list);
+        for (i = 0; i < sd->count; i++)
+          sd->items_list = eina_list_append(sd->items_list, sd->items[i]);
+        sd->items_list_dirty = 0;
+     }
+   return sd->items_list;
 }
 
 E_API void
@@ -650,14 +608,14 @@ e_ilist_multi_select(Evas_Object *obj, int n)
    int i;
 
    API_ENTRY return;
-   if ((!sd->items) || (!sd->multi_select)) return;
+   if ((!sd->count) || (!sd->multi_select)) return;
 
-   i = eina_list_count(sd->items);
+   i = sd->count;
    if (n >= i) n = i - 1;
    else if (n < 0)
      n = 0;
 
-   if (!(si = eina_list_nth(sd->items, n))) return;
+   si = sd->items[n];
    if (si->header) return;
    sd->selected = n;
    if (si->selected)
@@ -686,9 +644,9 @@ e_ilist_range_select(Evas_Object *obj, int n)
    int i, j, dir;
 
    API_ENTRY return;
-   if ((!sd->items) || (!sd->multi_select)) return;
+   if ((!sd->count) || (!sd->multi_select)) return;
 
-   i = eina_list_count(sd->items);
+   i = sd->count;
    if (n >= i) n = i - 1;
    else if (n < 0)
      n = 0;
@@ -696,7 +654,6 @@ e_ilist_range_select(Evas_Object *obj, int n)
    if (n < sd->selected) dir = 0;
    else dir = 1;
 
-   if (!eina_list_nth(sd->items, n)) return;
    if (dir == 1)
      {
         for (j = (sd->selected + 1); ((j < i) && (j <= n)); j++)
@@ -712,24 +669,20 @@ e_ilist_range_select(Evas_Object *obj, int n)
 E_API Eina_Bool
 e_ilist_custom_edje_file_set(Evas_Object *obj, const char *file, const char *group)
 {
-   Eina_List *l;
-   E_Ilist_Item *si;
-   Eina_Bool even = EINA_FALSE;
+   unsigned int i;
 
    API_ENTRY return EINA_FALSE;
 
    edje_object_file_set(sd->o_edje, file, group);
    eina_stringshare_replace(&sd->theme, group);
 
-   EINA_LIST_FOREACH(sd->items, l, si)
-     {
-        _e_ilist_item_theme_set(si, !!sd->theme, si->header, even);
-        if (si->o_icon)
-          edje_object_part_swallow(si->o_base, "e.swallow.icon", si->o_icon);
-        if (si->o_end)
-          edje_object_part_swallow(si->o_base, "e.swallow.end", si->o_end);
-        even = !even;
-     }
+   /* recycled rows carry the old theme */
+   _e_ilist_unrealize_all(sd);
+   _e_ilist_pool_flush(sd);
+   for (i = 0; i < sd->count; i++)
+     _e_ilist_item_measure(sd->items[i]);
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
    return EINA_TRUE;
 }
 
@@ -751,6 +704,7 @@ _e_smart_init(void)
            sc.color_set = _e_smart_color_set;
            sc.clip_set = _e_smart_clip_set;
            sc.clip_unset = _e_smart_clip_unset;
+           sc.calculate = _e_smart_calculate;
         }
       _e_smart = evas_smart_class_new(&sc);
    }
@@ -778,10 +732,12 @@ _e_smart_add(Evas_Object *obj)
    sd->typebuf.size = 0;
    sd->typebuf.timer = NULL;
 
-   sd->o_box = elm_box_add(e_win_evas_win_get(e));
-   elm_box_align_set(sd->o_box, 0.0, 0.0);
-   elm_box_homogeneous_set(sd->o_box, 0);
-   evas_object_smart_member_add(sd->o_box, obj);
+   /* clips the visible rows */
+   sd->o_clip = evas_object_rectangle_add(e);
+   evas_object_smart_member_add(sd->o_clip, obj);
+   /* never shown - parks the icons of rows that have no objects */
+   sd->o_hidden = evas_object_rectangle_add(e);
+   evas_object_smart_member_add(sd->o_hidden, obj);
    evas_object_event_callback_add(obj, EVAS_CALLBACK_KEY_DOWN,
                                   _e_smart_event_key_down, sd);
    evas_object_propagate_events_set(obj, 0);
@@ -801,7 +757,9 @@ _e_smart_del(Evas_Object *obj)
    _e_typebuf_clean(obj);
 
    e_ilist_clear(obj);
-   evas_object_del(sd->o_box);
+   _e_ilist_pool_flush(sd);
+   evas_object_del(sd->o_clip);
+   evas_object_del(sd->o_hidden);
    evas_object_del(sd->o_edje);
    eina_stringshare_del(sd->theme);
    free(sd);
@@ -812,7 +770,7 @@ _e_smart_show(Evas_Object *obj)
 {
    INTERNAL_ENTRY;
    evas_object_show(sd->o_edje);
-   evas_object_show(sd->o_box);
+   evas_object_show(sd->o_clip);
 }
 
 static void
@@ -820,7 +778,7 @@ _e_smart_hide(Evas_Object *obj)
 {
    INTERNAL_ENTRY;
    evas_object_hide(sd->o_edje);
-   evas_object_hide(sd->o_box);
+   evas_object_hide(sd->o_clip);
 }
 
 static void
@@ -848,7 +806,7 @@ _e_smart_color_set(Evas_Object *obj, int r, int g, int b, int a)
 {
    INTERNAL_ENTRY;
    evas_object_color_set(sd->o_edje, r, g, b, a);
-   evas_object_color_set(sd->o_box, r, g, b, a);
+   evas_object_color_set(sd->o_clip, r, g, b, a);
 }
 
 static void
@@ -856,7 +814,8 @@ _e_smart_clip_set(Evas_Object *obj, Evas_Object *clip)
 {
    INTERNAL_ENTRY;
    evas_object_clip_set(sd->o_edje, clip);
-   evas_object_clip_set(sd->o_box, clip);
+   evas_object_clip_set(sd->o_clip, clip);
+   evas_object_smart_changed(obj);
 }
 
 static void
@@ -864,7 +823,8 @@ _e_smart_clip_unset(Evas_Object *obj)
 {
    INTERNAL_ENTRY;
    evas_object_clip_unset(sd->o_edje);
-   evas_object_clip_unset(sd->o_box);
+   evas_object_clip_unset(sd->o_clip);
+   evas_object_smart_changed(obj);
 }
 
 static void
@@ -872,20 +832,86 @@ _e_smart_reconfigure(E_Smart_Data *sd)
 {
    evas_object_move(sd->o_edje, sd->x, sd->y);
    evas_object_resize(sd->o_edje, sd->w, sd->h);
-   evas_object_move(sd->o_box, sd->x, sd->y);
-   evas_object_resize(sd->o_box, sd->w, sd->h);
+   evas_object_move(sd->o_clip, sd->x, sd->y);
+   evas_object_resize(sd->o_clip, sd->w, sd->h);
+   /* rows are placed once the new position has settled */
+   evas_object_smart_changed(sd->o_smart);
+}
+
+static unsigned int
+_e_ilist_item_at(E_Smart_Data *sd, Evas_Coord y)
+{
+   unsigned int lo = 0, hi = sd->count, mid;
+
+   /* first row that ends below y */
+   while (lo < hi)
+     {
+        mid = (lo + hi) / 2;
+        if ((sd->items[mid]->y + sd->items[mid]->mh) <= y) lo = mid + 1;
+        else hi = mid;
+     }
+   return lo;
+}
+
+static void
+_e_smart_calculate(Evas_Object *obj)
+{
+   Evas_Coord cx, cy, cw, ch, x, y, w, h, top, bottom;
+   Evas_Object *clip;
+   E_Ilist_Item *si;
+   unsigned int i, start, end;
+
+   INTERNAL_ENTRY;
+   _e_ilist_layout(sd);
+
+   /* only the rows inside the output and our clipper (the scrollframe
+    * viewport) plus half a screen of slack get objects */
+   evas_output_viewport_get(evas_object_evas_get(obj), &cx, &cy, &cw, &ch);
+   clip = evas_object_clip_get(sd->o_clip);
+   if (clip)
+     {
+        evas_object_geometry_get(clip, &x, &y, &w, &h);
+        E_RECTS_CLIP_TO_RECT(cx, cy, cw, ch, x, y, w, h);
+     }
+   top = cy - sd->y - (ch / 2);
+   bottom = cy + ch - sd->y + (ch / 2);
+   if ((!evas_object_visible_get(obj)) || (cw <= 0) || (ch <= 0))
+     start = end = 0;
+   else
+     {
+        start = _e_ilist_item_at(sd, top);
+        end = _e_ilist_item_at(sd, bottom);
+        if (end < sd->count) end++;
+     }
+
+   for (i = sd->vis_start; i < sd->vis_end; i++)
+     {
+        if ((i >= start) && (i < end)) continue;
+        _e_ilist_item_unrealize(sd->items[i]);
+     }
+   sd->vis_start = start;
+   sd->vis_end = end;
+   for (i = start; i < end; i++)
+     {
+        si = sd->items[i];
+        if (!si->o_base) _e_ilist_item_realize(si);
+        if (!si->o_base) continue;
+        evas_object_move(si->o_base, sd->x, sd->y + si->y);
+        evas_object_resize(si->o_base, sd->w, si->mh);
+     }
 }
 
 static void
-_e_smart_event_mouse_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+_e_smart_event_mouse_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, void *event_info)
 {
    E_Smart_Data *sd;
    Evas_Event_Mouse_Down *ev;
    E_Ilist_Item *si;
 
    ev = event_info;
-   si = data;
-   sd = si->sd;
+   sd = data;
+   si = evas_object_data_get(obj, "e_ilist_item");
+   if (!si) return;
 
    if (ev->event_flags & EVAS_EVENT_FLAG_ON_HOLD) sd->on_hold = 1;
    else sd->on_hold = 0;
@@ -898,17 +924,16 @@ _e_smart_event_mouse_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj E
 }
 
 static void
-_e_smart_event_mouse_up(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+_e_smart_event_mouse_up(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, void *event_info)
 {
    E_Smart_Data *sd;
    Evas_Event_Mouse_Up *ev;
-   E_Ilist_Item *si, *item;
-   Eina_List *l = NULL;
-   int i;
+   E_Ilist_Item *si;
 
    ev = event_info;
-   si = data;
-   sd = si->sd;
+   sd = data;
+   si = evas_object_data_get(obj, "e_ilist_item");
+   if (!si) return;
 
    if (ev->event_flags & EVAS_EVENT_FLAG_ON_HOLD) sd->on_hold = 1;
    else sd->on_hold = 0;
@@ -922,31 +947,22 @@ _e_smart_event_mouse_up(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj EIN
         return;
      }
 
-   if (!sd->items) return;
+   if (!sd->count) return;
 
-   i = 0;
-   EINA_LIST_FOREACH(sd->items, l, item)
+   if (!sd->multi_select)
+     e_ilist_selected_set(sd->o_smart, si->idx);
+   else
      {
-        if (item == si)
-          {
-             if (!sd->multi_select)
-               e_ilist_selected_set(sd->o_smart, i);
-             else
-               {
-                  if (evas_key_modifier_is_set(ev->modifiers, "Shift"))
-                    e_ilist_range_select(sd->o_smart, i);
-                  else if (evas_key_modifier_is_set(ev->modifiers, "Control"))
-                    e_ilist_multi_select(sd->o_smart, i);
-                  else
-                    e_ilist_selected_set(sd->o_smart, i);
-               }
-             break;
-          }
-        i++;
+        if (evas_key_modifier_is_set(ev->modifiers, "Shift"))
+          e_ilist_range_select(sd->o_smart, si->idx);
+        else if (evas_key_modifier_is_set(ev->modifiers, "Control"))
+          e_ilist_multi_select(sd->o_smart, si->idx);
+        else
+          e_ilist_selected_set(sd->o_smart, si->idx);
      }
 
    if (!sd->selector) return;
-   if (!(si = eina_list_nth(sd->items, sd->selected))) return;
+   if (!(si = _e_ilist_nth(sd, sd->selected))) return;
    if (si->func) si->func(si->data, si->data2);
 }
 
@@ -976,7 +992,7 @@ _e_smart_event_key_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, vo
                   break;
                }
              --n;
-             si = eina_list_nth(sd->items, n);
+             si = _e_ilist_nth(sd, n);
           }
         while ((si) && (si->header));
         if (n != ns)
@@ -996,13 +1012,13 @@ _e_smart_event_key_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, vo
         n = ns;
         do
           {
-             if (n == ((int)eina_list_count(sd->items) - 1))
+             if (n == ((int)sd->count - 1))
                {
                   n = ns;
                   break;
                }
              ++n;
-             si = eina_list_nth(sd->items, n);
+             si = _e_ilist_nth(sd, n);
           }
         while ((si) && (si->header));
         if (n != ns)
@@ -1022,13 +1038,13 @@ _e_smart_event_key_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, vo
         n = -1;
         do
           {
-             if (n == ((int)eina_list_count(sd->items) - 1))
+             if (n == ((int)sd->count - 1))
                {
                   n = ns;
                   break;
                }
              ++n;
-             si = eina_list_nth(sd->items, n);
+             si = _e_ilist_nth(sd, n);
           }
         while ((si) && (si->header));
         if (n != ns)
@@ -1045,7 +1061,7 @@ _e_smart_event_key_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, vo
      }
    else if ((!strcmp(ev->key, "End")) || (!strcmp(ev->key, "KP_End")))
      {
-        n = eina_list_count(sd->items);
+        n = sd->count;
         do
           {
              if (n == 0)
@@ -1054,7 +1070,7 @@ _e_smart_event_key_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, vo
                   break;
                }
              --n;
-             si = eina_list_nth(sd->items, n);
+             si = _e_ilist_nth(sd, n);
           }
         while ((si) && (si->header));
         if (n != ns)
@@ -1075,7 +1091,7 @@ _e_smart_event_key_down(void *data, Evas *evas EINA_UNUSED, Evas_Object *obj, vo
      {
         if (!sd->on_hold)
           {
-             si = eina_list_nth(sd->items, sd->selected);
+             si = _e_ilist_nth(sd, sd->selected);
              if (si)
                {
                   if (si->func) si->func(si->data, si->data2);
@@ -1096,6 +1112,7 @@ _e_ilist_widget_hack_cb(E_Smart_Data *sd, Evas_Object *obj EINA_UNUSED, Evas_Obj
    int w, h;
    e_scrollframe_child_viewport_size_get(scr, &w, &h);
    evas_object_resize(sd->o_edje, w, h);
+   evas_object_smart_changed(sd->o_smart);
 }
 
 static void
@@ -1147,8 +1164,7 @@ static void
 _e_typebuf_match(Evas_Object *obj)
 {
    char *match;
-   Eina_List *l;
-   int n;
+   unsigned int n;
    E_Ilist_Item *si = NULL;
 
    INTERNAL_ENTRY;
@@ -1160,25 +1176,15 @@ _e_typebuf_match(Evas_Object *obj)
    strcat(match, sd->typebuf.buf);
    strcat(match, "*");
 
-   n = 0;
-   EINA_LIST_FOREACH(sd->items, l, si)
+   for (n = 0; n < sd->count; n++)
      {
-        const char *label = NULL;
-
-        if (si)
+        si = sd->items[n];
+        if (!si->label) continue;
+        if (e_util_glob_case_match(si->label, match))
           {
-             if (si->label)
-               label = si->label;
-             else
-               label = edje_object_part_text_get(si->o_base, "e.text.label");
-
-             if (e_util_glob_case_match(label, match))
-               {
-                  e_ilist_selected_set(obj, n);
-                  break;
-               }
+             e_ilist_selected_set(obj, n);
+             break;
           }
-        n++;
      }
 
    free(match);
@@ -1233,10 +1239,13 @@ _item_select(E_Ilist_Item *si)
    const char *selectraise;
    E_Smart_Data *sd = si->sd;
    si->selected = EINA_TRUE;
-   selectraise = edje_object_data_get(si->o_base, "selectraise");
-   if ((selectraise) && (!strcmp(selectraise, "on")))
-     evas_object_raise(si->o_base);
-   edje_object_signal_emit(si->o_base, "e,state,selected", "e");
+   if (si->o_base)
+     {
+        selectraise = edje_object_data_get(si->o_base, "selectraise");
+        if ((selectraise) && (!strcmp(selectraise, "on")))
+          evas_object_stack_below(si->o_base, sd->o_edje);
+        edje_object_signal_emit(si->o_base, "e,state,selected", "e");
+     }
    if (si->o_icon)
      {
         const char *t = evas_object_type_get(si->o_icon);
@@ -1255,7 +1264,8 @@ _item_unselect(E_Ilist_Item *si)
    const char *stacking, *selectraise;
    E_Smart_Data *sd = si->sd;
    si->selected = EINA_FALSE;
-   edje_object_signal_emit(si->o_base, "e,state,unselected", "e");
+   if (si->o_base)
+     edje_object_signal_emit(si->o_base, "e,state,unselected", "e");
    if (si->o_icon)
      {
         if (strcmp(evas_object_type_get(si->o_icon), "e_icon") && e_icon_edje_get(si->o_icon))
@@ -1263,20 +1273,22 @@ _item_unselect(E_Ilist_Item *si)
         else
           e_icon_selected_set(si->o_icon, EINA_FALSE);
      }
-   stacking = edje_object_data_get(si->o_base, "stacking");
-   selectraise = edje_object_data_get(si->o_base, "selectraise");
-   if ((selectraise) && (!strcmp(selectraise, "on")))
+   if (si->o_base)
      {
-        if ((stacking) && (!strcmp(stacking, "below")))
-          evas_object_lower(si->o_base);
+        stacking = edje_object_data_get(si->o_base, "stacking");
+        selectraise = edje_object_data_get(si->o_base, "selectraise");
+        if ((selectraise) && (!strcmp(selectraise, "on")))
+          {
+             if ((stacking) && (!strcmp(stacking, "below")))
+               evas_object_lower(si->o_base);
+          }
      }
    sd->selected_items = eina_list_remove(sd->selected_items, si);
 }
 
 static void
-_e_ilist_item_theme_set(E_Ilist_Item *si, Eina_Bool custom, Eina_Bool header, Eina_Bool even)
+_e_ilist_item_theme_set(E_Smart_Data *sd, Evas_Object *o, Eina_Bool custom, Eina_Bool header, Eina_Bool even)
 {
-   E_Smart_Data *sd = si->sd;
    const char *file;
    char buf[4096];
 
@@ -1286,22 +1298,22 @@ _e_ilist_item_theme_set(E_Ilist_Item *si, Eina_Bool custom, Eina_Bool header, Ei
           {
              if (!even)
                {
-                  if (!e_theme_edje_object_set(si->o_base, "base/theme/widgets",
+                  if (!e_theme_edje_object_set(o, "base/theme/widgets",
                                                "e/widgets/ilist_header_odd"))
-                    e_theme_edje_object_set(si->o_base, "base/theme/widgets",
+                    e_theme_edje_object_set(o, "base/theme/widgets",
                                             "e/widgets/ilist_header");
                }
              else
-               e_theme_edje_object_set(si->o_base, "base/theme/widgets",
+               e_theme_edje_object_set(o, "base/theme/widgets",
                                        "e/widgets/ilist_header");
           }
         else
           {
              if (!even)
-               e_theme_edje_object_set(si->o_base, "base/theme/widgets",
+               e_theme_edje_object_set(o, "base/theme/widgets",
                                        "e/widgets/ilist_odd");
              else
-               e_theme_edje_object_set(si->o_base, "base/theme/widgets",
+               e_theme_edje_object_set(o, "base/theme/widgets",
                                        "e/widgets/ilist");
           }
         return;
@@ -1312,53 +1324,253 @@ _e_ilist_item_theme_set(E_Ilist_Item *si, Eina_Bool custom, Eina_Bool header, Ei
         if (even)
           {
              snprintf(buf, sizeof(buf), "%s/ilist_header", sd->theme);
-             if (edje_object_file_set(si->o_base, file, buf)) return;
-             _e_ilist_item_theme_set(si, EINA_FALSE, header, even);
+             if (edje_object_file_set(o, file, buf)) return;
+             _e_ilist_item_theme_set(sd, o, EINA_FALSE, header, even);
              return;
           }
         snprintf(buf, sizeof(buf), "%s/ilist_header_odd", sd->theme);
-        if (edje_object_file_set(si->o_base, file, buf)) return;
-        _e_ilist_item_theme_set(si, EINA_FALSE, header, even);
+        if (edje_object_file_set(o, file, buf)) return;
+        _e_ilist_item_theme_set(sd, o, EINA_FALSE, header, even);
         return;
      }
    if (even)
      {
         snprintf(buf, sizeof(buf), "%s/ilist", sd->theme);
-        if (edje_object_file_set(si->o_base, file, buf)) return;
-        _e_ilist_item_theme_set(si, EINA_FALSE, header, even);
+        if (edje_object_file_set(o, file, buf)) return;
+        _e_ilist_item_theme_set(sd, o, EINA_FALSE, header, even);
         return;
      }
    snprintf(buf, sizeof(buf), "%s/ilist_odd", sd->theme);
-   if (edje_object_file_set(si->o_base, file, buf)) return;
-   _e_ilist_item_theme_set(si, EINA_FALSE, header, even);
+   if (edje_object_file_set(o, file, buf)) return;
+   _e_ilist_item_theme_set(sd, o, EINA_FALSE, header, even);
    return;
 }
 
+static Evas_Object *
+_e_ilist_row_get(E_Smart_Data *sd, Eina_Bool header, Eina_Bool odd)
+{
+   Evas_Object *o;
+   Eina_List *l;
+   int kind = ROW_KIND(header, odd);
+
+   if ((l = eina_list_last(sd->pool[kind])))
+     {
+        o = eina_list_data_get(l);
+        sd->pool[kind] = eina_list_remove_list(sd->pool[kind], l);
+        return o;
+     }
+
+   o = edje_object_add(evas_object_evas_get(sd->o_smart));
+   if (!o) return NULL;
+   E_EXPAND(o);
+   E_FILL(o);
+   _e_ilist_item_theme_set(sd, o, !!sd->theme, header, !odd);
+   evas_object_event_callback_add(o, EVAS_CALLBACK_MOUSE_DOWN,
+                                  _e_smart_event_mouse_down, sd);
+   evas_object_event_callback_add(o, EVAS_CALLBACK_MOUSE_UP,
+                                  _e_smart_event_mouse_up, sd);
+   evas_object_smart_member_add(o, sd->o_smart);
+   evas_object_clip_set(o, sd->o_clip);
+   return o;
+}
+
+static void
+_e_ilist_row_put(E_Smart_Data *sd, Evas_Object *o, Eina_Bool header, Eina_Bool odd)
+{
+   int kind = ROW_KIND(header, odd);
+
+   evas_object_hide(o);
+   evas_object_data_del(o, "e_ilist_item");
+   sd->pool[kind] = eina_list_append(sd->pool[kind], o);
+}
+
+static void
+_e_ilist_pool_flush(E_Smart_Data *sd)
+{
+   Evas_Object *o;
+   int kind;
+
+   for (kind = 0; kind < 4; kind++)
+     EINA_LIST_FREE(sd->pool[kind], o)
+       evas_object_del(o);
+}
+
+static void
+_e_ilist_item_measure(E_Ilist_Item *si)
+{
+   E_Smart_Data *sd = si->sd;
+   Evas_Object *o;
+   Evas_Coord mw = 0, mh = 0;
+
+   if (si->o_base)
+     {
+        edje_object_size_min_calc(si->o_base, &mw, &mh);
+        si->mw = mw;
+        si->mh = mh;
+        return;
+     }
+
+   /* borrow a spare row of the same kind just long enough to size it */
+   o = _e_ilist_row_get(sd, si->header, si->idx & 0x1);
+   if (!o) return;
+   edje_object_part_text_set(o, "e.text.label", si->label);
+   if (si->o_icon)
+     edje_object_part_swallow(o, "e.swallow.icon", si->o_icon);
+   if (si->o_end)
+     edje_object_part_swallow(o, "e.swallow.end", si->o_end);
+   edje_object_size_min_calc(o, &mw, &mh);
+   si->mw = mw;
+   si->mh = mh;
+   if (si->o_icon)
+     {
+        edje_object_part_unswallow(o, si->o_icon);
+        evas_object_clip_set(si->o_icon, sd->o_hidden);
+     }
+   if (si->o_end)
+     {
+        edje_object_part_unswallow(o, si->o_end);
+        evas_object_clip_set(si->o_end, sd->o_hidden);
+     }
+   _e_ilist_row_put(sd, o, si->header, si->idx & 0x1);
+}
+
+static void
+_e_ilist_item_realize(E_Ilist_Item *si)
+{
+   E_Smart_Data *sd = si->sd;
+   const char *stacking, *selectraise;
+
+   if (si->o_base) return;
+   si->o_base = _e_ilist_row_get(sd, si->header, si->idx & 0x1);
+   if (!si->o_base) return;
+   evas_object_data_set(si->o_base, "e_ilist_item", si);
+   edje_object_part_text_set(si->o_base, "e.text.label", si->label);
+   if (si->o_icon)
+     edje_object_part_swallow(si->o_base, "e.swallow.icon", si->o_icon);
+   if (si->o_end)
+     edje_object_part_swallow(si->o_base, "e.swallow.end", si->o_end);
+   if (sd->disabled)
+     edje_object_signal_emit(si->o_base, "e,state,disabled", "e");
+   else
+     edje_object_signal_emit(si->o_base, "e,state,enabled", "e");
+
+   evas_object_stack_below(si->o_base, sd->o_edje);
+   stacking = edje_object_data_get(si->o_base, "stacking");
+   if ((stacking) && (!strcmp(stacking, "below")))
+     evas_object_lower(si->o_base);
+   if (si->selected)
+     {
+        edje_object_signal_emit(si->o_base, "e,state,selected", "e");
+        selectraise = edje_object_data_get(si->o_base, "selectraise");
+        if ((selectraise) && (!strcmp(selectraise, "on")))
+          evas_object_stack_below(si->o_base, sd->o_edje);
+     }
+   else
+     edje_object_signal_emit(si->o_base, "e,state,unselected", "e");
+   evas_object_show(si->o_base);
+}
+
+static void
+_e_ilist_item_unrealize(E_Ilist_Item *si)
+{
+   E_Smart_Data *sd = si->sd;
+
+   if (!si->o_base) return;
+   if (si->o_icon)
+     {
+        edje_object_part_unswallow(si->o_base, si->o_icon);
+        evas_object_clip_set(si->o_icon, sd->o_hidden);
+     }
+   if (si->o_end)
+     {
+        edje_object_part_unswallow(si->o_base, si->o_end);
+        evas_object_clip_set(si->o_end, sd->o_hidden);
+     }
+   _e_ilist_row_put(sd, si->o_base, si->header, si->idx & 0x1);
+   si->o_base = NULL;
+}
+
+static void
+_e_ilist_unrealize_all(E_Smart_Data *sd)
+{
+   unsigned int i;
+
+   for (i = sd->vis_start; (i < sd->vis_end) && (i < sd->count); i++)
+     _e_ilist_item_unrealize(sd->items[i]);
+   sd->vis_start = sd->vis_end = 0;
+}
+
+static void
+_e_ilist_layout(E_Smart_Data *sd)
+{
+   E_Ilist_Item *si;
+   Evas_Coord y = 0, mw = 0;
+   unsigned int i;
+
+   if (!sd->layout_dirty) return;
+   for (i = 0; i < sd->count; i++)
+     {
+        si = sd->items[i];
+        si->y = y;
+        y += si->mh;
+        if (si->mw > mw) mw = si->mw;
+     }
+   sd->mw = mw;
+   sd->mh = y;
+   sd->layout_dirty = 0;
+}
+
+static Eina_Bool
+_e_ilist_item_insert(E_Smart_Data *sd, E_Ilist_Item *si, unsigned int pos)
+{
+   E_Ilist_Item **items;
+   unsigned int i, alloc;
+
+   if (sd->count == sd->alloc)
+     {
+        alloc = sd->alloc ? sd->alloc * 2 : 32;
+        items = realloc(sd->items, alloc * sizeof(E_Ilist_Item *));
+        if (!items) return EINA_FALSE;
+        sd->items = items;
+        sd->alloc = alloc;
+     }
+   /* rows behind the insertion point move down and change parity */
+   if (pos < sd->count)
+     {
+        _e_ilist_unrealize_all(sd);
+        memmove(&sd->items[pos + 1], &sd->items[pos],
+                (sd->count - pos) * sizeof(E_Ilist_Item *));
+        if (sd->selected >= (int)pos) sd->selected++;
+     }
+   sd->items[pos] = si;
+   sd->count++;
+   for (i = pos; i < sd->count; i++)
+     sd->items[i]->idx = i;
+
+   _e_ilist_item_measure(si);
+   sd->items_list_dirty = 1;
+   sd->layout_dirty = 1;
+   evas_object_smart_changed(sd->o_smart);
+   return EINA_TRUE;
+}
+
 static E_Ilist_Item *
 _e_ilist_item_new(E_Smart_Data *sd, Evas_Object *icon, Evas_Object *end, const char *label, int header, Ecore_End_Cb func, Ecore_End_Cb func_hilight, void *data, void *data2)
 {
-   int isodd;
    E_Ilist_Item *si;
 
    si = E_NEW(E_Ilist_Item, 1);
+   if (!si) return NULL;
    si->sd = sd;
-   si->o_base = edje_object_add(evas_object_evas_get(sd->o_smart));
-   E_EXPAND(si->o_base);
-   E_FILL(si->o_base);
-
-   isodd = eina_list_count(sd->items) & 0x1;
-   _e_ilist_item_theme_set(si, !!sd->theme, header, !isodd);
-   if (label)
-     {
-        si->label = eina_stringshare_add(label);
-        edje_object_part_text_set(si->o_base, "e.text.label", label);
-     }
+   if (label) si->label = eina_stringshare_add(label);
 
+   /* the row object is only attached while the item is near the
+    * visible area - until then icons are parked on a hidden clip */
    si->o_icon = icon;
    if (si->o_icon)
      {
         evas_object_size_hint_min_set(si->o_icon, sd->iw, sd->ih);
-        edje_object_part_swallow(si->o_base, "e.swallow.icon", si->o_icon);
+        evas_object_clip_set(si->o_icon, sd->o_hidden);
         evas_object_show(si->o_icon);
      }
    si->o_end = end;
@@ -1373,7 +1585,7 @@ _e_ilist_item_new(E_Smart_Data *sd, Evas_Object *icon, Evas_Object *end, const c
              eh = sd->ih;
           }
         evas_object_size_hint_min_set(si->o_end, ew, eh);
-        edje_object_part_swallow(si->o_base, "e.swallow.end", si->o_end);
+        evas_object_clip_set(si->o_end, sd->o_hidden);
         evas_object_show(si->o_end);
      }
    si->func = func;
@@ -1381,28 +1593,32 @@ _e_ilist_item_new(E_Smart_Data *sd, Evas_Object *icon, Evas_Object *end, const c
    si->data = data;
    si->data2 = data2;
    si->header = header;
-
-   evas_object_event_callback_add(si->o_base, EVAS_CALLBACK_MOUSE_DOWN,
-                                  _e_smart_event_mouse_down, si);
-   evas_object_event_callback_add(si->o_base, EVAS_CALLBACK_MOUSE_UP,
-                                  _e_smart_event_mouse_up, si);
-   if (sd->disabled)
-     edje_object_signal_emit(si->o_base, "e,state,disabled", "e");
-   else
-     edje_object_signal_emit(si->o_base, "e,state,enabled", "e");
    return si;
 }
 
+static void
+_e_ilist_item_free(E_Ilist_Item *si)
+{
+   _e_ilist_item_unrealize(si);
+   if (si->o_icon) evas_object_del(si->o_icon);
+   if (si->o_end) evas_object_del(si->o_end);
+   if (si->label) eina_stringshare_del(si->label);
+   E_FREE(si);
+}
+
 E_API void
 e_ilist_disabled_set(Evas_Object *obj, Eina_Bool set)
 {
    E_Ilist_Item *ili;
-   const Eina_List *l;
+   unsigned int i;
 
    API_ENTRY return;
    sd->disabled = !!set;
-   EINA_LIST_FOREACH(sd->items, l, ili)
+   /* rows realized later pick the state up themselves */
+   for (i = sd->vis_start; (i < sd->vis_end) && (i < sd->count); i++)
      {
+        ili = sd->items[i];
+        if (!ili->o_base) continue;
         if (sd->disabled)
           edje_object_signal_emit(ili->o_base, "e,state,disabled", "e");
         else
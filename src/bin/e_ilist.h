@@ -10,9 +10,11 @@ struct _E_Ilist_Item
 {
    void *sd;
    const char *label;
-   Evas_Object *o_base;
+   Evas_Object *o_base; /* only set while the row is near the visible area */
    Evas_Object *o_icon;
    Evas_Object *o_end;
+   int idx;
+   Evas_Coord y, mw, mh;
    unsigned char header E_BITFIELD;
    unsigned char selected E_BITFIELD;
    unsigned char queued E_BITFIELD;
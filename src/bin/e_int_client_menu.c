@@ -1500,16 +1500,16 @@ _e_client_menu_cb_netwm_icon(void *data, E_Menu *m, E_Menu_Item *mi)
 {
    E_Client *ec;
    Evas_Object *o;
+   Ecore_X_Icon *icon;
 
    ec = data;
    E_OBJECT_CHECK(ec);
 
-   if (ec->netwm.icons)
+   icon = e_client_netwm_icon_get(ec, 24 * e_scale);
+   if (icon)
      {
         o = e_icon_add(m->evas);
-        e_icon_data_set(o, ec->netwm.icons[0].data,
-                        ec->netwm.icons[0].width,
-                        ec->netwm.icons[0].height);
+        e_icon_data_set(o, icon->data, icon->width, icon->height);
         e_icon_alpha_set(o, 1);
         mi->icon_object = o;
      }
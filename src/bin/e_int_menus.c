@@ -781,47 +781,26 @@ static Eina_Bool
 _e_int_menus_app_finder(const char *exec)
 {
    const char *env = getenv("PATH");
-   char **split, buf[PATH_MAX];
-   Eina_Bool exec_found = EINA_FALSE;
-   int i = 0;
-   char *real = NULL;
+   char *real = NULL, *found;
+   Eina_Bool exec_found;
 
    if (!exec) return EINA_FALSE;
    real = _e_int_menus_app_exe_get(exec);
    if (!real) return EINA_FALSE;
-   if (strchr(real, '/'))
-     {
-        if (ecore_file_exists(real) && ecore_file_can_exec(real))
-          {
-             free(real);
-             return EINA_TRUE;
-          }
-     }
 
-   if (!env)
+   if ((!env) && (!strchr(real, '/')))
      {
         WRN("Unable to $PATH, Returning TRUE for every .desktop");
         free(real);
         return EINA_TRUE;
      }
 
-   split = eina_str_split(env, ":", 0);
-   for (i = 0; split[i] != NULL; i++)
-     {
-        snprintf(buf, sizeof(buf), "%s/%s", split[i], real);
-
-        if (ecore_file_exists(buf) && ecore_file_can_exec(buf))
-          {
-             exec_found = EINA_TRUE;
-             break;
-          }
-     }
-   free(split[0]);
-   free(split);
-
+   found = e_exec_path_find(real);
+   exec_found = !!found;
    if (!exec_found)
-     WRN("Unable to find: [%s] I searched $PATH=%s", exec, env);
+     WRN("Unable to find: [%s] I searched $PATH=%s", exec, env ? env : "");
 
+   free(found);
    free(real);
    return exec_found;
 }
@@ -9,12 +9,7 @@
 
 #define TS_DO
 #ifdef TS_DO
-# define TS(x)                                                    \
-  {                                                               \
-     t1 = ecore_time_unix_get();                                  \
-     printf("ESTART: %1.5f [%1.5f] - %s\n", t1 - t0, t1 - t2, x); \
-     t2 = t1;                                                     \
-  }
+# define TS(x) e_main_ts(x)
 static double t0, t1, t2;
 #else
 # define TS(x)
@@ -88,6 +83,7 @@ static void      _e_main_modules_load(Eina_Bool safe_mode);
 static Eina_Bool _e_main_cb_idle_before(void *data EINA_UNUSED);
 static Eina_Bool _e_main_cb_idle_after(void *data EINA_UNUSED);
 static Eina_Bool _e_main_cb_startup_fake_end(void *data EINA_UNUSED);
+static void      _e_main_ts_shutdown(void);
 
 /* local variables */
 static Eina_Bool really_know = EINA_FALSE;
@@ -103,6 +99,22 @@ static Ecore_Idle_Enterer *_idle_after = NULL;
 
 static Ecore_Event_Handler *mod_init_end = NULL;
 
+/* startup timeline - every TS() and explicit span is kept here so it can
+ * be fetched over msgbus or dumped as chrome trace json after startup */
+typedef struct _E_Main_Ts
+{
+   char  *name;
+   double t, len;
+   int    tid;
+} E_Main_Ts;
+
+#define TS_MAX 4096
+
+static E_Main_Ts *_e_main_ts = NULL;
+static unsigned int _e_main_ts_num = 0;
+static unsigned int _e_main_ts_alloc = 0;
+static Ecore_Timer *_e_main_ts_trace_timer = NULL;
+
 /* external variables */
 E_API Eina_Bool e_precache_end = EINA_FALSE;
 E_API Eina_Bool x_fatal = EINA_FALSE;
@@ -306,15 +318,6 @@ main(int argc, char **argv)
         e_error_message_show(_("Enlightenment could not create a logging domain!\n"));
         _e_main_shutdown(-1);
      }
-#ifdef TS_DO
-#undef TS
-# define TS(x)                                                    \
-  {                                                               \
-     t1 = ecore_time_unix_get();                                  \
-     printf("ESTART: %1.5f [%1.5f] - %s\n", t1 - t0, t1 - t2, x); \
-     t2 = t1;                                                     \
-  }
-#endif
    TS("Eina Init Done");
    _e_main_shutdown_push(e_log_shutdown);
 
@@ -1108,6 +1111,7 @@ main(int argc, char **argv)
 
    inloop = EINA_FALSE;
    stopping = EINA_TRUE;
+   E_FREE_FUNC(_e_main_ts_trace_timer, ecore_timer_del);
 
    //if (!x_fatal) e_canvas_idle_flush();
 
@@ -1125,10 +1129,89 @@ main(int argc, char **argv)
      }
 
    e_prefix_shutdown();
+   _e_main_ts_shutdown();
 
    return 0;
 }
 
+static Eina_Bool
+_e_main_cb_ts_trace_write(void *data EINA_UNUSED)
+{
+   const char *file = getenv("E_START_TRACE");
+   char *trace;
+   FILE *f;
+
+   _e_main_ts_trace_timer = NULL;
+   if ((!file) || (!file[0])) return ECORE_CALLBACK_CANCEL;
+   trace = e_main_ts_trace_get();
+   if (!trace) return ECORE_CALLBACK_CANCEL;
+   f = fopen(file, "w");
+   if (f)
+     {
+        fputs(trace, f);
+        fclose(f);
+     }
+   free(trace);
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_e_main_ts_add(const char *str, double t, double len, int tid)
+{
+   E_Main_Ts *ts;
+
+   if (_e_main_ts_num >= TS_MAX) return;
+   if (_e_main_ts_num == _e_main_ts_alloc)
+     {
+        ts = realloc(_e_main_ts, (_e_main_ts_alloc + 256) * sizeof(E_Main_Ts));
+        if (!ts) return;
+        _e_main_ts = ts;
+        _e_main_ts_alloc += 256;
+     }
+   ts = &(_e_main_ts[_e_main_ts_num]);
+   ts->name = strdup(str);
+   if (!ts->name) return;
+   ts->t = t;
+   ts->len = len;
+   ts->tid = tid;
+   _e_main_ts_num++;
+   // once in the main loop write the trace out when things go quiet again
+   if ((inloop) && (getenv("E_START_TRACE")))
+     {
+        if (_e_main_ts_trace_timer)
+          ecore_timer_loop_reset(_e_main_ts_trace_timer);
+        else
+          _e_main_ts_trace_timer =
+            ecore_timer_loop_add(3.0, _e_main_cb_ts_trace_write, NULL);
+     }
+}
+
+static void
+_e_main_ts_shutdown(void)
+{
+   unsigned int i;
+
+   for (i = 0; i < _e_main_ts_num; i++) free(_e_main_ts[i].name);
+   E_FREE(_e_main_ts);
+   _e_main_ts_num = _e_main_ts_alloc = 0;
+}
+
+static void
+_e_main_ts_json_str(Eina_Strbuf *buf, const char *str, size_t len)
+{
+   size_t i;
+
+   for (i = 0; i < len; i++)
+     {
+        if ((str[i] == '"') || (str[i] == '\\'))
+          eina_strbuf_append_printf(buf, "\\%c", str[i]);
+        else if ((unsigned char)str[i] < ' ')
+          eina_strbuf_append_char(buf, ' ');
+        else
+          eina_strbuf_append_char(buf, str[i]);
+     }
+}
+
 E_API double
 e_main_ts(const char *str)
 {
@@ -1137,6 +1220,111 @@ e_main_ts(const char *str)
    printf("ESTART: %1.5f [%1.5f] - %s\n", t1 - t0, t1 - t2, str);
    ret = t1 - t2;
    t2 = t1;
+   _e_main_ts_add(str, t1, ret, 0);
+   return ret;
+}
+
+E_API void
+e_main_ts_span(const char *str, double start, double len)
+{
+   // something timed on its own (eg. in a thread) - start is unix time
+   printf("ESTART: %1.5f [%1.5f] - %s\n", start - t0, len, str);
+   _e_main_ts_add(str, start, len, 1);
+}
+
+E_API char *
+e_main_ts_timeline_get(void)
+{
+   Eina_Strbuf *buf;
+   unsigned int i;
+   char *ret;
+
+   buf = eina_strbuf_new();
+   if (!buf) return NULL;
+   for (i = 0; i < _e_main_ts_num; i++)
+     eina_strbuf_append_printf(buf, "%1.5f [%1.5f] - %s\n",
+                               _e_main_ts[i].t - t0, _e_main_ts[i].len,
+                               _e_main_ts[i].name);
+   ret = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+   return ret;
+}
+
+E_API char *
+e_main_ts_trace_get(void)
+{
+   Eina_Strbuf *buf;
+   int *pair;
+   unsigned int i, j;
+   size_t len;
+   double start, dur;
+   char *ret;
+   int pid = getpid();
+
+   buf = eina_strbuf_new();
+   if (!buf) return NULL;
+   pair = malloc((_e_main_ts_num + 1) * sizeof(int));
+   if (!pair)
+     {
+        eina_strbuf_free(buf);
+        return NULL;
+     }
+   // "X Done" closes the latest still open "X" - that pair makes one phase.
+   // pair[] is the index of the opening ts, -1 for none, -2 if this one is
+   // an opener itself and is covered by its phase
+   for (i = 0; i < _e_main_ts_num; i++)
+     {
+        pair[i] = -1;
+        if (_e_main_ts[i].tid) continue;
+        len = strlen(_e_main_ts[i].name);
+        if ((len <= 5) || (strcmp(_e_main_ts[i].name + len - 5, " Done")))
+          continue;
+        for (j = i; j-- > 0;)
+          {
+             if ((pair[j] != -1) || (_e_main_ts[j].tid) ||
+                 (strncmp(_e_main_ts[j].name, _e_main_ts[i].name, len - 5)) ||
+                 (_e_main_ts[j].name[len - 5]))
+               continue;
+             pair[i] = j;
+             pair[j] = -2;
+             break;
+          }
+     }
+   eina_strbuf_append_printf
+     (buf, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+      "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%i,"
+      "\"args\":{\"name\":\"enlightenment\"}}", pid);
+   for (i = 0; i < _e_main_ts_num; i++)
+     {
+        E_Main_Ts *ts = &(_e_main_ts[i]);
+
+        if (pair[i] == -2) continue;
+        len = strlen(ts->name);
+        start = ts->t;
+        dur = -1.0;
+        if (ts->tid) dur = ts->len;
+        else if (pair[i] >= 0)
+          {
+             start = _e_main_ts[pair[i]].t;
+             dur = ts->t - start;
+             len -= 5;
+          }
+        eina_strbuf_append(buf, ",\n{\"name\":\"");
+        _e_main_ts_json_str(buf, ts->name, len);
+        eina_strbuf_append_printf
+          (buf, "\",\"cat\":\"%s\",\"pid\":%i,\"tid\":%i,\"ts\":%1.0f,",
+           strncmp(ts->name, "Module", 6) ? "startup" : "module",
+           pid, ts->tid + 1, (start - t0) * 1000000.0);
+        if (dur >= 0.0)
+          eina_strbuf_append_printf(buf, "\"ph\":\"X\",\"dur\":%1.0f}",
+                                    dur * 1000000.0);
+        else
+          eina_strbuf_append(buf, "\"ph\":\"i\",\"s\":\"p\"}");
+     }
+   eina_strbuf_append(buf, "\n]}\n");
+   free(pair);
+   ret = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
    return ret;
 }
 
@@ -82,6 +82,10 @@ static void         _e_menu_cb_item_submenu_post_default(void *data, E_Menu *m,
 static void         _e_menu_category_free_cb(E_Menu_Category *cat);
 static void         _e_menu_cb_mouse_evas_down(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED);
 static void         _e_menu_hide_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED);
+static void         _e_menu_virtual_update(E_Menu *m, E_Menu_Item *want);
+static void         _e_menu_virtual_reset(E_Menu *m);
+static void         _e_menu_item_selected_emit(E_Menu_Item *mi, Eina_Bool selected);
+static void         _e_menu_metrics_flush(void);
 
 typedef enum
 {
@@ -117,6 +121,31 @@ static Nav_By _e_menu_nav_by = NAV_BY_NONE;
 static Eina_Bool pending_feed;
 static unsigned int pending_activate_time;
 
+/* menus with more items than this only realize the items near the screen
+ * and leave two spacers sized from cached row metrics for the rest */
+#define E_MENU_VIRTUAL_ITEMS 32
+
+typedef struct _E_Menu_Metric
+{
+   Evas_Coord w, h;
+} E_Menu_Metric;
+
+typedef struct _E_Menu_Row_Metric
+{
+   Evas_Coord content_h, pad_w, h;
+} E_Menu_Row_Metric;
+
+typedef struct _E_Menu_Label_Metric
+{
+   Evas_Coord pad_w, h;
+   double     char_w;
+} E_Menu_Label_Metric;
+
+static Eina_Hash *_e_menu_metrics = NULL;
+static E_Menu_Row_Metric _e_menu_row_metrics[2];
+static E_Menu_Label_Metric _e_menu_label_metric;
+static double _e_menu_metrics_scale = 0.0;
+
 static Eina_List *
 _e_active_menus_copy_ref(void)
 {
@@ -186,6 +215,7 @@ e_menu_shutdown(void)
      e_menu_hide_all();
    _e_active_menus = NULL;
    E_FREE_FUNC(_e_menu_categories, eina_hash_free);
+   _e_menu_metrics_flush();
 
    _e_menu_lock = EINA_FALSE;
    e_int_menus_shutdown();
@@ -1031,26 +1061,9 @@ e_menu_item_active_set(E_Menu_Item *mi, int active)
           }
         mi->active = 1;
         _e_active_menu_item = mi;
-        if (mi->bg_object)
-          edje_object_signal_emit(mi->bg_object, "e,state,selected", "e");
-        if (mi->icon_bg_object)
-          edje_object_signal_emit(mi->icon_bg_object, "e,state,selected", "e");
-        if (isedje(mi->label_object))
-          edje_object_signal_emit(mi->label_object, "e,state,selected", "e");
-        if (isedje(mi->submenu_object))
-          edje_object_signal_emit(mi->submenu_object, "e,state,selected", "e");
-        if (isedje(mi->toggle_object))
-          edje_object_signal_emit(mi->toggle_object, "e,state,selected", "e");
-        if (mi->icon_key)
-          {
-             if (mi->icon_object)
-               {
-                  if (isedje(mi->icon_object))
-                    edje_object_signal_emit(mi->icon_object, "e,state,selected", "e");
-                  else
-                    e_icon_selected_set(mi->icon_object, EINA_TRUE);
-               }
-          }
+        if ((mi->menu->virt.top) && (!mi->bg_object))
+          _e_menu_virtual_update(mi->menu, mi);
+        _e_menu_item_selected_emit(mi, EINA_TRUE);
         edje_object_signal_emit(mi->menu->bg_object, "e,state,selected", "e");
         _e_menu_submenu_activate(mi);
      }
@@ -1060,26 +1073,7 @@ e_menu_item_active_set(E_Menu_Item *mi, int active)
         mi->active = 0;
         _e_prev_active_menu_item = mi;
         _e_active_menu_item = NULL;
-        if (mi->bg_object)
-          edje_object_signal_emit(mi->bg_object, "e,state,unselected", "e");
-        if (mi->icon_bg_object)
-          edje_object_signal_emit(mi->icon_bg_object, "e,state,unselected", "e");
-        if (isedje(mi->label_object))
-          edje_object_signal_emit(mi->label_object, "e,state,unselected", "e");
-        if (isedje(mi->submenu_object))
-          edje_object_signal_emit(mi->submenu_object, "e,state,unselected", "e");
-        if (isedje(mi->toggle_object))
-          edje_object_signal_emit(mi->toggle_object, "e,state,unselected", "e");
-        if (mi->icon_key)
-          {
-             if (mi->icon_object)
-               {
-                  if (isedje(mi->icon_object))
-                    edje_object_signal_emit(mi->icon_object, "e,state,unselected", "e");
-                  else
-                    e_icon_selected_set(mi->icon_object, EINA_FALSE);
-               }
-          }
+        _e_menu_item_selected_emit(mi, EINA_FALSE);
         edje_object_signal_emit(mi->menu->bg_object, "e,state,unselected", "e");
      }
    _e_menu_list_free_unref(tmp);
@@ -1167,6 +1161,8 @@ e_menu_idler_before(void)
         if (m->frozen || (!m->active) || (!m->zone)) continue;
         if (!m->realized) _e_menu_realize(m);
         if (!m->realized) continue;
+        if ((!m->prev.visible) || (m->cur.y != m->prev.y))
+          _e_menu_virtual_update(m, NULL);
         if (((m->cur.w) != (m->prev.w)) ||
             ((m->cur.h) != (m->prev.h)))
           {
@@ -1321,6 +1317,8 @@ _e_menu_free(E_Menu *m)
 static void
 _e_menu_item_free(E_Menu_Item *mi)
 {
+   E_Menu *m = NULL;
+
    if (mi == _e_active_menu_item) _e_active_menu_item = NULL;
    if (mi == _e_prev_active_menu_item) _e_prev_active_menu_item = NULL;
    if (mi->submenu)
@@ -1346,8 +1344,15 @@ _e_menu_item_free(E_Menu_Item *mi)
              mi->submenu->parent_item = NULL;
           }
      }
+   if ((mi->menu->realized) && (mi->menu->virt.top))
+     {
+        /* the window is found by walking from its first item */
+        m = mi->menu;
+        _e_menu_virtual_reset(m);
+     }
    if (mi->menu->realized) _e_menu_item_unrealize(mi);
    mi->menu->items = eina_list_remove(mi->menu->items, mi);
+   if (m) _e_menu_virtual_update(m, NULL);
    if (mi->icon) eina_stringshare_del(mi->icon);
    if (mi->icon_key) eina_stringshare_del(mi->icon_key);
    if (mi->label) eina_stringshare_del(mi->label);
@@ -1413,6 +1418,359 @@ _e_menu_hide_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED, v
    e_object_unref(data);
 }
 
+static void
+_e_menu_metrics_flush(void)
+{
+   E_FREE_FUNC(_e_menu_metrics, eina_hash_free);
+   memset(_e_menu_row_metrics, 0, sizeof(_e_menu_row_metrics));
+   memset(&_e_menu_label_metric, 0, sizeof(_e_menu_label_metric));
+}
+
+static void
+_e_menu_metrics_check(void)
+{
+   /* every cached size depends on the scale - start over if it changed */
+   if (EINA_DBL_EQ(_e_menu_metrics_scale, e_scale)) return;
+   _e_menu_metrics_flush();
+   _e_menu_metrics_scale = e_scale;
+}
+
+/* min size of a bare menu theme group, the same for every item using it */
+static Eina_Bool
+_e_menu_metric_get(Evas *evas, const char *group, Evas_Coord *w, Evas_Coord *h)
+{
+   E_Menu_Metric *mm;
+   Evas_Object *o;
+
+   *w = *h = 0;
+   _e_menu_metrics_check();
+   if (!_e_menu_metrics)
+     _e_menu_metrics = eina_hash_string_superfast_new(free);
+   mm = eina_hash_find(_e_menu_metrics, group);
+   if (!mm)
+     {
+        mm = E_NEW(E_Menu_Metric, 1);
+        if (!mm) return EINA_FALSE;
+        o = edje_object_add(evas);
+        if (e_theme_edje_object_set(o, "base/theme/menus", group))
+          edje_object_size_min_calc(o, &mm->w, &mm->h);
+        else
+          mm->w = mm->h = -1;
+        evas_object_del(o);
+        eina_hash_add(_e_menu_metrics, group, mm);
+     }
+   if (mm->w < 0) return EINA_FALSE;
+   *w = mm->w;
+   *h = mm->h;
+   return EINA_TRUE;
+}
+
+/* size a label would have, from the average glyph width of the label style,
+ * so items that are never realized never get measured */
+static void
+_e_menu_label_metric_estimate(Evas *evas, const char *label, Evas_Coord *w, Evas_Coord *h)
+{
+   static const char sample[] =
+     "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+   Evas_Object *o;
+   Evas_Coord pw = 0, ph = 0, sw = 0, sh = 0;
+
+   _e_menu_metrics_check();
+   if (_e_menu_label_metric.h <= 0)
+     {
+        o = edje_object_add(evas);
+        e_theme_edje_object_set(o, "base/theme/menus",
+                                "e/widgets/menu/default/label");
+        edje_object_size_min_calc(o, &pw, &ph);
+        edje_object_part_text_set(o, "e.text.label", sample);
+        edje_object_size_min_calc(o, &sw, &sh);
+        evas_object_del(o);
+        _e_menu_label_metric.pad_w = pw;
+        _e_menu_label_metric.char_w = (double)(sw - pw) / (sizeof(sample) - 1);
+        _e_menu_label_metric.h = MAX(sh, 1);
+     }
+   *w = _e_menu_label_metric.pad_w + 1 +
+     (Evas_Coord)(_e_menu_label_metric.char_w * eina_unicode_utf8_get_len(label));
+   *h = _e_menu_label_metric.h;
+}
+
+/* size of an item (or submenu item) row around content of the given min
+ * size - measured once per style and content height, not per item */
+static void
+_e_menu_row_metric_get(Evas *evas, Eina_Bool sub, Evas_Coord cw, Evas_Coord ch, Evas_Coord *w, Evas_Coord *h)
+{
+   E_Menu_Row_Metric *rm = &(_e_menu_row_metrics[!!sub]);
+   Evas_Object *o, *r;
+   Evas_Coord mw = 0, mh = 0;
+
+   _e_menu_metrics_check();
+   if ((rm->h <= 0) || (rm->content_h != ch))
+     {
+        o = edje_object_add(evas);
+        if ((!sub) ||
+            (!e_theme_edje_object_set(o, "base/theme/menus",
+                                      "e/widgets/menu/default/submenu_bg")))
+          e_theme_edje_object_set(o, "base/theme/menus",
+                                  "e/widgets/menu/default/item_bg");
+        r = evas_object_rectangle_add(evas);
+        evas_object_size_hint_min_set(r, cw, ch);
+        edje_object_part_swallow(o, "e.swallow.content", r);
+        edje_object_size_min_calc(o, &mw, &mh);
+        evas_object_del(r);
+        evas_object_del(o);
+        rm->content_h = ch;
+        rm->pad_w = mw - cw;
+        rm->h = MAX(mh, 1);
+     }
+   *w = cw + rm->pad_w;
+   *h = rm->h;
+}
+
+/* fill in the sizes an item would have once realized, without realizing it */
+static void
+_e_menu_item_metrics_fill(E_Menu_Item *mi)
+{
+   Evas *evas = mi->menu->evas;
+
+   if (mi->separator)
+     {
+        _e_menu_metric_get(evas, "e/widgets/menu/default/separator",
+                           &mi->separator_w, &mi->separator_h);
+        return;
+     }
+   if (mi->check)
+     _e_menu_metric_get(evas, "e/widgets/menu/default/check",
+                        &mi->toggle_w, &mi->toggle_h);
+   else if (mi->radio)
+     _e_menu_metric_get(evas, "e/widgets/menu/default/radio",
+                        &mi->toggle_w, &mi->toggle_h);
+   else
+     mi->toggle_w = mi->toggle_h = 0;
+   if ((!e_config->menu_icons_hide) && ((mi->icon) || (mi->realize_cb.func)))
+     _e_menu_metric_get(evas, "e/widgets/menu/default/icon",
+                        &mi->icon_w, &mi->icon_h);
+   else
+     mi->icon_w = mi->icon_h = 0;
+   if (mi->label)
+     _e_menu_label_metric_estimate(evas, mi->label, &mi->label_w, &mi->label_h);
+   else
+     mi->label_w = mi->label_h = 0;
+   if ((mi->submenu) || (mi->submenu_pre_cb.func))
+     _e_menu_metric_get(evas, "e/widgets/menu/default/submenu",
+                        &mi->submenu_w, &mi->submenu_h);
+   else
+     mi->submenu_w = mi->submenu_h = 0;
+}
+
+static Eina_Bool
+_e_menu_item_realized(const E_Menu_Item *mi)
+{
+   return (mi->separator_object) || (mi->bg_object);
+}
+
+static Evas_Coord
+_e_menu_item_row_h(const E_Menu *m, const E_Menu_Item *mi)
+{
+   if (mi->separator) return mi->separator_h;
+   return m->virt.row_h[(mi->submenu) || (mi->submenu_pre_cb.func)];
+}
+
+static void
+_e_menu_item_pack(E_Menu_Item *mi, Evas_Object *o)
+{
+   E_Menu *m = mi->menu;
+   E_Menu_Item *pmi;
+   Evas_Object *po = m->virt.top;
+
+   if (!po)
+     {
+        elm_box_pack_end(m->container_object, o);
+        return;
+     }
+   /* the window is realized top down, so the row above is already packed */
+   if (mi != m->virt.first)
+     {
+        pmi = eina_list_data_get(eina_list_prev(mi->list_position));
+        if ((pmi) && (_e_menu_item_realized(pmi)))
+          po = pmi->separator_object ?: pmi->bg_object;
+     }
+   elm_box_pack_after(m->container_object, o, po);
+}
+
+/* where an item starts in the item column, walking out from the window */
+static Evas_Coord
+_e_menu_virtual_item_y(E_Menu *m, E_Menu_Item *mi, unsigned int *num)
+{
+   Eina_List *fwd, *bwd;
+   Evas_Coord yf, yb;
+   unsigned int nf, nb;
+
+   fwd = bwd = m->virt.first->list_position;
+   yf = yb = m->virt.y;
+   nf = nb = m->virt.first_num;
+   while ((fwd) || (bwd))
+     {
+        if ((fwd) && (eina_list_data_get(fwd) == mi))
+          {
+             *num = nf;
+             return yf;
+          }
+        if ((bwd) && (eina_list_data_get(bwd) == mi))
+          {
+             *num = nb;
+             return yb;
+          }
+        if (fwd)
+          {
+             yf += _e_menu_item_row_h(m, eina_list_data_get(fwd));
+             fwd = eina_list_next(fwd);
+             nf++;
+          }
+        if (bwd)
+          {
+             bwd = eina_list_prev(bwd);
+             if (bwd) yb -= _e_menu_item_row_h(m, eina_list_data_get(bwd));
+             nb--;
+          }
+     }
+   return -1;
+}
+
+/* move the window of realized items to cover half a screen around the
+ * visible part of the menu, or around want. only rows entering or leaving
+ * the window are touched, so this costs what was scrolled, not the menu */
+static Eina_Bool
+_e_menu_virtual_window_set(E_Menu *m, E_Menu_Item *want)
+{
+   Eina_List *l, *ll;
+   E_Menu_Item *mi, *ofirst;
+   unsigned int num, onum, ocount, count, i;
+   Evas_Coord y, h, top, bottom;
+   int zy, zh;
+
+   if (!m->virt.top) return EINA_FALSE;
+   /* items may have gone since the last layout */
+   m->virt.max = MIN(m->virt.max, eina_list_count(m->items));
+   if (!m->virt.max) return EINA_FALSE;
+   e_zone_useful_geometry_get(m->zone, NULL, &zy, NULL, &zh);
+   if (!m->virt.first)
+     {
+        m->virt.first = eina_list_data_get(m->items);
+        m->virt.first_num = 0;
+        m->virt.y = 0;
+        m->virt.count = 0;
+     }
+   ofirst = m->virt.first;
+   onum = m->virt.first_num;
+   ocount = m->virt.count;
+   if (want)
+     {
+        y = _e_menu_virtual_item_y(m, want, &num);
+        if ((y < 0) || (num >= m->virt.max)) return EINA_FALSE;
+        top = y - zh;
+        bottom = y + zh;
+     }
+   else
+     {
+        top = zy - (zh / 2) - m->cur.y;
+        bottom = zy + zh + (zh / 2) - m->cur.y;
+     }
+   l = ofirst->list_position;
+   num = onum;
+   y = m->virt.y;
+   while ((num + 1 < m->virt.max) &&
+          ((y + _e_menu_item_row_h(m, eina_list_data_get(l))) < top))
+     {
+        y += _e_menu_item_row_h(m, eina_list_data_get(l));
+        l = eina_list_next(l);
+        num++;
+     }
+   while ((num > 0) && (y > top))
+     {
+        l = eina_list_prev(l);
+        y -= _e_menu_item_row_h(m, eina_list_data_get(l));
+        num--;
+     }
+   h = y;
+   count = 0;
+   for (ll = l; (ll) && ((num + count) < m->virt.max) && (h <= bottom);
+        ll = eina_list_next(ll))
+     {
+        h += _e_menu_item_row_h(m, eina_list_data_get(ll));
+        count++;
+     }
+   if ((num == onum) && (count == ocount)) return EINA_FALSE;
+
+   /* drop what left the window, then realize what came into it */
+   for (i = onum, ll = ofirst->list_position; (ll) && (i < (onum + ocount));
+        i++, ll = eina_list_next(ll))
+     {
+        if ((i < num) || (i >= (num + count)))
+          _e_menu_item_unrealize(eina_list_data_get(ll));
+     }
+   m->virt.first = eina_list_data_get(l);
+   m->virt.first_num = num;
+   m->virt.y = y;
+   m->virt.count = count;
+   for (i = 0, ll = l; (ll) && (i < count); i++, ll = eina_list_next(ll))
+     {
+        mi = eina_list_data_get(ll);
+        if (!_e_menu_item_realized(mi)) _e_menu_item_realize(mi);
+     }
+   return EINA_TRUE;
+}
+
+static void
+_e_menu_virtual_update(E_Menu *m, E_Menu_Item *want)
+{
+   if (!m->virt.top) return;
+   evas_event_freeze(m->evas);
+   if (_e_menu_virtual_window_set(m, want))
+     _e_menu_items_layout_update(m);
+   evas_event_thaw(m->evas);
+   evas_event_thaw_eval(m->evas);
+}
+
+static void
+_e_menu_virtual_reset(E_Menu *m)
+{
+   Eina_List *l;
+   unsigned int i;
+
+   if (!m->virt.first) return;
+   for (i = 0, l = m->virt.first->list_position; (l) && (i < m->virt.count);
+        i++, l = eina_list_next(l))
+     _e_menu_item_unrealize(eina_list_data_get(l));
+   m->virt.first = NULL;
+   m->virt.first_num = 0;
+   m->virt.count = 0;
+   m->virt.y = 0;
+}
+
+static void
+_e_menu_item_selected_emit(E_Menu_Item *mi, Eina_Bool selected)
+{
+   const char *sig = selected ? "e,state,selected" : "e,state,unselected";
+
+   if (mi->bg_object)
+     edje_object_signal_emit(mi->bg_object, sig, "e");
+   if (mi->icon_bg_object)
+     edje_object_signal_emit(mi->icon_bg_object, sig, "e");
+   if (isedje(mi->label_object))
+     edje_object_signal_emit(mi->label_object, sig, "e");
+   if (isedje(mi->submenu_object))
+     edje_object_signal_emit(mi->submenu_object, sig, "e");
+   if (isedje(mi->toggle_object))
+     edje_object_signal_emit(mi->toggle_object, sig, "e");
+   if ((mi->icon_key) && (mi->icon_object))
+     {
+        if (isedje(mi->icon_object))
+          edje_object_signal_emit(mi->icon_object, sig, "e");
+        else
+          e_icon_selected_set(mi->icon_object, selected);
+     }
+}
+
 static void
 _e_menu_item_realize(E_Menu_Item *mi)
 {
@@ -1426,12 +1784,13 @@ _e_menu_item_realize(E_Menu_Item *mi)
         mi->separator_object = o;
         e_theme_edje_object_set(o, "base/theme/menus",
                                 "e/widgets/menu/default/separator");
-        edje_object_size_min_calc(mi->separator_object, &ww, &hh);
+        _e_menu_metric_get(mi->menu->evas, "e/widgets/menu/default/separator",
+                           &ww, &hh);
         E_FILL(mi->separator_object);
         mi->separator_w = ww;
         mi->separator_h = hh;
         evas_object_size_hint_min_set(mi->separator_object, ww, hh);
-        elm_box_pack_end(mi->menu->container_object, mi->separator_object);
+        _e_menu_item_pack(mi, mi->separator_object);
         evas_object_show(o);
      }
    else
@@ -1466,7 +1825,8 @@ no_submenu_item:
              mi->toggle_object = o;
              e_theme_edje_object_set(o, "base/theme/menus",
                                      "e/widgets/menu/default/check");
-             edje_object_size_min_calc(mi->toggle_object, &ww, &hh);
+             _e_menu_metric_get(mi->menu->evas, "e/widgets/menu/default/check",
+                                &ww, &hh);
              mi->toggle_w = ww;
              mi->toggle_h = hh;
              E_WEIGHT(mi->toggle_object, 0, 1);
@@ -1481,7 +1841,8 @@ no_submenu_item:
              mi->toggle_object = o;
              e_theme_edje_object_set(o, "base/theme/menus",
                                      "e/widgets/menu/default/radio");
-             edje_object_size_min_calc(mi->toggle_object, &ww, &hh);
+             _e_menu_metric_get(mi->menu->evas, "e/widgets/menu/default/radio",
+                                &ww, &hh);
              mi->toggle_w = ww;
              mi->toggle_h = hh;
              E_WEIGHT(mi->toggle_object, 0, 1);
@@ -1631,7 +1992,8 @@ no_submenu_item:
              mi->submenu_object = o;
              e_theme_edje_object_set(o, "base/theme/menus",
                                      "e/widgets/menu/default/submenu");
-             edje_object_size_min_calc(mi->submenu_object, &ww, &hh);
+             _e_menu_metric_get(mi->menu->evas, "e/widgets/menu/default/submenu",
+                                &ww, &hh);
              mi->submenu_w = ww;
              mi->submenu_h = hh;
              E_WEIGHT(mi->submenu_object, 0, 1);
@@ -1651,11 +2013,11 @@ no_submenu_item:
         edje_object_part_swallow(mi->bg_object, "e.swallow.content",
                                  mi->container_object);
 
-        elm_box_pack_end(mi->menu->container_object, mi->bg_object);
+        _e_menu_item_pack(mi, mi->bg_object);
         evas_object_show(mi->container_object);
         evas_object_show(mi->bg_object);
      }
-   if (mi->active) e_menu_item_active_set(mi, 1);
+   if (mi->active) _e_menu_item_selected_emit(mi, EINA_TRUE);
    if (mi->toggle) e_menu_item_toggle_set(mi, 1);
    if (mi->disable) e_menu_item_disabled_set(mi, 1);
 }
@@ -1697,12 +2059,39 @@ _e_menu_realize(E_Menu *m)
    evas_object_intercept_move_callback_add(o, _e_menu_cb_intercept_container_move, m);
    evas_object_intercept_resize_callback_add(o, _e_menu_cb_intercept_container_resize, m);
 
-   EINA_LIST_FOREACH(m->items, l, mi)
-     _e_menu_item_realize(mi);
+   if (eina_list_count(m->items) > E_MENU_VIRTUAL_ITEMS)
+     {
+        /* rows above and below the realized window */
+        o = evas_object_rectangle_add(m->evas);
+        m->virt.top = o;
+        evas_object_color_set(o, 0, 0, 0, 0);
+        evas_object_pass_events_set(o, 1);
+        E_WEIGHT(o, 1, 0);
+        E_FILL(o);
+        elm_box_pack_end(m->container_object, o);
+        evas_object_show(o);
+        o = evas_object_rectangle_add(m->evas);
+        m->virt.bottom = o;
+        evas_object_color_set(o, 0, 0, 0, 0);
+        evas_object_pass_events_set(o, 1);
+        E_WEIGHT(o, 1, 0);
+        E_FILL(o);
+        elm_box_pack_end(m->container_object, o);
+        evas_object_show(o);
+        EINA_LIST_FOREACH(m->items, l, mi)
+          _e_menu_item_metrics_fill(mi);
+     }
+   else
+     {
+        EINA_LIST_FOREACH(m->items, l, mi)
+          _e_menu_item_realize(mi);
+     }
 
    edje_object_part_swallow(m->bg_object, "e.swallow.content", m->container_object);
 
    _e_menu_items_layout_update(m);
+   if (_e_menu_virtual_window_set(m, NULL))
+     _e_menu_items_layout_update(m);
 
 
    evas_event_thaw(m->evas);
@@ -1726,9 +2115,13 @@ _e_menu_items_layout_update(E_Menu *m)
    int min_toggle_w = 0, min_toggle_h = 0;
    int min_w = 0, min_h = 1;
    int zh = 0, ms = 0, maxh = 0;
-   unsigned int cur_items = 0, max_items = -1;
+   unsigned int i, cur_items = 0, max_items = -1;
+   Evas_Coord row_w[2], row_h[2];
+   Eina_Bool sub;
 
    if (!m->zone) return;
+   /* unrealized items of a long menu carry estimated sizes, so this only
+    * reads numbers - objects are only touched in the realized window */
    EINA_LIST_FOREACH(m->items, l, mi)
      {
         if (mi->icon) icons_on = 1;
@@ -1738,6 +2131,7 @@ _e_menu_items_layout_update(E_Menu *m)
         if (mi->submenu_pre_cb.func) submenus_on = 1;
         if (mi->check) toggles_on = 1;
         if (mi->radio) toggles_on = 1;
+        if ((!_e_menu_item_realized(mi)) && (mi->icon_w)) icons_on = 1;
 
         if (mi->icon_w > min_icon_w) min_icon_w = mi->icon_w;
         if (mi->icon_h > min_icon_h) min_icon_h = mi->icon_h;
@@ -1800,10 +2194,37 @@ _e_menu_items_layout_update(E_Menu *m)
         if (maxh > 30000) maxh = 30000;  // 32k x 32k mx coord limit for wins
         max_items = (maxh / min_h) - 1;
      }
-   EINA_LIST_FOREACH(m->items, l, mi)
-     {
+   /* every row of a style is the same size, so measure each style once */
+   _e_menu_row_metric_get(m->evas, 0, min_w, min_h, &row_w[0], &row_h[0]);
+   row_w[1] = row_w[0];
+   row_h[1] = row_h[0];
+   if (submenus_on)
+     _e_menu_row_metric_get(m->evas, 1, min_w, min_h, &row_w[1], &row_h[1]);
+   l = m->items;
+   if (m->virt.top)
+     {
+        if ((row_h[0] != m->virt.row_h[0]) || (row_h[1] != m->virt.row_h[1]))
+          {
+             m->virt.row_h[0] = row_h[0];
+             m->virt.row_h[1] = row_h[1];
+             /* the rows above the window changed size */
+             m->virt.y = 0;
+             for (i = 0; (l) && (i < m->virt.first_num); i++, l = eina_list_next(l))
+               m->virt.y += _e_menu_item_row_h(m, eina_list_data_get(l));
+          }
+        m->virt.max = MIN(eina_list_count(m->items), max_items);
+        m->virt.h = 0;
+        for (i = 0, l = m->items; (l) && (i < m->virt.max); i++, l = eina_list_next(l))
+          m->virt.h += _e_menu_item_row_h(m, eina_list_data_get(l));
+        l = m->virt.first ? m->virt.first->list_position : NULL;
+        max_items = m->virt.count;
+     }
+   for (; l; l = eina_list_next(l))
+     {
+        mi = eina_list_data_get(l);
         if (cur_items >= max_items)
           {
+             if (m->virt.top) break;
              _e_menu_item_unrealize(mi);
              continue;
           }
@@ -1843,11 +2264,18 @@ _e_menu_items_layout_update(E_Menu *m)
 
         evas_object_size_hint_min_set(mi->container_object,
                                         min_w, min_h);
-        edje_object_size_min_calc(mi->bg_object, &mw, &mh);
+        sub = (mi->submenu) || (mi->submenu_pre_cb.func);
         E_WEIGHT(mi->bg_object, 0, 1);
         E_FILL(mi->bg_object);
-        evas_object_size_hint_min_set(mi->bg_object, mw, mh);
-        ms += mh;
+        evas_object_size_hint_min_set(mi->bg_object, row_w[sub], row_h[sub]);
+        ms += row_h[sub];
+     }
+   if (m->virt.top)
+     {
+        evas_object_size_hint_min_set(m->virt.top, MAX(row_w[0], row_w[1]),
+                                      m->virt.y);
+        evas_object_size_hint_min_set(m->virt.bottom, 0,
+                                      MAX(m->virt.h - m->virt.y - ms, 0));
      }
    elm_box_recalculate(m->container_object);
    evas_object_size_hint_min_get(m->container_object, &bw, &bh);
@@ -1909,7 +2337,13 @@ _e_menu_unrealize(E_Menu *m)
      _e_menu_item_unrealize(mi);
    E_FREE_FUNC(m->header.icon, evas_object_del);
    E_FREE_FUNC(m->bg_object, evas_object_del);
+   E_FREE_FUNC(m->virt.top, evas_object_del);
+   E_FREE_FUNC(m->virt.bottom, evas_object_del);
    E_FREE_FUNC(m->container_object, evas_object_del);
+   m->virt.first = NULL;
+   m->virt.first_num = 0;
+   m->virt.count = 0;
+   m->virt.y = 0;
    m->cur.visible = 0;
    m->prev.visible = 0;
    m->realized = 0;
@@ -2586,7 +3020,15 @@ _e_menu_item_ensure_onscreen(E_Menu_Item *mi)
 
    if (!mi->menu) return;
    if (!mi->menu->zone) return;
-   evas_object_geometry_get(mi->container_object, &x, &y, &w, &h);
+   if (mi->container_object)
+     evas_object_geometry_get(mi->container_object, &x, &y, &w, &h);
+   else
+     {
+        x = mi->x;
+        y = mi->y;
+        w = mi->w;
+        h = mi->h;
+     }
    if ((x + w) > (mi->menu->zone->x + mi->menu->zone->w))
      dx = (mi->menu->zone->x + mi->menu->zone->w) - (x + w);
    else if (x < mi->menu->zone->x)
@@ -59,6 +59,16 @@ struct _E_Menu
    Evas_Object         *container_object;
    Evas_Coord           container_x, container_y, container_w, container_h;
 
+   /* long menus only realize a window of items near the screen, with
+    * spacers standing in for the rows above and below it */
+   struct {
+      Evas_Object      *top, *bottom;
+      E_Menu_Item      *first;
+      unsigned int      first_num, count, max;
+      Evas_Coord        y, h;
+      Evas_Coord        row_h[2];
+   } virt;
+
    struct {
       void *data;
       void (*func) (void *data, E_Menu *m);
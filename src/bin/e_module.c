@@ -14,6 +14,29 @@ static void      _e_module_cb_dialog_disable(void *data, E_Dialog *dia);
 static void      _e_module_event_update_free(void *data, void *event);
 static int       _e_module_sort_name(const void *d1, const void *d2);
 static void      _e_module_whitelist_check(void);
+static void      _e_module_preload(Eina_List *names, int threads);
+static void      _e_module_preload_free(void *data);
+static Eina_Bool _e_module_cb_deferred_init(void *data);
+
+/* a module resolved and dlopen()ed ahead of time by a preload thread, handed
+ * over to e_module_new() on the main loop */
+typedef struct _E_Module_Preload
+{
+   Eina_Stringshare *name;
+   Eina_Stringshare *modpath;
+   void             *handle;
+   char             *error;
+   double            start, time;
+} E_Module_Preload;
+
+typedef struct _E_Module_Preload_Queue
+{
+   E_Module_Preload **jobs;
+   unsigned int       count;
+   unsigned int       next;
+   Eina_Spinlock      lock;
+   Eina_List         *dirs;
+} E_Module_Preload_Queue;
 
 /* local subsystem globals */
 static Eina_List *_e_modules = NULL;
@@ -23,6 +46,10 @@ static Eina_Bool _e_modules_init_end = EINA_FALSE;
 
 static Eina_Hash *_e_module_path_hash = NULL;
 
+static Eina_Hash *_e_module_preload_hash = NULL;
+static Eina_List *_e_modules_deferred = NULL;
+static Ecore_Idler *_e_modules_deferred_idler = NULL;
+
 E_API int E_EVENT_MODULE_UPDATE = 0;
 E_API int E_EVENT_MODULE_INIT_END = 0;
 
@@ -106,18 +133,61 @@ e_module_shutdown(void)
           }
      }
 
+   E_FREE_FUNC(_e_modules_deferred_idler, ecore_idler_del);
+   E_FREE_LIST(_e_modules_deferred, eina_stringshare_del);
+   E_FREE_FUNC(_e_module_preload_hash, eina_hash_free);
    E_FREE_FUNC(_e_module_path_hash, eina_hash_free);
    E_FREE_FUNC(_e_modules_hash, eina_hash_free);
 
    return 1;
 }
 
+static Eina_Bool
+_e_module_deferred_check(const char *name)
+{
+   const char *defer = getenv("E_MODULE_DEFER");
+   const char *p;
+   size_t len;
+
+   if ((!defer) || (!defer[0])) return EINA_FALSE;
+   if (_module_is_important(name)) return EINA_FALSE;
+   len = strlen(name);
+   for (p = strstr(defer, name); p; p = strstr(p + 1, name))
+     {
+        if (((p == defer) || (p[-1] == ':')) &&
+            ((!p[len]) || (p[len] == ':')))
+          return EINA_TRUE;
+     }
+   return EINA_FALSE;
+}
+
+static void
+_e_module_load_timed(const char *name)
+{
+   E_Module *m;
+   char buf[128];
+
+   e_util_env_set("E_MODULE_LOAD", name);
+   // "X" ... "X Done" pairs show up as one phase in the startup trace
+   snprintf(buf, sizeof(buf), "Module Load: %s", name);
+   e_main_ts(buf);
+   m = e_module_new(name);
+   snprintf(buf, sizeof(buf), "Module Load: %s Done", name);
+   e_main_ts(buf);
+   snprintf(buf, sizeof(buf), "Module Init: %s", name);
+   e_main_ts(buf);
+   if (m) e_module_enable(m);
+   snprintf(buf, sizeof(buf), "Module Init: %s Done", name);
+   e_main_ts(buf);
+}
+
 E_API void
 e_module_all_load(void)
 {
-   Eina_List *l, *ll;
+   Eina_List *l, *ll, *load = NULL;
    E_Config_Module *em, *em2;
-   char buf[128];
+   const char *s;
+   int threads = 0;
 
    _e_modules_initting = EINA_TRUE;
 
@@ -151,17 +221,56 @@ e_module_all_load(void)
           }
         if (em->enabled)
           {
-             E_Module *m;
-
              if (eina_hash_find(_e_modules_hash, em->name)) continue;
+             if (_e_module_deferred_check(em->name))
+               _e_modules_deferred =
+                 eina_list_append(_e_modules_deferred,
+                                  eina_stringshare_ref(em->name));
+             else
+               load = eina_list_append(load, em->name);
+          }
+     }
+
+   // resolve and dlopen() all modules on worker threads first if asked to,
+   // then run the module init funcs in config order here in the main loop.
+   // modules listed in E_MODULE_DEFER are initted one per idle later on
+   s = getenv("E_MODULE_PRELOAD_THREADS");
+   if (s) threads = atoi(s);
+   if ((threads > 0) && (load))
+     {
+        e_main_ts("Module Preload");
+        _e_module_preload(load, threads);
+        e_main_ts("Module Preload Done");
+     }
 
-             e_util_env_set("E_MODULE_LOAD", em->name);
-             snprintf(buf, sizeof(buf), _("Loading Module: %s"), em->name);
+   EINA_LIST_FREE(load, s)
+     _e_module_load_timed(s);
+   // extra modules (names or full .so paths) for this run only - never saved
+   // to config. used by eg. the benchmark suite to get into a headless e
+   s = getenv("E_MODULE_EXTRA");
+   if ((s) && (s[0]))
+     {
+        char **extra;
+        int i;
 
-             m = e_module_new(em->name);
-             if (m) e_module_enable(m);
+        extra = eina_str_split(s, ":", 0);
+        for (i = 0; (extra) && (extra[i]); i++)
+          {
+             if ((!extra[i][0]) || (e_module_find(extra[i]))) continue;
+             _e_module_load_timed(extra[i]);
+          }
+        if (extra)
+          {
+             free(extra[0]);
+             free(extra);
           }
      }
+   // anything preloaded but not consumed (eg. failed init) is closed here
+   E_FREE_FUNC(_e_module_preload_hash, eina_hash_free);
+   if (_e_modules_deferred)
+     _e_modules_deferred_idler =
+       ecore_idler_add(_e_module_cb_deferred_init, NULL);
+
    ecore_event_add(E_EVENT_MODULE_INIT_END, NULL, NULL, NULL);
    _e_modules_init_end = EINA_TRUE;
    _e_modules_initting = EINA_FALSE;
@@ -180,6 +289,7 @@ E_API E_Module *
 e_module_new(const char *name)
 {
    E_Module *m;
+   E_Module_Preload *mp = NULL;
    char buf[PATH_MAX];
    char body[4096], title[1024];
    const char *modpath = NULL;
@@ -189,11 +299,17 @@ e_module_new(const char *name)
    if (!name) return NULL;
    if (eina_hash_find(_e_modules_hash, name)) return NULL;
 
+   if (_e_module_preload_hash)
+     mp = eina_hash_find(_e_module_preload_hash, name);
+
    m = E_OBJECT_ALLOC(E_Module, E_MODULE_TYPE, _e_module_free);
    if (name[0] != '/')
      {
         snprintf(buf, sizeof(buf), "%s/%s/module.so", name, MODULE_ARCH);
-        modpath = e_path_find(path_modules, buf);
+        if (mp)
+          modpath = eina_stringshare_ref(mp->modpath);
+        else
+          modpath = e_path_find(path_modules, buf);
      }
    else if (eina_str_has_extension(name, ".so"))
      modpath = eina_stringshare_add(name);
@@ -207,7 +323,13 @@ e_module_new(const char *name)
         m->error = 1;
         goto init_done;
      }
-   m->handle = dlopen(modpath, (RTLD_NOW | RTLD_LOCAL));
+   if (mp)
+     {
+        m->handle = mp->handle;
+        mp->handle = NULL;
+     }
+   else
+     m->handle = dlopen(modpath, (RTLD_NOW | RTLD_LOCAL));
    if (!m->handle)
      {
         snprintf(body, sizeof(body),
@@ -215,7 +337,8 @@ e_module_new(const char *name)
                    "The full path to this module is:<ps/>"
                    "%s<ps/>"
                    "The error reported was:<ps/>"
-                   "%s<ps/>"), name, buf, dlerror());
+                   "%s<ps/>"), name, buf,
+                 (mp && mp->error) ? mp->error : dlerror());
         _e_module_dialog_disable_create(_("Error loading Module"), body, m);
         m->error = 1;
         goto init_done;
@@ -306,6 +429,7 @@ init_done:
         e_config_save_queue();
      }
    if (modpath) eina_stringshare_del(modpath);
+   if (mp) eina_hash_del_by_key(_e_module_preload_hash, name);
    return m;
 }
 
@@ -855,3 +979,152 @@ _e_module_whitelist_check(void)
      }
 }
 
+static void
+_e_module_preload_free(void *data)
+{
+   E_Module_Preload *mp = data;
+
+   if (mp->handle) dlclose(mp->handle);
+   eina_stringshare_del(mp->modpath);
+   eina_stringshare_del(mp->name);
+   free(mp->error);
+   free(mp);
+}
+
+static void
+_e_module_preload_do(E_Module_Preload *mp, Eina_List *dirs)
+{
+   Eina_List *l;
+   const char *dir;
+   char buf[PATH_MAX];
+
+   mp->start = ecore_time_unix_get();
+
+   // same search order as e_path_find() - default dirs then user dirs
+   EINA_LIST_FOREACH(dirs, l, dir)
+     {
+        snprintf(buf, sizeof(buf), "%s/%s/%s/module.so",
+                 dir, mp->name, MODULE_ARCH);
+        if (ecore_file_exists(buf))
+          {
+             mp->modpath = eina_stringshare_add(buf);
+             break;
+          }
+     }
+   if (!mp->modpath) return;
+   mp->handle = dlopen(mp->modpath, (RTLD_NOW | RTLD_LOCAL));
+   if (!mp->handle)
+     {
+        const char *err = dlerror();
+
+        if (err) mp->error = strdup(err);
+     }
+   mp->time = ecore_time_unix_get() - mp->start;
+}
+
+static void *
+_e_module_preload_thread(void *data, Eina_Thread thr EINA_UNUSED)
+{
+   E_Module_Preload_Queue *q = data;
+   unsigned int i;
+
+   for (;;)
+     {
+        eina_spinlock_take(&q->lock);
+        i = q->next++;
+        eina_spinlock_release(&q->lock);
+        if (i >= q->count) break;
+        _e_module_preload_do(q->jobs[i], q->dirs);
+     }
+   return NULL;
+}
+
+static void
+_e_module_preload(Eina_List *names, int threads)
+{
+   E_Module_Preload_Queue q;
+   E_Module_Preload *mp;
+   E_Path_Dir *epd;
+   Eina_Thread *thr;
+   Eina_Bool *started;
+   Eina_List *l;
+   const char *name;
+   unsigned int i;
+   int n;
+
+   memset(&q, 0, sizeof(q));
+   q.jobs = calloc(eina_list_count(names), sizeof(E_Module_Preload *));
+   if (!q.jobs) return;
+   EINA_LIST_FOREACH(names, l, name)
+     {
+        if (name[0] == '/') continue;
+        mp = E_NEW(E_Module_Preload, 1);
+        mp->name = eina_stringshare_ref(name);
+        q.jobs[q.count++] = mp;
+     }
+   // snapshot the search dirs so the threads never touch path_modules
+   EINA_LIST_FOREACH(path_modules->default_dir_list, l, epd)
+     q.dirs = eina_list_append(q.dirs, eina_stringshare_ref(epd->dir));
+   if (path_modules->user_dir_list)
+     {
+        EINA_LIST_FOREACH(*(path_modules->user_dir_list), l, epd)
+          q.dirs = eina_list_append(q.dirs, eina_stringshare_ref(epd->dir));
+     }
+   eina_spinlock_new(&q.lock);
+
+   if (threads > eina_cpu_count()) threads = eina_cpu_count();
+   if (threads > (int)q.count) threads = q.count;
+   if (threads < 1) threads = 1;
+   thr = alloca(threads * sizeof(Eina_Thread));
+   started = alloca(threads * sizeof(Eina_Bool));
+   for (n = 0; n < threads; n++)
+     {
+        started[n] = eina_thread_create(&(thr[n]), EINA_THREAD_URGENT, -1,
+                                        _e_module_preload_thread, &q);
+        if (!started[n]) ERR("Can't spawn module preload thread");
+     }
+   // if no thread could be spawned at all this just runs them all here
+   _e_module_preload_thread(&q, 0);
+   for (n = 0; n < threads; n++)
+     {
+        if (started[n]) eina_thread_join(thr[n]);
+     }
+   eina_spinlock_free(&q.lock);
+   E_FREE_LIST(q.dirs, eina_stringshare_del);
+
+   if (!_e_module_preload_hash)
+     _e_module_preload_hash =
+       eina_hash_string_superfast_new(_e_module_preload_free);
+   for (i = 0; i < q.count; i++)
+     {
+        char buf[128];
+
+        mp = q.jobs[i];
+        snprintf(buf, sizeof(buf), "Module Preload: %s", mp->name);
+        e_main_ts_span(buf, mp->start, mp->time);
+        if (!eina_hash_add(_e_module_preload_hash, mp->name, mp))
+          _e_module_preload_free(mp);
+     }
+   free(q.jobs);
+}
+
+static Eina_Bool
+_e_module_cb_deferred_init(void *data EINA_UNUSED)
+{
+   const char *name;
+
+   // one module per idle so input and rendering get in between
+   name = eina_list_data_get(_e_modules_deferred);
+   _e_modules_deferred = eina_list_remove_list(_e_modules_deferred,
+                                               _e_modules_deferred);
+   if (name)
+     {
+        if (!eina_hash_find(_e_modules_hash, name))
+          _e_module_load_timed(name);
+        unsetenv("E_MODULE_LOAD");
+        eina_stringshare_del(name);
+     }
+   if (_e_modules_deferred) return ECORE_CALLBACK_RENEW;
+   _e_modules_deferred_idler = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
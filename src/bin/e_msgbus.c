@@ -8,12 +8,16 @@ static void            _e_msgbus_request_name_cb(void *data, const Eldbus_Messag
 static Eldbus_Message *_e_msgbus_core_version_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_e_msgbus_core_restart_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 static Eldbus_Message *_e_msgbus_core_shutdown_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
+static Eldbus_Message *_e_msgbus_core_startup_timeline_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
+static Eldbus_Message *_e_msgbus_core_startup_trace_cb(const Eldbus_Service_Interface *iface, const Eldbus_Message *msg);
 
 static const Eldbus_Method core_methods[] =
 {
    { "Version", NULL, ELDBUS_ARGS({"s", "version"}), _e_msgbus_core_version_cb, 0 },
    { "Restart", NULL, NULL, _e_msgbus_core_restart_cb, 0 },
    { "Shutdown", NULL, NULL, _e_msgbus_core_shutdown_cb, 0 },
+   { "StartupTimeline", NULL, ELDBUS_ARGS({"s", "timeline"}), _e_msgbus_core_startup_timeline_cb, 0 },
+   { "StartupTrace", NULL, ELDBUS_ARGS({"s", "trace"}), _e_msgbus_core_startup_trace_cb, 0 },
    { NULL, NULL, NULL, NULL, 0}
 };
 
@@ -127,3 +131,31 @@ _e_msgbus_core_shutdown_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
      e_sys_action_do(E_SYS_EXIT, NULL);
    return eldbus_message_method_return_new(msg);
 }
+
+static Eldbus_Message *
+_e_msgbus_core_startup_timeline_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
+                                   const Eldbus_Message *msg)
+{
+   Eldbus_Message *reply = eldbus_message_method_return_new(msg);
+   char *str;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(reply, NULL);
+   str = e_main_ts_timeline_get();
+   eldbus_message_arguments_append(reply, "s", str ? str : "");
+   free(str);
+   return reply;
+}
+
+static Eldbus_Message *
+_e_msgbus_core_startup_trace_cb(const Eldbus_Service_Interface *iface EINA_UNUSED,
+                                const Eldbus_Message *msg)
+{
+   Eldbus_Message *reply = eldbus_message_method_return_new(msg);
+   char *str;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(reply, NULL);
+   str = e_main_ts_trace_get();
+   eldbus_message_arguments_append(reply, "s", str ? str : "");
+   free(str);
+   return reply;
+}
@@ -10,12 +10,203 @@ typedef struct _Notification_Data
    const E_Notification_Server_Info *server_info;
 } Notification_Data;
 
+struct _E_Notification_Image
+{
+   int ref;
+   unsigned int hash;
+   int w, h, rowstride, channels, size;
+   unsigned char *raw;
+   unsigned int *pixels;
+   Ecore_Thread *th;
+   Eina_List *objs;
+   Eina_Bool alpha E_BITFIELD;
+};
+
+/* largest image-data we accept - anything bigger is not an icon */
+#define IMAGE_SIZE_MAX 1024
+
 static Notification_Data *n_data = NULL;
+/* images are shared between notifications resending the same data */
+static Eina_Hash *images = NULL;
+
+static unsigned int
+_notification_image_key_length(const void *key EINA_UNUSED)
+{
+   return sizeof(E_Notification_Image);
+}
+
+static int
+_notification_image_key_cmp(const void *key1, int len1 EINA_UNUSED, const void *key2, int len2 EINA_UNUSED)
+{
+   const E_Notification_Image *img1 = key1, *img2 = key2;
+
+   if (img1->w != img2->w) return img1->w - img2->w;
+   if (img1->h != img2->h) return img1->h - img2->h;
+   if (img1->rowstride != img2->rowstride) return img1->rowstride - img2->rowstride;
+   if (img1->channels != img2->channels) return img1->channels - img2->channels;
+   if (img1->alpha != img2->alpha) return img1->alpha - img2->alpha;
+   if (img1->size != img2->size) return img1->size - img2->size;
+   return memcmp(img1->raw, img2->raw, img1->size);
+}
+
+static int
+_notification_image_key_hash(const void *key, int len EINA_UNUSED)
+{
+   const E_Notification_Image *img = key;
+
+   return img->hash;
+}
+
+static void
+_notification_image_free(E_Notification_Image *img)
+{
+   free(img->raw);
+   free(img->pixels);
+   free(img);
+}
+
+static void
+_notification_image_unref(E_Notification_Image *img)
+{
+   if (!img) return;
+   img->ref--;
+   if (img->ref > 0) return;
+   eina_hash_del(images, img, img);
+   if (!eina_hash_population(images)) E_FREE_FUNC(images, eina_hash_free);
+   /* the conversion thread frees it when it ends */
+   if (img->th) ecore_thread_cancel(img->th);
+   else _notification_image_free(img);
+}
+
+static void
+_notification_image_convert(void *data, Ecore_Thread *th)
+{
+   E_Notification_Image *img = data;
+   unsigned int *pixels, *d;
+   const unsigned char *s;
+   int x, y, a;
+
+   pixels = malloc(sizeof(unsigned int) * img->w * img->h);
+   if (!pixels) return;
+   /* Although not specified.
+    * The data are very likely to come from a GdkPixbuf
+    * which align each row on a 4-bytes boundary when using RGB.
+    * And is RGBA otherwise. */
+   d = pixels;
+   for (y = 0; y < img->h; y++)
+     {
+        if (ecore_thread_check(th))
+          {
+             free(pixels);
+             return;
+          }
+        s = img->raw + (y * img->rowstride);
+        for (x = 0; x < img->w; x++, s += img->channels, d++)
+          {
+             if (img->alpha)
+               {
+                  a = s[3];
+                  *d = (a << 24) | (((s[0] * a) / 255) << 16) |
+                    (((s[1] * a) / 255) << 8) | ((s[2] * a) / 255);
+               }
+             else
+               *d = (0xff << 24) | (s[0] << 16) | (s[1] << 8) | (s[2]);
+          }
+     }
+   img->pixels = pixels;
+}
+
+static void
+_notification_image_fill(E_Notification_Image *img, Evas_Object *o)
+{
+   if (!img->pixels) return;
+   evas_object_image_data_copy_set(o, img->pixels);
+   evas_object_image_data_update_add(o, 0, 0, img->w, img->h);
+}
+
+static void
+_notification_image_converted(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Notification_Image *img = data;
+   Evas_Object *o;
+
+   img->th = NULL;
+   if (img->ref <= 0)
+     {
+        _notification_image_free(img);
+        return;
+     }
+   EINA_LIST_FREE(img->objs, o)
+     _notification_image_fill(img, o);
+}
+
+static E_Notification_Image *
+_notification_image_get(int w, int h, int rowstride, Eina_Bool alpha, int bits, int channels, unsigned char *raw, int size)
+{
+   E_Notification_Image *img, key;
+
+   if ((w < 1) || (h < 1) || (w > IMAGE_SIZE_MAX) || (h > IMAGE_SIZE_MAX))
+     return NULL;
+   if ((bits != 8) || (channels < (alpha ? 4 : 3)) ||
+       (rowstride < (w * channels)) ||
+       (size < ((rowstride * (h - 1)) + (w * channels))))
+     return NULL;
+
+   memset(&key, 0, sizeof(key));
+   key.w = w;
+   key.h = h;
+   key.rowstride = rowstride;
+   key.channels = channels;
+   key.alpha = !!alpha;
+   key.size = size;
+   key.raw = raw;
+   key.hash = eina_hash_superfast((const char *)raw, size);
+   if (!images)
+     images = eina_hash_new(_notification_image_key_length,
+                            _notification_image_key_cmp,
+                            _notification_image_key_hash,
+                            NULL, 6);
+   img = eina_hash_find(images, &key);
+   if (img)
+     {
+        img->ref++;
+        return img;
+     }
+
+   img = malloc(sizeof(E_Notification_Image));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(img, NULL);
+   memcpy(img, &key, sizeof(E_Notification_Image));
+   img->raw = malloc(size);
+   if (!img->raw)
+     {
+        free(img);
+        return NULL;
+     }
+   memcpy(img->raw, raw, size);
+   img->ref = 1;
+   eina_hash_direct_add(images, img, img);
+   /* keep the per-pixel work off the main loop - the popup gets a blank
+    * image that is filled in when the conversion is done */
+   img->th = ecore_thread_run(_notification_image_convert,
+                              _notification_image_converted,
+                              _notification_image_converted, img);
+   return img;
+}
+
+static void
+_notification_image_obj_del(void *data, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   E_Notification_Image *img = data;
+
+   img->objs = eina_list_remove(img->objs, obj);
+   _notification_image_unref(img);
+}
 
 static void
 _notification_free(E_Notification_Notify *notify)
 {
    EINA_SAFETY_ON_NULL_RETURN(notify);
+   _notification_image_unref(notify->icon.image);
    eina_stringshare_del(notify->app_name);
    eina_stringshare_del(notify->body);
    eina_stringshare_del(notify->icon.icon);
@@ -43,17 +234,19 @@ hints_dict_iter(void *data, const void *key, Eldbus_Message_Iter *var)
                                               &alpha, &bits, &channels,
                                               &data_iter))
           return;
-        eldbus_message_iter_fixed_array_get(data_iter, 'y', &raw_data,
-                                           &n->icon.raw.data_size);
+        if (!eldbus_message_iter_fixed_array_get(data_iter, 'y', &raw_data,
+                                                &n->icon.raw.data_size))
+          return;
         n->icon.raw.width = w;
         n->icon.raw.height = h;
         n->icon.raw.has_alpha = alpha;
         n->icon.raw.rowstride = r;
         n->icon.raw.bits_per_sample = bits;
         n->icon.raw.channels = channels;
-        n->icon.raw.data = malloc(sizeof(char) * n->icon.raw.data_size);
-        EINA_SAFETY_ON_NULL_RETURN(n->icon.raw.data);
-        memcpy(n->icon.raw.data, raw_data, sizeof(char) * n->icon.raw.data_size);
+        /* the raw copy is only kept once per distinct image */
+        _notification_image_unref(n->icon.image);
+        n->icon.image = _notification_image_get(w, h, r, alpha, bits, channels,
+                                                raw_data, n->icon.raw.data_size);
      }
    else if (!strcmp(key, "urgency"))
      {
@@ -392,6 +585,33 @@ e_notification_notify_raw_image_get(E_Notification_Notify *notify, Evas *evas)
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(notify, NULL);
    EINA_SAFETY_ON_NULL_RETURN_VAL(evas, NULL);
+
+   if (notify->icon.image)
+     {
+        E_Notification_Image *img = notify->icon.image;
+
+        o = evas_object_image_filled_add(evas);
+        evas_object_resize(o, img->w, img->h);
+        evas_object_image_colorspace_set(o, EVAS_COLORSPACE_ARGB8888);
+        evas_object_image_alpha_set(o, img->alpha);
+        evas_object_image_size_set(o, img->w, img->h);
+        img->ref++;
+        evas_object_event_callback_add(o, EVAS_CALLBACK_DEL,
+                                       _notification_image_obj_del, img);
+        if (!img->th)
+          {
+             _notification_image_fill(img, o);
+             return o;
+          }
+        imgdata = evas_object_image_data_get(o, EINA_TRUE);
+        if (imgdata)
+          {
+             memset(imgdata, 0, evas_object_image_stride_get(o) * img->h);
+             evas_object_image_data_set(o, imgdata);
+          }
+        img->objs = eina_list_append(img->objs, o);
+        return o;
+     }
    EINA_SAFETY_ON_NULL_RETURN_VAL(notify->icon.raw.data, NULL);
 
    o = evas_object_image_filled_add(evas);
@@ -577,6 +797,7 @@ e_notification_client_send(E_Notification_Notify *notify, E_Notification_Client_
    copy->icon.icon = eina_stringshare_add(notify->icon.icon);
    if (notify->icon.icon_path)
      copy->icon.icon_path = eina_stringshare_add(notify->icon.icon_path);
+   if (copy->icon.image) copy->icon.image->ref++;
 
    id = n_data->notify_cb(n_data->data, copy);
    if (cb)
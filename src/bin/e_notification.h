@@ -20,6 +20,8 @@ typedef enum _E_Notification_Notify_Closed_Reason
   E_NOTIFICATION_NOTIFY_CLOSED_REASON_UNDEFINED /** Undefined/reserved reasons. */
 } E_Notification_Notify_Closed_Reason;
 
+typedef struct _E_Notification_Image E_Notification_Image;
+
 typedef struct _E_Notification_Notify
 {
    E_Object e_obj_inherit;
@@ -45,6 +47,8 @@ typedef struct _E_Notification_Notify
          unsigned char *data;
          int data_size;
       } raw;
+      /* converted and shared copy of raw image-data received over dbus */
+      E_Notification_Image *image;
    } icon;
 } E_Notification_Notify;
 
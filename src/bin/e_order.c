@@ -1,11 +1,21 @@
 #include "e.h"
 
+typedef struct _E_Order_Entry
+{
+   const char     *line; /* as written in .order, or the path of a file in its dir */
+   Efreet_Desktop *desktop; /* what it resolved to, NULL if nothing */
+} E_Order_Entry;
+
 /* local subsystem functions */
 static void      _e_order_free(E_Order *eo);
 static void      _e_order_cb_monitor(void *data, Ecore_File_Monitor *em, Ecore_File_Event event, const char *path);
 static void      _e_order_read(E_Order *eo);
 static void      _e_order_save(E_Order *eo);
 static void      _e_order_remove_if_exists(E_Order *eo, Efreet_Desktop *desktop);
+static void      _e_order_notify(E_Order *eo);
+static void      _e_order_shown_set(E_Order *eo);
+static void      _e_order_entries_sync(E_Order *eo);
+static void      _e_order_entries_free(E_Order *eo);
 static Eina_Bool _e_order_cb_efreet_cache_update(void *data, int ev_type, void *ev);
 
 static Eina_List *orders = NULL;
@@ -77,6 +87,7 @@ e_order_new(const char *path)
      }
    if (path) eo->path = eina_stringshare_add(path);
    _e_order_read(eo);
+   _e_order_shown_set(eo);
    eo->monitor = ecore_file_monitor_add(path, _e_order_cb_monitor, eo);
 
    orders = eina_list_append(orders, eo);
@@ -103,6 +114,8 @@ e_order_clone(const E_Order *eo)
         efreet_desktop_ref(desktop);
         eoc->desktops = eina_list_append(eoc->desktops, desktop);
      }
+   _e_order_entries_sync(eoc);
+   _e_order_shown_set(eoc);
    eoc->monitor = ecore_file_monitor_add(eoc->path, _e_order_cb_monitor, eoc);
 
    orders = eina_list_append(orders, eoc);
@@ -119,6 +132,19 @@ e_order_update_callback_set(E_Order *eo, void (*cb)(void *data, E_Order *eo), vo
    eo->cb.data = data;
 }
 
+/* with a change callback set, reloads report each added, removed, moved
+ * or re-resolved desktop instead of calling update. update is still used
+ * when the change can't be expressed that way (duplicate entries). */
+E_API void
+e_order_change_callback_set(E_Order *eo, void (*cb)(void *data, E_Order *eo, E_Order_Change change, Efreet_Desktop *desktop, Efreet_Desktop *other), void *data)
+{
+   E_OBJECT_CHECK(eo);
+   E_OBJECT_TYPE_CHECK(eo, E_ORDER_TYPE);
+
+   eo->cb.change = cb;
+   eo->cb.change_data = data;
+}
+
 E_API void
 e_order_remove(E_Order *eo, Efreet_Desktop *desktop)
 {
@@ -220,6 +246,8 @@ _e_order_free(E_Order *eo)
 {
    if (eo->delay) ecore_timer_del(eo->delay);
    E_FREE_LIST(eo->desktops, efreet_desktop_free);
+   E_FREE_LIST(eo->shown, efreet_desktop_free);
+   _e_order_entries_free(eo);
    if (eo->path) eina_stringshare_del(eo->path);
    if (eo->monitor) ecore_file_monitor_del(eo->monitor);
    orders = eina_list_remove(orders, eo);
@@ -249,9 +277,9 @@ _e_order_cb_monitor_delay(void *data)
    E_Order *eo = data;
 
    /* It doesn't really matter what the change is, just re-read the file */
-   _e_order_read(eo);
-   if (eo->cb.update) eo->cb.update(eo->cb.data, eo);
    eo->delay = NULL;
+   _e_order_read(eo);
+   _e_order_notify(eo);
    return ECORE_CALLBACK_CANCEL;
 }
 
@@ -264,15 +292,98 @@ _e_order_cb_monitor(void *data, Ecore_File_Monitor *em EINA_UNUSED, Ecore_File_E
    eo->delay = ecore_timer_loop_add(0.2, _e_order_cb_monitor_delay, eo);
 }
 
+static void
+_e_order_entry_add(E_Order *eo, const char *line, Efreet_Desktop *desktop)
+{
+   E_Order_Entry *ent;
+
+   ent = E_NEW(E_Order_Entry, 1);
+   if (!ent)
+     {
+        if (desktop) efreet_desktop_free(desktop);
+        return;
+     }
+   ent->line = eina_stringshare_add(line);
+   ent->desktop = desktop;
+   eo->entries = eina_list_append(eo->entries, ent);
+}
+
+static void
+_e_order_entries_free(E_Order *eo)
+{
+   E_Order_Entry *ent;
+
+   EINA_LIST_FREE(eo->entries, ent)
+     {
+        eina_stringshare_del(ent->line);
+        if (ent->desktop) efreet_desktop_free(ent->desktop);
+        free(ent);
+     }
+}
+
+/* what the file says after a local change, so a cache update doesn't have
+ * to wait for the monitor to re-read it */
+static void
+_e_order_entries_sync(E_Order *eo)
+{
+   Eina_List *l;
+   Efreet_Desktop *desktop;
+   const char *id;
+
+   _e_order_entries_free(eo);
+   EINA_LIST_FOREACH(eo->desktops, l, desktop)
+     {
+        id = efreet_util_path_to_file_id(desktop->orig_path);
+        efreet_desktop_ref(desktop);
+        _e_order_entry_add(eo, id ? id : desktop->orig_path, desktop);
+     }
+}
+
+static void
+_e_order_desktops_set(E_Order *eo)
+{
+   Eina_List *l;
+   E_Order_Entry *ent;
+
+   E_FREE_LIST(eo->desktops, efreet_desktop_free);
+   EINA_LIST_FOREACH(eo->entries, l, ent)
+     {
+        if (!ent->desktop) continue;
+        efreet_desktop_ref(ent->desktop);
+        eo->desktops = eina_list_append(eo->desktops, ent->desktop);
+     }
+}
+
+static Efreet_Desktop *
+_e_order_entry_resolve(const char *dir, const char *line)
+{
+   Efreet_Desktop *desktop;
+   char buf[8192];
+
+   // if full path - use that first
+   if (line[0] == '/') return efreet_desktop_get(line);
+   // desktop file in the order dir first
+   snprintf(buf, sizeof(buf), "%s/%s", dir, line);
+   desktop = efreet_desktop_get(buf);
+   // ignore any path elements and look up just filename
+   if (!desktop)
+     desktop = efreet_desktop_get(ecore_file_file_get(line));
+   // look uop by id
+   if (!desktop)
+     desktop = efreet_util_desktop_file_id_find(ecore_file_file_get(line));
+   return desktop;
+}
+
 static void
 _e_order_read(E_Order *eo)
 {
    char *dir, *s, *s2, buf[4096], buf2[8192];
-   Efreet_Desktop *desktop;
    Eina_List *files, *l;
+   Eina_Hash *listed;
    size_t len;
    FILE *f;
 
+   _e_order_entries_free(eo);
    E_FREE_LIST(eo->desktops, efreet_desktop_free);
    if (!eo->path) return;
 
@@ -281,6 +392,8 @@ _e_order_read(E_Order *eo)
    if (!dir) return;
 
    files = ecore_file_ls(dir);
+   /* names from the dir that the .order file already lists */
+   listed = eina_hash_string_superfast_new(NULL);
 
    f = fopen(eo->path, "rb");
    if (!f) goto err;
@@ -295,53 +408,65 @@ _e_order_read(E_Order *eo)
              len--;
           }
         if (len == 0) continue;
-        // if full path - use that first
-        desktop = NULL;
-        if (buf[0] == '/')
-          desktop = efreet_desktop_get(buf);
-        else
-          {
-             // /path/to/dir/filename.desktop (buf)
-             snprintf(buf2, sizeof(buf2), "%s/%s", dir, buf);
-             // remove file if its in the dir already
-             EINA_LIST_FOREACH(files, l, s)
-               {
-                  if ((!strcmp(s, buf)) || (!strcmp(s, buf2)))
-                    {
-                       files = eina_list_remove_list(files, l);
-                       free(s);
-                       break;
-                    }
-               }
-             // desktop file in the order dir first
-             if (!desktop)
-               desktop = efreet_desktop_get(buf2);
-             // ignore any path elements and look up just filename
-             if (!desktop)
-               desktop = efreet_desktop_get(ecore_file_file_get(buf));
-             // look uop by id
-             if (!desktop)
-               desktop = efreet_util_desktop_file_id_find(ecore_file_file_get(buf));
-          }
-        // if we found it - append.
-        if (desktop)
-          eo->desktops = eina_list_append(eo->desktops, desktop);
+        // skip file later if its in the dir already
+        if (buf[0] != '/') eina_hash_set(listed, buf, (void *)1);
+        _e_order_entry_add(eo, buf, _e_order_entry_resolve(dir, buf));
      }
    fclose(f);
 err:
    EINA_LIST_FOREACH(files, l, s)
      {
         if (s[0] == '.') continue;
+        if (eina_hash_find(listed, s)) continue;
         s2 = strchr(s, '.');
         if (!s2) continue;
         if (!(!strcasecmp(s2, ".desktop"))) continue;
         snprintf(buf2, sizeof(buf2), "%s/%s", dir, s);
-        desktop = efreet_desktop_get(buf2);
-        if (desktop)
-          eo->desktops = eina_list_append(eo->desktops, desktop);
+        _e_order_entry_add(eo, buf2, efreet_desktop_get(buf2));
      }
    free(dir);
+   eina_hash_free(listed);
    EINA_LIST_FREE(files, s) free(s);
+   _e_order_desktops_set(eo);
+}
+
+/* after an efreet cache update only look up again what may resolve
+ * differently - lines that found nothing, and desktops whose file is gone
+ * or newer than when it was loaded. the .order file itself is unchanged,
+ * the monitor re-reads it when it isn't */
+static Eina_Bool
+_e_order_refresh(E_Order *eo)
+{
+   Eina_List *l;
+   E_Order_Entry *ent;
+   Efreet_Desktop *desktop;
+   char *dir = NULL;
+   long long mtime;
+   Eina_Bool changed = EINA_FALSE;
+
+   EINA_LIST_FOREACH(eo->entries, l, ent)
+     {
+        if (ent->desktop)
+          {
+             mtime = ecore_file_mod_time(ent->desktop->orig_path);
+             if ((mtime > 0) && (mtime <= ent->desktop->load_time)) continue;
+          }
+        if ((!dir) && (eo->path))
+          dir = ecore_file_dir_get(eo->path);
+        if (!dir) break;
+        desktop = _e_order_entry_resolve(dir, ent->line);
+        if (desktop == ent->desktop)
+          {
+             if (desktop) efreet_desktop_free(desktop);
+             continue;
+          }
+        if (ent->desktop) efreet_desktop_free(ent->desktop);
+        ent->desktop = desktop;
+        changed = EINA_TRUE;
+     }
+   free(dir);
+   if (changed) _e_order_desktops_set(eo);
+   return changed;
 }
 
 static void
@@ -349,22 +474,15 @@ _e_order_save(E_Order *eo)
 {
    FILE *f;
    Eina_List *l;
-   Efreet_Desktop *desktop;
+   E_Order_Entry *ent;
 
    if (!eo->path) return;
+   _e_order_entries_sync(eo);
    f = fopen(eo->path, "wb");
    if (!f) return;
 
-   EINA_LIST_FOREACH(eo->desktops, l, desktop)
-     {
-        const char *id;
-
-        id = efreet_util_path_to_file_id(desktop->orig_path);
-        if (id)
-          fprintf(f, "%s\n", id);
-        else
-          fprintf(f, "%s\n", desktop->orig_path);
-     }
+   EINA_LIST_FOREACH(eo->entries, l, ent)
+     fprintf(f, "%s\n", ent->line);
 
    fclose(f);
 }
@@ -375,12 +493,124 @@ _e_order_cb_efreet_cache_update(void *data EINA_UNUSED, int ev_type EINA_UNUSED,
    Eina_List *l;
    E_Order *eo;
 
-   /* reread all .order files */
+   /* users only hear about what changed */
    EINA_LIST_FOREACH(orders, l, eo)
      {
-        _e_order_read(eo);
-        if (eo->cb.update) eo->cb.update(eo->cb.data, eo);
+        if (_e_order_refresh(eo)) _e_order_notify(eo);
      }
    return ECORE_CALLBACK_PASS_ON;
 }
 
+
+static void
+_e_order_shown_set(E_Order *eo)
+{
+   Eina_List *l;
+   Efreet_Desktop *desktop;
+
+   E_FREE_LIST(eo->shown, efreet_desktop_free);
+   EINA_LIST_FOREACH(eo->desktops, l, desktop)
+     {
+        efreet_desktop_ref(desktop);
+        eo->shown = eina_list_append(eo->shown, desktop);
+     }
+}
+
+static Eina_Bool
+_e_order_changed(E_Order *eo)
+{
+   Eina_List *l, *ll;
+
+   if (eina_list_count(eo->shown) != eina_list_count(eo->desktops))
+     return EINA_TRUE;
+   for (l = eo->shown, ll = eo->desktops; l && ll;
+        l = eina_list_next(l), ll = eina_list_next(ll))
+     {
+        if (eina_list_data_get(l) != eina_list_data_get(ll))
+          return EINA_TRUE;
+     }
+   return EINA_FALSE;
+}
+
+static Eina_Hash *
+_e_order_path_hash(Eina_List *desktops)
+{
+   Eina_Hash *hash;
+   Eina_List *l;
+   Efreet_Desktop *desktop;
+
+   hash = eina_hash_string_superfast_new(NULL);
+   EINA_LIST_FOREACH(desktops, l, desktop)
+     {
+        if ((!desktop->orig_path) || (eina_hash_find(hash, desktop->orig_path)))
+          {
+             eina_hash_free(hash);
+             return NULL;
+          }
+        eina_hash_add(hash, desktop->orig_path, desktop);
+     }
+   return hash;
+}
+
+static Eina_Bool
+_e_order_changes_emit(E_Order *eo)
+{
+   Eina_Hash *old, *cur;
+   Eina_List *l, *pending = NULL;
+   Efreet_Desktop *desktop, *od, *prev = NULL;
+   void *data = eo->cb.change_data;
+
+   /* a file listed twice can't be followed by path */
+   old = _e_order_path_hash(eo->shown);
+   if (!old) return EINA_FALSE;
+   cur = _e_order_path_hash(eo->desktops);
+   if (!cur)
+     {
+        eina_hash_free(old);
+        return EINA_FALSE;
+     }
+
+   EINA_LIST_FOREACH(eo->shown, l, od)
+     {
+        if (!eina_hash_find(cur, od->orig_path))
+          eo->cb.change(data, eo, E_ORDER_CHANGE_DEL, od, NULL);
+        else
+          pending = eina_list_append(pending, od);
+     }
+   /* walk the new order; pending holds the old entries not placed yet in
+    * their old order, so its head is what currently follows prev */
+   EINA_LIST_FOREACH(eo->desktops, l, desktop)
+     {
+        od = eina_hash_find(old, desktop->orig_path);
+        if (!od)
+          eo->cb.change(data, eo, E_ORDER_CHANGE_ADD, desktop, prev);
+        else
+          {
+             if (od != desktop)
+               eo->cb.change(data, eo, E_ORDER_CHANGE_DESKTOP, desktop, od);
+             if (eina_list_data_get(pending) == od)
+               pending = eina_list_remove_list(pending, pending);
+             else
+               {
+                  eo->cb.change(data, eo, E_ORDER_CHANGE_MOVE, desktop, prev);
+                  pending = eina_list_remove(pending, od);
+               }
+          }
+        prev = desktop;
+     }
+   eina_list_free(pending);
+   eina_hash_free(cur);
+   eina_hash_free(old);
+   return EINA_TRUE;
+}
+
+static void
+_e_order_notify(E_Order *eo)
+{
+   if (!_e_order_changed(eo)) return;
+   if ((!eo->cb.change) || (!_e_order_changes_emit(eo)))
+     {
+        if (eo->cb.update) eo->cb.update(eo->cb.data, eo);
+     }
+   _e_order_shown_set(eo);
+}
@@ -8,18 +8,30 @@ typedef struct _E_Order        E_Order;
 
 #define E_ORDER_TYPE 0xE0b01020
 
+typedef enum
+{
+   E_ORDER_CHANGE_ADD, /* desktop was added after other (NULL: at the start) */
+   E_ORDER_CHANGE_DEL, /* desktop was removed */
+   E_ORDER_CHANGE_MOVE, /* desktop now follows other (NULL: at the start) */
+   E_ORDER_CHANGE_DESKTOP /* desktop replaces other for the same file */
+} E_Order_Change;
+
 struct _E_Order
 {
    E_Object            e_obj_inherit;
 
    const char         *path;
    Eina_List          *desktops; /* A list of Efreet_Desktop files this .order contains */
+   Eina_List          *shown; /* desktops as of the last callback, to diff against */
+   Eina_List          *entries; /* each line of the file and what it resolved to */
    Ecore_File_Monitor *monitor; /* Check for changes int the .order file */
    Ecore_Timer        *delay;
 
    struct {
 	void (*update)(void *data, E_Order *eo);
 	void *data;
+	void (*change)(void *data, E_Order *eo, E_Order_Change change, Efreet_Desktop *desktop, Efreet_Desktop *other);
+	void *change_data;
    } cb;
 };
 
@@ -28,6 +40,7 @@ EINTERN int e_order_shutdown(void);
 
 E_API E_Order *e_order_new(const char *path);
 E_API void     e_order_update_callback_set(E_Order *eo, void (*cb)(void *data, E_Order *eo), void *data);
+E_API void     e_order_change_callback_set(E_Order *eo, void (*cb)(void *data, E_Order *eo, E_Order_Change change, Efreet_Desktop *desktop, Efreet_Desktop *other), void *data);
 
 E_API void e_order_remove(E_Order *eo, Efreet_Desktop *desktop);
 E_API void e_order_append(E_Order *eo, Efreet_Desktop *desktop);
@@ -883,27 +883,9 @@ e_pixmap_image_clear(E_Pixmap *cp, Eina_Bool cache)
         _e_pixmap_wl_buffers_free(cp);
         if (cache)
           {
-             E_Comp_Wl_Client_Data *cd;
-             struct wl_resource *cb;
-             Eina_List *free_list;
-             double t;
-
              if ((!cp->client) || (!cp->client->comp_data)) return;
 
-             cd = (E_Comp_Wl_Client_Data *)cp->client->comp_data;
-
-             /* The destroy callback will remove items from the frame list
-              * so we move the list to a temporary before walking it here
-              */
-             free_list = cd->frames;
-             cd->frames = NULL;
-             t = ecore_loop_time_get();
-             EINA_LIST_FREE(free_list, cb)
-               {
-//                  printf("E: frame request: %p [%ix%i] %1.5f @ %1.5f\n", cp, cp->w, cp->h, t, ecore_time_get());
-                  wl_callback_send_done(cb, t * 1000);
-                  wl_resource_destroy(cb);
-               }
+             e_comp_wl_frames_done(cp->client, ecore_loop_time_get());
           }
 #endif
         break;
@@ -1,6 +1,10 @@
 #include <Elementary.h>
 #include "config.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+#include <limits.h>
+
 // a set of commonly found resolution buckets to try size the image down
 // to to match width OR height so we can avoid decoding a larger image from
 // disk making startup time faster by picking the right res that's encoded
@@ -72,7 +76,7 @@ static const int resolutions[] =
 #define ETC1 -1
 #define ETC2 -2
 
-static Evas_Object *win = NULL, *subwin = NULL, *image = NULL, *rend = NULL;
+static Evas_Object *win = NULL, *image = NULL;
 
 typedef struct
 {
@@ -92,15 +96,7 @@ _resolutions_calc(int w, int h)
      {
         nh = resolutions[i + 1];
         nw = (w * nh) / h;
-        if ((nh >= h) || (nw >= w))
-          {
-             mips[j].from_w = pw;
-             mips[j].from_h = ph;
-             mips[j].to_w = 1000000000;
-             mips[j].to_h = 1000000000;
-             mips[j].last = EINA_TRUE;
-             break;
-          }
+        if ((nh >= h) || (nw >= w)) break;
 
         mips[j].from_w = pw;
         mips[j].from_h = ph;
@@ -111,9 +107,429 @@ _resolutions_calc(int w, int h)
         pw = nw + 1;
         ph = nh + 1;
      }
+   // the original is always the top level - also when it is bigger than
+   // anything in the table
+   mips[j].from_w = pw;
+   mips[j].from_h = ph;
+   mips[j].to_w = 1000000000;
+   mips[j].to_h = 1000000000;
+   mips[j].last = EINA_TRUE;
    return mips;
 }
 
+// each scaled level is produced from the nearest larger one (the biggest
+// from the original image) instead of from the full size source every time.
+// a level is cut into bands of rows that are scaled in parallel on the
+// ecore thread pool and the png for a level is written out in the main loop
+// while the next smaller level is already being scaled
+typedef struct
+{
+   int          start, count;
+   unsigned int first, last; // 16.16 coverage of the span edge pixels
+} Span;
+
+typedef struct _Level Level;
+
+struct _Level
+{
+   Level        *src;
+   unsigned int *pixels;
+   Span         *xspans, *yspans;
+   int           w, h, stride;
+   Eina_Bool     last : 1;
+};
+
+typedef struct
+{
+   Level *level;
+   int    y0, y1;
+} Band;
+
+static Level *levels = NULL;
+static const char *levels_dir = NULL;
+static int levels_cur = 0;
+static int bands_pending = 0;
+static Eina_Bool levels_failed = EINA_FALSE;
+static Eina_Bool levels_done = EINA_FALSE;
+static Eina_Bool levels_loop = EINA_FALSE;
+
+static Span *
+_spans_calc(int src, int dst)
+{
+   Span *spans = malloc(sizeof(Span) * dst);
+   unsigned long long f0, f1;
+   int i;
+
+   if (!spans) return NULL;
+   for (i = 0; i < dst; i++)
+     {
+        f0 = (((unsigned long long)i * src) << 16) / dst;
+        f1 = (((unsigned long long)(i + 1) * src) << 16) / dst;
+        if (f1 <= f0) f1 = f0 + 1;
+        spans[i].start = f0 >> 16;
+        spans[i].count = ((f1 - 1) >> 16) - spans[i].start + 1;
+        if (spans[i].count == 1)
+          spans[i].first = spans[i].last = f1 - f0;
+        else
+          {
+             spans[i].first = (((unsigned long long)spans[i].start + 1) << 16) - f0;
+             spans[i].last = f1 - (((f1 - 1) >> 16) << 16);
+          }
+     }
+   return spans;
+}
+
+static inline unsigned long long
+_span_weight(const Span *s, int i)
+{
+   if (i == 0) return s->first;
+   if (i == (s->count - 1)) return s->last;
+   return 1 << 16;
+}
+
+static void
+_scale_band(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   Band *b = data;
+   Level *lv = b->level, *src = lv->src;
+   const unsigned int *row, *sp;
+   unsigned int *dp;
+   unsigned long long a, r, g, bl, tot, wy, wt;
+   const Span *sx, *sy;
+   int x, y, i, j;
+
+   // plain area averaging of premultiplied argb - the weights of every
+   // source pixel are how much of it the destination pixel covers
+   for (y = b->y0; y < b->y1; y++)
+     {
+        sy = &(lv->yspans[y]);
+        dp = lv->pixels + ((size_t)y * lv->stride);
+        for (x = 0; x < lv->w; x++)
+          {
+             sx = &(lv->xspans[x]);
+             a = r = g = bl = tot = 0;
+             for (j = 0; j < sy->count; j++)
+               {
+                  row = src->pixels +
+                    ((size_t)(sy->start + j) * src->stride) + sx->start;
+                  wy = _span_weight(sy, j);
+                  for (i = 0; i < sx->count; i++)
+                    {
+                       wt = wy * _span_weight(sx, i);
+                       sp = row + i;
+                       a  += ((*sp >> 24)       ) * wt;
+                       r  += ((*sp >> 16) & 0xff) * wt;
+                       g  += ((*sp >> 8)  & 0xff) * wt;
+                       bl += ((*sp)       & 0xff) * wt;
+                       tot += wt;
+                    }
+               }
+             dp[x] = ((unsigned int)((a  + (tot / 2)) / tot) << 24) |
+                     ((unsigned int)((r  + (tot / 2)) / tot) << 16) |
+                     ((unsigned int)((g  + (tot / 2)) / tot) << 8) |
+                     ((unsigned int)((bl + (tot / 2)) / tot));
+          }
+     }
+}
+
+static void
+_levels_finish(void)
+{
+   levels_done = EINA_TRUE;
+   if (levels_loop) ecore_main_loop_quit();
+}
+
+static Eina_Bool
+_level_save(Level *lv)
+{
+   Evas_Object *o;
+   char buf[256];
+   Eina_Bool ok;
+
+   if (lv->last)
+     {
+        snprintf(buf, sizeof(buf), "%s/img.png", levels_dir);
+        return evas_object_image_save(image, buf, NULL, "compress=0");
+     }
+   snprintf(buf, sizeof(buf), "%s/img-%ix%i.png", levels_dir, lv->w, lv->h);
+   o = evas_object_image_add(evas_object_evas_get(win));
+   evas_object_image_colorspace_set(o, EVAS_COLORSPACE_ARGB8888);
+   evas_object_image_alpha_set(o, evas_object_image_alpha_get(image));
+   evas_object_image_size_set(o, lv->w, lv->h);
+   evas_object_image_data_copy_set(o, lv->pixels);
+   ok = evas_object_image_save(o, buf, NULL, "compress=0");
+   evas_object_del(o);
+   return ok;
+}
+
+static void _scale_band_end(void *data, Ecore_Thread *th);
+static void _scale_band_cancel(void *data, Ecore_Thread *th);
+
+static Eina_Bool
+_level_start(Level *lv)
+{
+   Band *b;
+   int i, n, rows;
+
+   lv->pixels = malloc((size_t)lv->w * lv->h * sizeof(unsigned int));
+   lv->xspans = _spans_calc(lv->src->w, lv->w);
+   lv->yspans = _spans_calc(lv->src->h, lv->h);
+   if ((!lv->pixels) || (!lv->xspans) || (!lv->yspans)) return EINA_FALSE;
+
+   n = eina_cpu_count();
+   if (n > ecore_thread_max_get()) n = ecore_thread_max_get();
+   if (n > lv->h) n = lv->h;
+   if (n < 1) n = 1;
+   rows = (lv->h + n - 1) / n;
+   n = (lv->h + rows - 1) / rows;
+   // count all bands up front - a band may finish before the next is queued
+   bands_pending = n;
+   for (i = 0; i < n; i++)
+     {
+        b = calloc(1, sizeof(Band));
+        if (!b)
+          {
+             levels_failed = EINA_TRUE;
+             bands_pending -= n - i;
+             return bands_pending > 0;
+          }
+        b->level = lv;
+        b->y0 = i * rows;
+        b->y1 = b->y0 + rows;
+        if (b->y1 > lv->h) b->y1 = lv->h;
+        ecore_thread_run(_scale_band, _scale_band_end, _scale_band_cancel, b);
+     }
+   return EINA_TRUE;
+}
+
+static void
+_level_done(void)
+{
+   Level *lv = &(levels[levels_cur]);
+
+   free(lv->xspans);
+   free(lv->yspans);
+   lv->xspans = lv->yspans = NULL;
+   if (levels_failed)
+     {
+        _levels_finish();
+        return;
+     }
+   // get the threads onto the next level before writing this one out
+   if (levels_cur > 0)
+     {
+        levels_cur--;
+        if (!_level_start(&(levels[levels_cur])))
+          {
+             levels_failed = EINA_TRUE;
+             if (bands_pending <= 0) _levels_finish();
+          }
+     }
+   if (!_level_save(lv)) levels_failed = EINA_TRUE;
+   // the larger level this one was scaled from is not needed any more
+   if (!lv->src->last)
+     {
+        free(lv->src->pixels);
+        lv->src->pixels = NULL;
+     }
+   if (lv == levels) _levels_finish();
+}
+
+static void
+_scale_band_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   free(data);
+   if (--bands_pending > 0) return;
+   _level_done();
+}
+
+static void
+_scale_band_cancel(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   levels_failed = EINA_TRUE;
+   _scale_band_end(data, th);
+}
+
+static Eina_Bool
+_levels_run(const Mip *mips, int num, const char *dir, int w, int h)
+{
+   Level *src;
+   int i;
+
+   levels = calloc(num, sizeof(Level));
+   if (!levels) return EINA_FALSE;
+   levels_dir = dir;
+   src = &(levels[num - 1]);
+   src->w = w;
+   src->h = h;
+   src->stride = evas_object_image_stride_get(image) / sizeof(unsigned int);
+   src->pixels = evas_object_image_data_get(image, EINA_FALSE);
+   src->last = EINA_TRUE;
+   if ((!src->pixels) || (src->stride < w)) goto err;
+   for (i = 0; i < (num - 1); i++)
+     {
+        levels[i].src = &(levels[i + 1]);
+        levels[i].w = mips[i].to_w;
+        levels[i].h = mips[i].to_h;
+        levels[i].stride = levels[i].w;
+     }
+   if (num > 1)
+     {
+        levels_cur = num - 2;
+        if (!_level_start(&(levels[levels_cur])))
+          {
+             levels_failed = EINA_TRUE;
+             if (bands_pending <= 0) _levels_finish();
+          }
+     }
+   else levels_done = EINA_TRUE;
+   if (!_level_save(src)) levels_failed = EINA_TRUE;
+   if (!levels_done)
+     {
+        levels_loop = EINA_TRUE;
+        ecore_main_loop_begin();
+        levels_loop = EINA_FALSE;
+     }
+   for (i = 0; i < (num - 1); i++)
+     {
+        free(levels[i].pixels);
+        free(levels[i].xspans);
+        free(levels[i].yspans);
+     }
+   evas_object_image_data_set(image, src->pixels);
+   free(levels);
+   levels = NULL;
+   return !levels_failed;
+err:
+   if (src->pixels) evas_object_image_data_set(image, src->pixels);
+   free(levels);
+   levels = NULL;
+   return EINA_FALSE;
+}
+
+// the hash covers the image file content and every parameter that changes
+// the output, so importing the same picture again just reuses the edj that
+// was generated for it last time. the file is read in chunks and each
+// chunk is hashed together with the digest so far, so a huge image is
+// never held in memory in full
+#define HASH_CHUNK (1024 * 1024)
+
+static char *
+_content_hash(const char *file, const char *mode, int quality,
+              int r, int g, int b)
+{
+   FILE *f;
+   Eina_Binbuf *buf;
+   unsigned char digest[20], *chunk;
+   char params[256], *hash;
+   Eina_Bool ok = EINA_TRUE;
+   size_t len;
+   int i;
+
+   f = fopen(file, "rb");
+   if (!f) return NULL;
+   buf = eina_binbuf_new();
+   chunk = malloc(HASH_CHUNK);
+   if ((!buf) || (!chunk))
+     {
+        free(chunk);
+        if (buf) eina_binbuf_free(buf);
+        fclose(f);
+        return NULL;
+     }
+   memset(digest, 0, sizeof(digest));
+   while ((ok) && ((len = fread(chunk, 1, HASH_CHUNK, f)) > 0))
+     {
+        eina_binbuf_reset(buf);
+        eina_binbuf_append_length(buf, digest, sizeof(digest));
+        eina_binbuf_append_length(buf, chunk, len);
+        ok = emile_binbuf_sha1(buf, digest);
+     }
+   if (ferror(f)) ok = EINA_FALSE;
+   fclose(f);
+   free(chunk);
+   if (ok)
+     {
+        snprintf(params, sizeof(params), "\n%s %s %i %i %i %i",
+                 PACKAGE_VERSION, mode, quality, r, g, b);
+        eina_binbuf_reset(buf);
+        eina_binbuf_append_length(buf, digest, sizeof(digest));
+        eina_binbuf_append_length(buf, (const unsigned char *)params,
+                                  strlen(params));
+        ok = emile_binbuf_sha1(buf, digest);
+     }
+   eina_binbuf_free(buf);
+   if (!ok) return NULL;
+   hash = malloc((sizeof(digest) * 2) + 1);
+   if (!hash) return NULL;
+   for (i = 0; i < (int)sizeof(digest); i++)
+     snprintf(hash + (i * 2), 3, "%02x", digest[i]);
+   return hash;
+}
+
+static Eina_Bool
+_cache_file_get(char *buf, size_t size, const char *hash)
+{
+   const char *s;
+   int len, len2;
+
+   if ((s = getenv("XDG_CACHE_HOME")) && (s[0]))
+     len = snprintf(buf, size, "%s/enlightenment/wallpaper_gen", s);
+   else if ((s = getenv("HOME")) && (s[0]))
+     len = snprintf(buf, size, "%s/.cache/enlightenment/wallpaper_gen", s);
+   else return EINA_FALSE;
+   if ((len < 0) || ((size_t)len >= size)) return EINA_FALSE;
+   if (!hash) return EINA_TRUE;
+   len2 = snprintf(buf + len, size - len, "/%s.edj", hash);
+   return (len2 >= 0) && ((size_t)len2 < (size - len));
+}
+
+// cached edj files are hard links to the imported wallpapers, so once the
+// wallpaper itself is deleted the cache holds the only link and the entry
+// can go too - this keeps the cache from growing past what the user has
+static void
+_cache_prune(const char *dir)
+{
+   Eina_Iterator *it;
+   Eina_File_Direct_Info *info;
+   struct stat st;
+
+   it = eina_file_direct_ls(dir);
+   if (!it) return;
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        if (stat(info->path, &st) != 0) continue;
+        if ((S_ISREG(st.st_mode)) && (st.st_nlink <= 1))
+          unlink(info->path);
+     }
+   eina_iterator_free(it);
+}
+
+static Eina_Bool
+_cache_fetch(const char *hash, const char *outfile)
+{
+   char buf[PATH_MAX];
+
+   if (!_cache_file_get(buf, sizeof(buf), hash)) return EINA_FALSE;
+   if (!ecore_file_exists(buf)) return EINA_FALSE;
+   if (link(buf, outfile) == 0) return EINA_TRUE;
+   return ecore_file_cp(buf, outfile);
+}
+
+static void
+_cache_store(const char *hash, const char *outfile)
+{
+   char buf[PATH_MAX];
+
+   if (!_cache_file_get(buf, sizeof(buf), NULL)) return;
+   if (!ecore_file_mkpath(buf)) return;
+   _cache_prune(buf);
+   if (!_cache_file_get(buf, sizeof(buf), hash)) return;
+   unlink(buf);
+   // only ever link - a copy would never be pruned
+   link(outfile, buf);
+}
+
 EAPI int
 elm_main(int argc, char **argv)
 {
@@ -123,6 +539,7 @@ elm_main(int argc, char **argv)
    int bg_b = 64;
    char dir_buf[128], img_buf[256], edc_buf[256], cmd_buf[1024], qual_buf[64];
    const char *dir, *quality_string = NULL, *img_name = NULL;
+   char *hash = NULL;
    Mip *mips = NULL;
    int i, imw, imh, w, h, quality;
    int ret = 0, mips_num = 0;
@@ -163,11 +580,6 @@ elm_main(int argc, char **argv)
    elm_win_norender_push(win);
    evas_object_show(win);
 
-   subwin = elm_win_add(win, "inlined", ELM_WIN_INLINED_IMAGE);
-   rend = elm_win_inlined_image_object_get(subwin);
-   elm_win_norender_push(subwin);
-   evas_object_show(subwin);
-
    if (argc < 6) return 2;
    edje_cc = argv[1];
    mode = argv[2];
@@ -182,18 +594,6 @@ elm_main(int argc, char **argv)
         else if (quality > 100) quality = 100;
      }
 
-   image = evas_object_image_filled_add(evas_object_evas_get(subwin));
-   evas_object_image_file_set(image, file, NULL);
-   evas_object_image_size_get(image, &w, &h);
-   if ((w <= 0) || (h <= 0)) return 3;
-   alpha = evas_object_image_alpha_get(image);
-   elm_win_alpha_set(subwin, alpha);
-   evas_object_show(image);
-
-   snprintf(dir_buf, sizeof(dir_buf), "/tmp/e_bg-XXXXXX");
-   dir = mkdtemp(dir_buf);
-   if (!dir) return 4;
-
    if ((!strcmp(mode, "center")) ||
        (!strcmp(mode, "scale_in")))
      { // need backing rgb color here
@@ -202,50 +602,56 @@ elm_main(int argc, char **argv)
         bg_g = atoi(argv[7]);
         bg_b = atoi(argv[8]);
      }
+
+   hash = _content_hash(file, mode, quality, bg_r, bg_g, bg_b);
+   if ((hash) && (_cache_fetch(hash, outfile)))
+     {
+        free(hash);
+        evas_object_del(win);
+        return 0;
+     }
+
+   image = evas_object_image_filled_add(evas_object_evas_get(win));
+   evas_object_image_file_set(image, file, NULL);
+   evas_object_image_size_get(image, &w, &h);
+   if ((w <= 0) || (h <= 0))
+     {
+        free(hash);
+        return 3;
+     }
+   alpha = evas_object_image_alpha_get(image);
+
+   snprintf(dir_buf, sizeof(dir_buf), "/tmp/e_bg-XXXXXX");
+   dir = mkdtemp(dir_buf);
+   if (!dir)
+     {
+        free(hash);
+        return 4;
+     }
+
    if ((!strcmp(mode, "stretch")) ||
        (!strcmp(mode, "scale_in")) ||
        (!strcmp(mode, "scale_out")) ||
        (!strcmp(mode, "pan")))
      { // need to produce multiple scaled versions
         mips = _resolutions_calc(w, h);
-        if (!mips) return 6;
-        for (i = 0; mips[i].to_w; i++)
+        if (!mips)
           {
-             mips_num++;
-             if (mips[i].last)
-               {
-                  imw = w;
-                  imh = h;
-               }
-             else
-               {
-                  imw = mips[i].to_w;
-                  imh = mips[i].to_h;
-               }
-             evas_object_resize(subwin, imw, imh);
-             evas_object_resize(image, imw, imh);
-             elm_win_render(subwin);
-             if (mips[i].last)
-               snprintf(img_buf, sizeof(img_buf), "%s/img.png",
-                        dir);
-             else
-               snprintf(img_buf, sizeof(img_buf), "%s/img-%ix%i.png",
-                        dir, imw, imh);
-             if (!evas_object_image_save(rend, img_buf, NULL, "compress=0"))
-               {
-                  ret = 7;
-                  goto cleanup;
-               }
+             ret = 6;
+             goto cleanup;
+          }
+        for (mips_num = 0; mips[mips_num].to_w; mips_num++);
+        if (!_levels_run(mips, mips_num, dir, w, h))
+          {
+             ret = 7;
+             goto cleanup;
           }
      }
    // no multiple resolutions -0 save out original
    if (!mips)
      {
-        evas_object_resize(subwin, w, h);
-        evas_object_resize(image, w, h);
-        elm_win_render(subwin);
         snprintf(img_buf, sizeof(img_buf), "%s/img.png", dir);
-        if (!evas_object_image_save(rend, img_buf, NULL, "compress=0"))
+        if (!evas_object_image_save(image, img_buf, NULL, "compress=0"))
           {
              ret = 8;
              goto cleanup;
@@ -488,7 +894,9 @@ elm_main(int argc, char **argv)
         goto cleanup;
      }
    ret = system(cmd_buf);
+   if ((ret == 0) && (hash)) _cache_store(hash, outfile);
 cleanup:
+   free(hash);
    free(mips);
    ecore_file_recursive_rm(dir);
    evas_object_del(win);
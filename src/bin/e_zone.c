@@ -1466,6 +1466,7 @@ _e_zone_free(E_Zone *zone)
           }
      }
 
+   zone->sticky_clients = eina_list_free(zone->sticky_clients);
    /* free desks */
    for (x = 0; x < zone->desk_x_count; x++)
      {
@@ -56,6 +56,7 @@ struct _E_Zone
    int          desk_x_prev, desk_y_prev;
    E_Desk     **desks;
    Eina_Inlist *obstacles;
+   Eina_List   *sticky_clients;
 
    Eina_List   *handlers;
 
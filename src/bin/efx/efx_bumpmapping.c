@@ -1,34 +1,40 @@
 #include "e_efx_private.h"
 #include <math.h>
 
+#ifdef __SSE2__
+# include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+# include <arm_neon.h>
+# define BUMP_NEON 1
+#endif
+
 #define DATA8 unsigned char
 #define A_VAL(p) (((DATA8 *)(p))[3])
 #define R_VAL(p) (((DATA8 *)(p))[2])
 #define G_VAL(p) (((DATA8 *)(p))[1])
 #define B_VAL(p) (((DATA8 *)(p))[0])
+#define LUM(p) (A_VAL(p) * (R_VAL(p) + G_VAL(p) + B_VAL(p)))
 
-typedef struct E_Efx_Bumpmap_Data
+/* below this many pixels threads cost more than they save */
+#define BUMP_THREAD_MIN (256 * 256)
+#define BUMP_BAND_MIN 32
+
+typedef struct
 {
-   E_EFX *e;
    int x;
    int y;
    int z;
+   int z_2;
    int depth;
    int red;
    int green;
    int blue;
    int ambient;
-   unsigned int *img_data;
-} E_Efx_Bumpmap_Data;
+} E_Efx_Bumpmap_Params;
 
-static void
-_bumpmap(E_Efx_Bumpmap_Data *ebd)
+typedef struct E_Efx_Bumpmap_Data
 {
-   Evas_Object  *o;
-   int w;
-   int h;
-   int i, j;
-
+   E_EFX *e;
    int x;
    int y;
    int z;
@@ -37,104 +43,374 @@ _bumpmap(E_Efx_Bumpmap_Data *ebd)
    int green;
    int blue;
    int ambient;
+   unsigned int *img_data; /* untouched source image */
+   unsigned int *out; /* lit result, reused every pass */
+   int w, h;
+   int bands; /* bands of the current pass still running */
+   E_Efx_Bumpmap_Params p; /* parameters of the current pass */
+   Eina_Bool again : 1; /* light moved during the current pass */
+} E_Efx_Bumpmap_Data;
 
-   int z_2, lightx, lighty;
-   int mx;
-   int my;
-   unsigned int *d1;
-   unsigned int *src;
-   unsigned int *mp;
-   unsigned int *mpy;
-   unsigned int *mpp;
-
-   x = ebd->x;
-   y = ebd->y;
-   z = ebd->z;
-
-   red = ebd->red / 0x100;
-   green = ebd->green / 0x100;
-   blue = ebd->blue / 0x100;
-   ambient = ebd->ambient / 0x100;
-   depth = ebd->depth / 0x100;
-   depth /= (255 * (255 + 255 + 255));
-   z_2 = z * z;
-
-   o = ebd->e->obj;
-   evas_object_image_size_get(o, &w, &h);
-   if ((!w) || (!h)) return;
+typedef struct
+{
+   E_Efx_Bumpmap_Data *ebd;
+   int y0, y1;
+} E_Efx_Bumpmap_Band;
+
+static void _bumpmap(E_Efx_Bumpmap_Data *ebd);
 
-   d1 = malloc(w * h * sizeof(int));
-   memcpy(d1, ebd->img_data, w * h * sizeof(int));
-   src = d1;
+static inline int
+_bump_clamp(long long v)
+{
+   if (v < 0) return 0;
+   if (v > 255) return 255;
+   return v;
+}
 
-   mpp = ebd->img_data;
+static inline void
+_bump_normal(const E_Efx_Bumpmap_Params *p, const unsigned int *row, const unsigned int *down, int w, int cx, int ly, int *num, int *den)
+{
+   int gr, x1, y_1, lx, cr;
+
+   cr = (cx + 1 < w) ? cx + 1 : 0;
+   gr = LUM(&row[cx]);
+   y_1 = p->depth * (LUM(&down[cx]) - gr);
+   x1 = p->depth * (LUM(&row[cr]) - gr);
+   lx = cx - p->x;
+   *num = x1 * lx + y_1 * ly + p->z;
+   *den = ((x1 * x1) + (y_1 * y_1) + 1) * ((lx * lx) + (ly * ly) + p->z_2);
+}
+
+static inline unsigned int
+_bump_shade(const E_Efx_Bumpmap_Params *p, unsigned int s, double v)
+{
+   unsigned int d = s;
+   int r, g, b;
+
+   r = v * R_VAL(&s) * p->red;
+   g = v * G_VAL(&s) * p->green;
+   b = v * B_VAL(&s) * p->blue;
+   R_VAL(&d) = _bump_clamp(r);
+   G_VAL(&d) = _bump_clamp(g);
+   B_VAL(&d) = _bump_clamp(b);
+   return d;
+}
+
+#ifdef __SSE2__
+static inline __m128i
+_bump_mullo_sse2(__m128i a, __m128i b)
+{
+   /* sse2 has no 32bit mullo - the low halves of two 32x32->64 muls wrap
+    * exactly like the scalar int multiply */
+   __m128i ev = _mm_mul_epu32(a, b);
+   __m128i od = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
 
-   my = h;
-   lighty = -y;
-   for (j = h; --j >= 0;)
+   return _mm_unpacklo_epi32(_mm_shuffle_epi32(ev, _MM_SHUFFLE(0, 0, 2, 0)),
+                             _mm_shuffle_epi32(od, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline __m128i
+_bump_lum_sse2(const unsigned int *px)
+{
+   __m128i v = _mm_loadu_si128((const __m128i *)px);
+   __m128i m = _mm_set1_epi32(0xff), sum;
+
+   sum = _mm_add_epi32(_mm_and_si128(v, m),
+                       _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(v, 8), m),
+                                     _mm_and_si128(_mm_srli_epi32(v, 16), m)));
+   /* a and r + g + b both fit in the low 16 bits so madd is a plain mul */
+   return _mm_madd_epi16(_mm_srli_epi32(v, 24), sum);
+}
+
+/* _bump_normal() for pixels cx -> cx + 3, cx + 4 must still be in the row */
+static inline void
+_bump_normal4_sse2(const E_Efx_Bumpmap_Params *p, const unsigned int *row, const unsigned int *down, int cx, int ly, __m128i *num, __m128i *den)
+{
+   __m128i gr, x1, y_1, lx, lyv, depth;
+
+   depth = _mm_set1_epi32(p->depth);
+   gr = _bump_lum_sse2(row + cx);
+   y_1 = _bump_mullo_sse2(depth, _mm_sub_epi32(_bump_lum_sse2(down + cx), gr));
+   x1 = _bump_mullo_sse2(depth, _mm_sub_epi32(_bump_lum_sse2(row + cx + 1), gr));
+   lx = _mm_sub_epi32(_mm_setr_epi32(cx, cx + 1, cx + 2, cx + 3),
+                      _mm_set1_epi32(p->x));
+   lyv = _mm_set1_epi32(ly);
+   *num = _mm_add_epi32(_mm_add_epi32(_bump_mullo_sse2(x1, lx),
+                                      _bump_mullo_sse2(y_1, lyv)),
+                        _mm_set1_epi32(p->z));
+   *den = _bump_mullo_sse2
+     (_mm_add_epi32(_mm_add_epi32(_bump_mullo_sse2(x1, x1),
+                                  _bump_mullo_sse2(y_1, y_1)),
+                    _mm_set1_epi32(1)),
+      _mm_add_epi32(_mm_add_epi32(_bump_mullo_sse2(lx, lx),
+                                  _mm_set1_epi32(ly * ly)),
+                    _mm_set1_epi32(p->z_2)));
+}
+
+/* _bump_shade() for the 2 pixels whose normals are in the low lanes */
+static inline void
+_bump_shade2_sse2(const E_Efx_Bumpmap_Params *p, const unsigned int *src, unsigned int *dst, __m128i num, __m128i den)
+{
+   __m128d v, s, c;
+   __m128i ri, gi, bi;
+   int rr, gg, bb, k;
+
+   v = _mm_div_pd(_mm_cvtepi32_pd(num), _mm_sqrt_pd(_mm_cvtepi32_pd(den)));
+   v = _mm_add_pd(v, _mm_set1_pd(p->ambient));
+   /* packs + packus clamp to 0->255 like _bump_clamp() */
+# define CHAN(_val, _mul, _res) \
+   s = _mm_set_pd(_val(&src[1]), _val(&src[0])); \
+   c = _mm_mul_pd(_mm_mul_pd(v, s), _mm_set1_pd(_mul)); \
+   _res = _mm_cvttpd_epi32(c); \
+   _res = _mm_packs_epi32(_res, _res); \
+   _res = _mm_packus_epi16(_res, _res)
+   CHAN(R_VAL, p->red, ri);
+   CHAN(G_VAL, p->green, gi);
+   CHAN(B_VAL, p->blue, bi);
+# undef CHAN
+   rr = _mm_cvtsi128_si32(ri);
+   gg = _mm_cvtsi128_si32(gi);
+   bb = _mm_cvtsi128_si32(bi);
+   for (k = 0; k < 2; k++)
      {
-       mp = mpp;
-       mpp += w;
-       if (--my <= 0)
-         {
-           mpp -= w * h;
-           my = h;
-         }
-       mpy = mpp;
-       mx = w;
-       lightx = -x;
-       i = w - 1;
-       do
-         {
-            double v;
-            int r, g, b, gr, x1, y_1;
-
-            gr = A_VAL(mp) * (R_VAL(mp) + G_VAL(mp) + B_VAL(mp));
-            y_1 = depth * (A_VAL(mpy) * (R_VAL(mpy) +
-                                                G_VAL(mpy) +
-                                                B_VAL(mpy)) - gr);
-            mp++;
-            mpy++;
-            if (--mx <= 0)
-              {
-                mp -= w;
-                mpy -= w;
-                mx = w;
-              }
-            x1 = depth * (A_VAL(mp) * (R_VAL(mp) +
-                                           G_VAL(mp) + B_VAL(mp)) - gr);
-            v = x1 * lightx + y_1 * lighty + z;
-            v /= sqrt(((x1 * x1) + (y_1 * y_1) + 1) * ((lightx * lightx) + (lighty * lighty) + z_2));
-            v += ambient;
-            r = v * R_VAL(src) * red;
-            g = v * G_VAL(src) * green;
-            b = v * B_VAL(src) * blue;
-            if (r < 0)
-              r = 0;
-            else if (r > 255)
-              r = 255;
-            if (g < 0)
-              g = 0;
-            else if (g > 255)
-              g = 255;
-            if (b < 0)
-              b = 0;
-            else if (b > 255)
-              b = 255;
-            R_VAL(src) = r;
-            G_VAL(src) = g;
-            B_VAL(src) = b;
-
-            lightx++;
-            src++;
-         } while (--i >= 0);
-       lighty++;
+        unsigned int d = src[k];
+
+        R_VAL(&d) = (rr >> (k * 8)) & 0xff;
+        G_VAL(&d) = (gg >> (k * 8)) & 0xff;
+        B_VAL(&d) = (bb >> (k * 8)) & 0xff;
+        dst[k] = d;
      }
+}
+#elif defined(BUMP_NEON)
+static inline int32x4_t
+_bump_lum_neon(const unsigned int *px)
+{
+   uint32x4_t v = vld1q_u32(px), m = vdupq_n_u32(0xff), sum;
+
+   sum = vaddq_u32(vandq_u32(v, m),
+                   vaddq_u32(vandq_u32(vshrq_n_u32(v, 8), m),
+                             vandq_u32(vshrq_n_u32(v, 16), m)));
+   return vreinterpretq_s32_u32(vmulq_u32(vshrq_n_u32(v, 24), sum));
+}
+
+/* _bump_normal() for pixels cx -> cx + 3, cx + 4 must still be in the row.
+ * vmulq_s32 wraps like the scalar int multiply */
+static inline void
+_bump_normal4_neon(const E_Efx_Bumpmap_Params *p, const unsigned int *row, const unsigned int *down, int cx, int ly, int32x4_t *num, int32x4_t *den)
+{
+   static const int32_t step[4] = { 0, 1, 2, 3 };
+   int32x4_t gr, x1, y_1, lx, lyv, depth;
 
-   evas_object_image_data_set(o, d1);
+   depth = vdupq_n_s32(p->depth);
+   gr = _bump_lum_neon(row + cx);
+   y_1 = vmulq_s32(depth, vsubq_s32(_bump_lum_neon(down + cx), gr));
+   x1 = vmulq_s32(depth, vsubq_s32(_bump_lum_neon(row + cx + 1), gr));
+   lx = vaddq_s32(vld1q_s32(step), vdupq_n_s32(cx - p->x));
+   lyv = vdupq_n_s32(ly);
+   *num = vaddq_s32(vaddq_s32(vmulq_s32(x1, lx), vmulq_s32(y_1, lyv)),
+                    vdupq_n_s32(p->z));
+   *den = vmulq_s32(vaddq_s32(vaddq_s32(vmulq_s32(x1, x1), vmulq_s32(y_1, y_1)),
+                              vdupq_n_s32(1)),
+                    vaddq_s32(vaddq_s32(vmulq_s32(lx, lx), vdupq_n_s32(ly * ly)),
+                              vdupq_n_s32(p->z_2)));
+}
+
+/* _bump_shade() for 2 pixels */
+static inline void
+_bump_shade2_neon(const E_Efx_Bumpmap_Params *p, const unsigned int *src, unsigned int *dst, int32x2_t num, int32x2_t den)
+{
+   double vals[2];
+   float64x2_t v, s;
+   int64x2_t ri, gi, bi;
+   int k;
+
+   v = vdivq_f64(vcvtq_f64_s64(vmovl_s32(num)),
+                 vsqrtq_f64(vcvtq_f64_s64(vmovl_s32(den))));
+   v = vaddq_f64(v, vdupq_n_f64(p->ambient));
+# define CHAN(_val, _mul, _res) \
+   vals[0] = _val(&src[0]); vals[1] = _val(&src[1]); \
+   s = vld1q_f64(vals); \
+   _res = vcvtq_s64_f64(vmulq_f64(vmulq_f64(v, s), vdupq_n_f64(_mul)))
+   CHAN(R_VAL, p->red, ri);
+   CHAN(G_VAL, p->green, gi);
+   CHAN(B_VAL, p->blue, bi);
+# undef CHAN
+   for (k = 0; k < 2; k++)
+     {
+        unsigned int d = src[k];
+
+        R_VAL(&d) = _bump_clamp(k ? vgetq_lane_s64(ri, 1) : vgetq_lane_s64(ri, 0));
+        G_VAL(&d) = _bump_clamp(k ? vgetq_lane_s64(gi, 1) : vgetq_lane_s64(gi, 0));
+        B_VAL(&d) = _bump_clamp(k ? vgetq_lane_s64(bi, 1) : vgetq_lane_s64(bi, 0));
+        dst[k] = d;
+     }
+}
+#endif
+
+/* light rows y0 -> y1 of img into out. every pixel's normal comes from the
+ * pixel right of it and the one below it, wrapping at the edges. the vector
+ * paths work out normals 4 pixels at a time in wrapping int32 lanes and do
+ * the divide, sqrt and channel scaling 2 at a time with the same double
+ * precision ops as the scalar one, so the output is identical. the last few
+ * pixels of a row, where the right neighbour wraps, stay scalar */
+static void
+_bumpmap_rows(const E_Efx_Bumpmap_Params *p, const unsigned int *img, unsigned int *out, int w, int h, int y0, int y1)
+{
+   int ry, cx, num, den;
+
+   for (ry = y0; ry < y1; ry++)
+     {
+        const unsigned int *row = img + (ry * w);
+        const unsigned int *down = img + (((ry + 1) % h) * w);
+        unsigned int *dst = out + (ry * w);
+        int ly = ry - p->y;
+
+        cx = 0;
+#ifdef __SSE2__
+        for (; cx + 4 < w; cx += 4)
+          {
+             __m128i n4, d4;
+
+             _bump_normal4_sse2(p, row, down, cx, ly, &n4, &d4);
+             _bump_shade2_sse2(p, row + cx, dst + cx, n4, d4);
+             _bump_shade2_sse2(p, row + cx + 2, dst + cx + 2,
+                               _mm_srli_si128(n4, 8), _mm_srli_si128(d4, 8));
+          }
+#elif defined(BUMP_NEON)
+        for (; cx + 4 < w; cx += 4)
+          {
+             int32x4_t n4, d4;
+
+             _bump_normal4_neon(p, row, down, cx, ly, &n4, &d4);
+             _bump_shade2_neon(p, row + cx, dst + cx,
+                               vget_low_s32(n4), vget_low_s32(d4));
+             _bump_shade2_neon(p, row + cx + 2, dst + cx + 2,
+                               vget_high_s32(n4), vget_high_s32(d4));
+          }
+#endif
+        for (; cx < w; cx++)
+          {
+             double v;
+
+             _bump_normal(p, row, down, w, cx, ly, &num, &den);
+             v = num;
+             v /= sqrt(den);
+             v += p->ambient;
+             dst[cx] = _bump_shade(p, row[cx], v);
+          }
+     }
+}
+
+static void
+_bumpmap_apply(E_Efx_Bumpmap_Data *ebd)
+{
+   Evas_Object *o = ebd->e->obj;
+   unsigned int *d;
+   int w, h, stride, j;
+
+   evas_object_image_size_get(o, &w, &h);
+   if ((w != ebd->w) || (h != ebd->h)) return;
+   d = evas_object_image_data_get(o, EINA_TRUE);
+   if (!d) return;
+   stride = evas_object_image_stride_get(o) / sizeof(unsigned int);
+   if (stride < w) stride = w;
+   for (j = 0; j < h; j++)
+     memcpy(d + (j * stride), ebd->out + (j * w), w * sizeof(unsigned int));
+   evas_object_image_data_set(o, d);
    evas_object_image_data_update_add(o, 0, 0, w, h);
 }
 
+static void
+_bumpmap_band_run(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Efx_Bumpmap_Band *band = data;
+   E_Efx_Bumpmap_Data *ebd = band->ebd;
+
+   _bumpmap_rows(&ebd->p, ebd->img_data, ebd->out, ebd->w, ebd->h,
+                 band->y0, band->y1);
+}
+
+static void
+_bumpmap_band_end(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   E_Efx_Bumpmap_Band *band = data;
+   E_Efx_Bumpmap_Data *ebd = band->ebd;
+   Evas_Object *o = ebd->e->obj;
+
+   free(band);
+   if (--ebd->bands > 0) return;
+   _bumpmap_apply(ebd);
+   if (ebd->again)
+     {
+        ebd->again = EINA_FALSE;
+        _bumpmap(ebd);
+     }
+   evas_object_unref(o);
+}
+
+static void
+_bumpmap(E_Efx_Bumpmap_Data *ebd)
+{
+   E_Efx_Bumpmap_Band *band;
+   int n, i, rows;
+
+   if (ebd->bands)
+     {
+        ebd->again = EINA_TRUE;
+        return;
+     }
+   if ((!ebd->w) || (!ebd->h)) return;
+
+   ebd->p.x = ebd->x;
+   ebd->p.y = ebd->y;
+   ebd->p.z = ebd->z;
+   ebd->p.red = ebd->red / 0x100;
+   ebd->p.green = ebd->green / 0x100;
+   ebd->p.blue = ebd->blue / 0x100;
+   ebd->p.ambient = ebd->ambient / 0x100;
+   ebd->p.depth = ebd->depth / 0x100;
+   ebd->p.depth /= (255 * (255 + 255 + 255));
+   ebd->p.z_2 = ebd->z * ebd->z;
+
+   n = eina_cpu_count();
+   if (n > ebd->h / BUMP_BAND_MIN) n = ebd->h / BUMP_BAND_MIN;
+   if ((n < 2) || ((ebd->w * ebd->h) < BUMP_THREAD_MIN))
+     {
+        _bumpmap_rows(&ebd->p, ebd->img_data, ebd->out, ebd->w, ebd->h,
+                      0, ebd->h);
+        _bumpmap_apply(ebd);
+        return;
+     }
+
+   /* light horizontal bands of the image in parallel, then show the result
+    * once they are all done */
+   evas_object_ref(ebd->e->obj);
+   rows = (ebd->h + n - 1) / n;
+   for (i = 0; i < n; i++)
+     {
+        band = calloc(1, sizeof(E_Efx_Bumpmap_Band));
+        if (!band) break;
+        band->ebd = ebd;
+        band->y0 = i * rows;
+        band->y1 = MIN(ebd->h, (i + 1) * rows);
+        if (band->y0 >= band->y1)
+          {
+             free(band);
+             break;
+          }
+        ebd->bands++;
+        ecore_thread_run(_bumpmap_band_run, _bumpmap_band_end,
+                         _bumpmap_band_end, band);
+     }
+   if (!ebd->bands)
+     {
+        evas_object_unref(ebd->e->obj);
+        _bumpmap_rows(&ebd->p, ebd->img_data, ebd->out, ebd->w, ebd->h,
+                      0, ebd->h);
+        _bumpmap_apply(ebd);
+     }
+}
+
 EAPI Eina_Bool
 e_efx_bumpmap(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
 {
@@ -166,17 +442,28 @@ e_efx_bumpmap(Evas_Object *obj, Evas_Coord x, Evas_Coord y)
        unsigned int *m;
        int w;
        int h;
+       int stride;
+       int j;
 
        evas_object_image_size_get(obj, &w, &h);
-       m = (unsigned int *)evas_object_image_data_get(obj, 1);
+       m = (unsigned int *)evas_object_image_data_get(obj, 0);
        ebd->img_data = (unsigned int *)malloc(w * h * sizeof(unsigned int));
-       if (!ebd->img_data)
+       ebd->out = (unsigned int *)malloc(w * h * sizeof(unsigned int));
+       if ((!m) || (!ebd->img_data) || (!ebd->out))
          {
+           free(ebd->img_data);
+           free(ebd->out);
            free(ebd);
+           e->bumpmap_data = NULL;
            return EINA_FALSE;
          }
-       printf("memcpy\n");
-       memcpy(ebd->img_data, m, (w * h * sizeof(unsigned int)));
+       stride = evas_object_image_stride_get(obj) / sizeof(unsigned int);
+       if (stride < w) stride = w;
+       for (j = 0; j < h; j++)
+         memcpy(ebd->img_data + (j * w), m + (j * stride),
+                w * sizeof(unsigned int));
+       ebd->w = w;
+       ebd->h = h;
      }
 
    _bumpmap(ebd);
@@ -4,13 +4,19 @@ typedef struct
 {
    char *dev;
    int val, max, val_set, val_get_count;
+   int fd; // brightness file kept open while fading
+   int fade_from, fade_to; // 0->1000
+   double fade_start, fade_len;
    Eina_Bool prefer : 1;
    Eina_Bool set : 1;
+   Eina_Bool fade : 1;
+   Eina_Bool fade_done : 1;
 } Light;
 
 static Eina_Lock _devices_lock;
 static Eina_List *_devices = NULL;
 static Eina_Semaphore _worker_sem;
+static Ecore_Timer *_fade_timer = NULL;
 
 static void
 _light_set(Light *lig, int val)
@@ -22,14 +28,19 @@ _light_set(Light *lig, int val)
 #ifdef HAVE_EEZE
    char buf[PATH_MAX];
    snprintf(buf, sizeof(buf), "%s/brightness", lig->dev);
-   int fd = open(buf, O_WRONLY);
-   if (fd >= 0)
+   if (lig->fd < 0) lig->fd = open(buf, O_WRONLY | O_CLOEXEC);
+   if (lig->fd >= 0)
      {
         char buf2[32];
         snprintf(buf2, sizeof(buf2), "%i", lig->val);
-        if (write(fd, buf2, strlen(buf2)) <= 0)
+        if (pwrite(lig->fd, buf2, strlen(buf2), 0) <= 0)
           ERR("Write failed of [%s] to [%s]\n", buf2, buf);
-        close(fd);
+        // only keep it open for the many writes of a fade
+        if (!lig->fade)
+          {
+             close(lig->fd);
+             lig->fd = -1;
+          }
      }
 #elif defined(__FreeBSD_kernel__)
    sysctlbyname(lig->dev, NULL, NULL, &(lig->val), sizeof(lig->val));
@@ -92,6 +103,24 @@ _cb_worker(void *data EINA_UNUSED, Ecore_Thread *th)
                   lig->val = lig->val_set;
                   _light_set(lig, lig->val);
                }
+             if (lig->fade_done)
+               {
+                  Light *lig2 = calloc(1, sizeof(Light));
+
+                  lig->fade_done = EINA_FALSE;
+                  if (lig2)
+                    {
+                       lig2->dev = strdup(lig->dev);
+                       lig2->max = lig->max;
+                       lig2->fade_done = EINA_TRUE;
+                       if (lig2->dev)
+                         {
+                            lig2->val = lig->val;
+                            ecore_thread_feedback(th, lig2);
+                         }
+                       else free(lig2);
+                    }
+               }
           }
         eina_lock_release(&_devices_lock);
      }
@@ -109,7 +138,10 @@ _cb_worker_message(void *data EINA_UNUSED, Ecore_Thread *th EINA_UNUSED, void *m
         if (val < 0) val = 0;
         else if (val > 1000) val = 1000;
      }
-   e_system_inout_command_send("bklight-val", "%s %i", lig->dev, val);
+   if (lig->fade_done)
+     e_system_inout_command_send("bklight-fade", "%s %i", lig->dev, val);
+   else
+     e_system_inout_command_send("bklight-val", "%s %i", lig->dev, val);
    free(lig->dev);
    free(lig);
 }
@@ -133,6 +165,7 @@ _light_add(const char *dev)
    lig->dev = strdup(dev);
    if (!lig->dev) abort();
    lig->val = -1; // unknown
+   lig->fd = -1;
 #ifdef HAVE_EEZE
    const char *s;
 
@@ -190,6 +223,10 @@ _light_refresh_devices()
 
    EINA_LIST_FREE(_devices, lig)
      {
+        // the fade can't finish now, so tell whoever asked for it
+        if ((lig->fade) || (lig->fade_done))
+          e_system_inout_command_send("bklight-fade", "%s -1", lig->dev);
+        if (lig->fd >= 0) close(lig->fd);
         free(lig->dev);
         free(lig);
      }
@@ -303,6 +340,7 @@ _cb_bklight_set(void *data EINA_UNUSED, const char *params)
    eina_lock_take(&_devices_lock);
    lig = _light_find(dev);
    if (!lig) goto done;
+   lig->fade = EINA_FALSE; // an explicit set stops any fade
    lig->val_set = val;
    lig->set = EINA_TRUE;
    eina_semaphore_release(&_worker_sem, 1);
@@ -310,6 +348,67 @@ done:
    eina_lock_release(&_devices_lock);
 }
 
+static Eina_Bool
+_cb_fade_timer(void *data EINA_UNUSED)
+{
+   Eina_List *l;
+   Light *lig;
+   double t = ecore_time_get(), pos;
+   Eina_Bool more = EINA_FALSE;
+
+   eina_lock_take(&_devices_lock);
+   EINA_LIST_FOREACH(_devices, l, lig)
+     {
+        if (!lig->fade) continue;
+        if (lig->fade_len > 0.0) pos = (t - lig->fade_start) / lig->fade_len;
+        else pos = 1.0;
+        if (pos >= 1.0)
+          { // last write of this fade - the worker replies after it
+             pos = 1.0;
+             lig->fade = EINA_FALSE;
+             lig->fade_done = EINA_TRUE;
+          }
+        else more = EINA_TRUE;
+        pos = ecore_animator_pos_map(pos, ECORE_POS_MAP_DECELERATE, 0.0, 0.0);
+        lig->val_set = (lig->fade_from * (1.0 - pos)) + (lig->fade_to * pos);
+        lig->set = EINA_TRUE;
+        eina_semaphore_release(&_worker_sem, 1);
+     }
+   eina_lock_release(&_devices_lock);
+   if (more) return EINA_TRUE;
+   _fade_timer = NULL;
+   return EINA_FALSE;
+}
+
+static void
+_cb_bklight_fade(void *data EINA_UNUSED, const char *params)
+{ // "dev from to msec" - from/to 0->1000 - reply "dev val" when done or
+  // "dev -1" if dev is unknown or goes away before the fade ends
+   Light *lig;
+   char dev[1024] = "";
+   int from = 0, to = 0, msec = 0;
+
+   if (!params) return;
+   if (sscanf(params, "%1023s %i %i %i", dev, &from, &to, &msec) != 4) return;
+   eina_lock_take(&_devices_lock);
+   lig = _light_find(dev);
+   if (!lig)
+     {
+        e_system_inout_command_send("bklight-fade", "%s -1", dev);
+        goto done;
+     }
+   lig->fade_from = from;
+   lig->fade_to = to;
+   lig->fade_start = ecore_time_get();
+   lig->fade_len = (double)msec / 1000.0;
+   lig->fade_done = EINA_FALSE;
+   lig->fade = EINA_TRUE;
+   if (!_fade_timer)
+     _fade_timer = ecore_timer_add(1.0 / 60.0, _cb_fade_timer, NULL);
+done:
+   eina_lock_release(&_devices_lock);
+}
+
 void
 e_system_backlight_init(void)
 {
@@ -323,6 +422,7 @@ e_system_backlight_init(void)
    e_system_inout_command_register("bklight-refresh", _cb_bklight_refresh, NULL);
    e_system_inout_command_register("bklight-get",     _cb_bklight_get, NULL);
    e_system_inout_command_register("bklight-set",     _cb_bklight_set, NULL);
+   e_system_inout_command_register("bklight-fade",    _cb_bklight_fade, NULL);
 }
 
 void
@@ -14,10 +14,25 @@ typedef struct
    char *req, *params; // don't free - part of alloc for req struct at offset
 } Req;
 
+typedef struct
+{
+   char *edid;
+   Eina_List *req; // pending val-set/get for this monitor - _devices_lock
+   Eina_Semaphore sem;
+} Mon;
+
+#define MON_MAX 32
+
 static Eina_Lock _devices_lock;
 static Eina_List *_devices = NULL;
 static Eina_List *_req = NULL;
 static Eina_Semaphore _worker_sem;
+// monitors each get their own worker so a slow one doesn't stall others.
+// display handles are shared by all of them and replaced on a probe, so
+// workers hold this for read while using a handle and probe for write
+static Eina_RWLock _ddc_lock;
+static Eina_Semaphore _ddc_ready_sem;
+static Eina_Hash *_monitors = NULL; // edid -> Mon, main loop only
 
 //////////////////////////////////////////////////////////////////////////////
 // needed ddc types
@@ -232,6 +247,7 @@ _ddc_probe(void)
    int i;
 
    if (!ddc_lib) return EINA_FALSE;
+   eina_rwlock_take_write(&_ddc_lock);
    eina_lock_take(&_devices_lock);
    EINA_LIST_FREE(_devices, d)
      {
@@ -294,8 +310,10 @@ _ddc_probe(void)
              else free(d);
           }
      }
+   eina_rwlock_release(&_ddc_lock);
    return EINA_TRUE;
 err:
+   eina_rwlock_release(&_ddc_lock);
    return EINA_FALSE;
 }
 
@@ -357,29 +375,11 @@ _request(const char *req, const char *params)
    eina_lock_take(&_devices_lock);
    EINA_LIST_FOREACH(_req, l, r2)
      {
-        if (!strcmp(r2->req, r->req))
+        if ((!strcmp(r2->req, r->req)) && (!strcmp(req, "refresh")))
           {
-             if (!strcmp(req, "refresh"))
-               {
-                  _req = eina_list_remove_list(_req, l);
-                  free(r2);
-                  break;
-               }
-             else if ((!strcmp(req, "val-set")) ||
-                      (!strcmp(req, "val-get")))
-               {
-                  if ((!strncmp(params, r2->params, 256)) &&
-                      (params[256] == ' '))
-                    {
-                       const char *space = strchr(params + 256 + 1, ' ');
-                       if (!strncmp(params, r2->params, (space - params)))
-                         {
-                            _req = eina_list_remove_list(_req, l);
-                            free(r2);
-                            break;
-                         }
-                    }
-               }
+             _req = eina_list_remove_list(_req, l);
+             free(r2);
+             break;
           }
      }
    _req = eina_list_append(_req, r);
@@ -387,6 +387,95 @@ _request(const char *req, const char *params)
    eina_lock_release(&_devices_lock);
 }
 
+static void _cb_mon_worker(void *data, Ecore_Thread *th);
+static void _cb_worker_message(void *data, Ecore_Thread *th, void *msg_data);
+static void _cb_worker_end(void *data, Ecore_Thread *th);
+static void _cb_worker_cancel(void *data, Ecore_Thread *th);
+
+static Mon *
+_mon_get(const char *edid)
+{
+   Mon *m;
+   int i;
+
+   m = eina_hash_find(_monitors, edid);
+   if (m) return m;
+   // only real edids get a worker - 128 bytes as hex
+   for (i = 0; edid[i]; i++)
+     {
+        if (!isxdigit((unsigned char)edid[i])) return NULL;
+     }
+   if (i != (128 * 2)) return NULL;
+   if (eina_hash_population(_monitors) >= MON_MAX) return NULL;
+   m = calloc(1, sizeof(Mon));
+   if (!m) return NULL;
+   m->edid = strdup(edid);
+   if (!m->edid)
+     {
+        free(m);
+        return NULL;
+     }
+   eina_semaphore_new(&m->sem, 0);
+   eina_hash_add(_monitors, m->edid, m);
+   ecore_thread_feedback_run(_cb_mon_worker, _cb_worker_message,
+                             _cb_worker_end, _cb_worker_cancel,
+                             m, EINA_TRUE);
+   return m;
+}
+
+static void
+_request_mon(const char *req, const char *params)
+{
+   Eina_List *l;
+   Mon *m;
+   Req *r2, *r;
+   int id = -1, id2, val;
+   char edid[257];
+
+   if (!params) params = "";
+   edid[0] = 0;
+   if (sscanf(params, "%256s %i", edid, &id) < 1) edid[0] = 0;
+   m = _mon_get(edid);
+   if (!m)
+     { // unknown monitor - nothing to queue this on so fail right away
+        if (!strcmp(req, "val-set"))
+          {
+             val = -1;
+             sscanf(params, "%*s %*i %i", &val);
+             e_system_inout_command_send("ddc-val-set", "%s %i %i err",
+                                         edid, id, val);
+          }
+        else
+          e_system_inout_command_send("ddc-val-get", "%s %i -1", edid, id);
+        return;
+     }
+   r = _req_alloc(req, params);
+   if (!r) return;
+
+   eina_lock_take(&_devices_lock);
+   EINA_LIST_FOREACH(m->req, l, r2)
+     {
+        if (strcmp(r2->req, r->req)) continue;
+        if (sscanf(r2->params, "%*s %i", &id2) != 1) continue;
+        if (id2 != id) continue;
+        // a set not yet done is replaced by the newer value where it
+        // was queued, a get is just moved to the end
+        if (!strcmp(req, "val-set"))
+          {
+             eina_list_data_set(l, r);
+             free(r2);
+             eina_lock_release(&_devices_lock);
+             return;
+          }
+        m->req = eina_list_remove_list(m->req, l);
+        free(r2);
+        break;
+     }
+   m->req = eina_list_append(m->req, r);
+   eina_semaphore_release(&m->sem, 1);
+   eina_lock_release(&_devices_lock);
+}
+
 static void
 _do_list(Ecore_Thread *th)
 {
@@ -442,6 +531,7 @@ _do_val_set(Ecore_Thread *th, const char *edid, int id, int val)
    Dev *d;
    Req *r;
    int screen;
+   Eina_Bool ok;
    char buf[512];
 
    if (!ddc_lib) goto err;
@@ -449,18 +539,22 @@ _do_val_set(Ecore_Thread *th, const char *edid, int id, int val)
    if (!_id_ok(id)) goto err;
    if ((val < 0) || (val >= 65536)) goto err;
 
+   eina_rwlock_take_read(&_ddc_lock);
    eina_lock_take(&_devices_lock);
    d = _dev_find(edid);
    if (!d)
      {
         eina_lock_release(&_devices_lock);
+        eina_rwlock_release(&_ddc_lock);
         goto err;
      }
    screen = d->screen;
    eina_lock_release(&_devices_lock);
 
-   if (ddc_func.ddca_set_non_table_vcp_value
-       (ddc_dh[screen], id, (val >> 8) & 0xff, val & 0xff) == 0)
+   ok = (ddc_func.ddca_set_non_table_vcp_value
+         (ddc_dh[screen], id, (val >> 8) & 0xff, val & 0xff) == 0);
+   eina_rwlock_release(&_ddc_lock);
+   if (ok)
      {
         fprintf(stderr, "DDC: set ok %s 0x%02x %i\n", edid, id, val);
         snprintf(buf, sizeof(buf), "%s %i %i ok", edid, id, val);
@@ -481,6 +575,7 @@ _do_val_get(Ecore_Thread *th, const char *edid, int id)
    Dev *d;
    Req *r;
    int screen, val;
+   Eina_Bool ok;
    char buf[512];
    DDCA_Non_Table_Vcp_Value valrec;
 
@@ -488,18 +583,22 @@ _do_val_get(Ecore_Thread *th, const char *edid, int id)
    if (!edid) goto err;
    if (!_id_ok(id)) goto err;
 
+   eina_rwlock_take_read(&_ddc_lock);
    eina_lock_take(&_devices_lock);
    d = _dev_find(edid);
    if (!d)
      {
         eina_lock_release(&_devices_lock);
+        eina_rwlock_release(&_ddc_lock);
         goto err;
      }
    screen = d->screen;
    eina_lock_release(&_devices_lock);
 
-   if (ddc_func.ddca_get_non_table_vcp_value
-       (ddc_dh[screen], id, &valrec) == 0)
+   ok = (ddc_func.ddca_get_non_table_vcp_value
+         (ddc_dh[screen], id, &valrec) == 0);
+   eina_rwlock_release(&_ddc_lock);
+   if (ok)
      {
         val = valrec.sl | (valrec.sh << 8);
         fprintf(stderr, "DDC: get ok %s 0x%02x = %i\n", edid, id, val);
@@ -521,6 +620,8 @@ _cb_worker(void *data EINA_UNUSED, Ecore_Thread *th)
    Req *r;
 
    _ddc_init();
+   // let monitor workers go now - they can't do anything before this
+   eina_semaphore_release(&_ddc_ready_sem, 1);
    _do_list(th);
 
    for (;;)
@@ -558,7 +659,34 @@ _cb_worker(void *data EINA_UNUSED, Ecore_Thread *th)
                   if (i == 10)
                     fprintf(stderr, "DDC: PROBE FAILED.\n");
                }
-             else if (!strcmp(r->req, "val-set"))
+             free(r);
+          }
+     }
+}
+
+static void
+_cb_mon_worker(void *data, Ecore_Thread *th)
+{
+   Mon *m = data;
+   Req *r;
+
+   // wait for the lib to be loaded and displays probed then pass it on
+   eina_semaphore_lock(&_ddc_ready_sem);
+   eina_semaphore_release(&_ddc_ready_sem, 1);
+
+   for (;;)
+     {
+        Eina_List *local_req;
+
+        // wait for requests
+        eina_semaphore_lock(&m->sem);
+        eina_lock_take(&_devices_lock);
+        local_req = m->req;
+        m->req = NULL;
+        eina_lock_release(&_devices_lock);
+        EINA_LIST_FREE(local_req, r)
+          {
+             if (!strcmp(r->req, "val-set"))
                {
                   int id, val;
                   char edid[257];
@@ -612,20 +740,23 @@ _cb_ddc_refresh(void *data EINA_UNUSED, const char *params)
 static void
 _cb_ddc_val_set(void *data EINA_UNUSED, const char *params)
 {
-   _request("val-set", params);
+   _request_mon("val-set", params);
 }
 
 static void
 _cb_ddc_val_get(void *data EINA_UNUSED, const char *params)
 {
-   _request("val-get", params);
+   _request_mon("val-get", params);
 }
 
 void
 e_system_ddc_init(void)
 {
    eina_lock_new(&_devices_lock);
+   eina_rwlock_new(&_ddc_lock);
    eina_semaphore_new(&_worker_sem, 0);
+   eina_semaphore_new(&_ddc_ready_sem, 0);
+   _monitors = eina_hash_string_superfast_new(NULL);
    ecore_thread_feedback_run(_cb_worker, _cb_worker_message,
                              _cb_worker_end, _cb_worker_cancel,
                              NULL, EINA_TRUE);
@@ -420,6 +420,7 @@ _gadget_window_show(Instance *inst)
       ec->netwm.state.skip_pager = 1;
       ec->netwm.state.skip_taskbar = 1;
       ec->sticky = 1;
+      e_desk_client_sticky_update(ec);
    }
 
    inst->hidden = EINA_FALSE;
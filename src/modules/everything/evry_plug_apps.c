@@ -727,11 +727,12 @@ _begin_mime(Evry_Plugin *plugin, const Evry_Item *item)
 
    EVRY_PLUGIN_INSTANCE(p, plugin);
 
-   p->apps_mime = efreet_util_desktop_mime_list(mime);
+   /* the app last chosen for this mime comes first */
+   p->apps_mime = e_exehist_mime_desktops_get(mime);
 
    if (strcmp(mime, "text/plain") && (!strncmp(mime, "text/", 5)))
      {
-        l = efreet_util_desktop_mime_list("text/plain");
+        l = e_exehist_mime_desktops_get("text/plain");
 
         EINA_LIST_FREE (l, d)
           {
@@ -744,7 +745,7 @@ _begin_mime(Evry_Plugin *plugin, const Evry_Item *item)
 
    if (item->browseable && strcmp(mime, "x-directory/normal"))
      {
-        l = efreet_util_desktop_mime_list("x-directory/normal");
+        l = e_exehist_mime_desktops_get("x-directory/normal");
 
         EINA_LIST_FREE (l, d)
           {
@@ -755,19 +756,6 @@ _begin_mime(Evry_Plugin *plugin, const Evry_Item *item)
           }
      }
 
-   if ((d = e_exehist_mime_desktop_get(mime)))
-     {
-        if ((l = eina_list_data_find_list(p->apps_mime, d)))
-          {
-             p->apps_mime = eina_list_promote_list(p->apps_mime, l);
-             efreet_desktop_free(d);
-          }
-        else
-          {
-             p->apps_mime = eina_list_prepend(p->apps_mime, d);
-          }
-     }
-
    p->added = eina_hash_string_small_new(_hash_free);
 
    return EVRY_PLUGIN(p);
@@ -1347,7 +1347,7 @@ _e_fwin_suggested_apps_list_get(Eina_List *files,
 
         EINA_ITERATOR_FOREACH(itr, mime)
           {
-             Eina_List *desktops = efreet_util_desktop_mime_list(mime);
+             Eina_List *desktops = e_exehist_mime_desktops_get(mime);
              Efreet_Desktop *d;
              Eina_Bool hd = EINA_FALSE;
 
@@ -113,6 +113,8 @@ static void         _ibar_icon_empty(IBar_Icon *ic);
 static void         _ibar_sep_create(IBar *b);
 static void         _ibar_icon_signal_emit(IBar_Icon *ic, const char *sig, const char *src);
 static void         _ibar_cb_app_change(void *data, E_Order *eo);
+static void         _ibar_icon_running_add(IBar *b, Efreet_Desktop *desktop);
+static void         _ibar_cb_app_change_item(void *data, E_Order *eo, E_Order_Change change, Efreet_Desktop *desktop, Efreet_Desktop *other);
 static void         _ibar_cb_obj_moveresize(void *data, Evas *e, Evas_Object *obj, void *event_info);
 static void         _ibar_cb_menu_icon_action_exec(void *data, E_Menu *m, E_Menu_Item *mi);
 static void         _ibar_cb_menu_icon_new(void *data, E_Menu *m, E_Menu_Item *mi);
@@ -172,6 +174,7 @@ _ibar_order_new(IBar *b, const char *path)
    io = E_NEW(IBar_Order, 1);
    io->eo = e_order_new(path);
    e_order_update_callback_set(io->eo, _ibar_cb_app_change, io);
+   e_order_change_callback_set(io->eo, _ibar_cb_app_change_item, io);
    eina_hash_add(ibar_orders, path, io);
    io->bars = eina_inlist_append(io->bars, EINA_INLIST_GET(b));
    return io;
@@ -188,6 +191,7 @@ _ibar_order_del(IBar *b)
    if (io->bars) return;
    eina_hash_del_by_key(ibar_orders, io->eo->path);
    e_order_update_callback_set(io->eo, NULL, NULL);
+   e_order_change_callback_set(io->eo, NULL, NULL);
    e_object_del(E_OBJECT(io->eo));
    free(io);
 }
@@ -1008,6 +1012,122 @@ _ibar_cb_app_change(void *data, E_Order *eo EINA_UNUSED)
      }
 }
 
+static void
+_ibar_icon_running_add(IBar *b, Efreet_Desktop *desktop)
+{
+   IBar_Icon *ic;
+   const Eina_List *l, *ll;
+   E_Exec_Instance *exe;
+   E_Client *ec;
+   Eina_Bool skip;
+
+   /* same as the second half of _ibar_fill() for one desktop */
+   if (b->inst->ci->dont_add_nonorder) return;
+   ic = eina_hash_find(b->icon_hash, _desktop_name_get(desktop));
+   EINA_LIST_FOREACH(e_exec_desktop_instances_find(desktop), l, exe)
+     {
+        skip = EINA_TRUE;
+        EINA_LIST_FOREACH(exe->clients, ll, ec)
+          if (!ec->netwm.state.skip_taskbar)
+            {
+               skip = EINA_FALSE;
+               break;
+            }
+        if (skip) continue;
+        if (ic)
+          {
+             if (!eina_list_data_find(ic->exes, exe))
+               ic->exes = eina_list_append(ic->exes, exe);
+             continue;
+          }
+        _ibar_sep_create(b);
+        ic = _ibar_icon_notinorder_new(b, exe);
+     }
+}
+
+static void
+_ibar_icon_place(IBar *b, IBar_Icon *ic, Efreet_Desktop *after)
+{
+   IBar_Icon *ic2 = NULL;
+
+   if (after) ic2 = eina_hash_find(b->icon_hash, _desktop_name_get(after));
+   if ((ic2 == ic) || ((ic2) && (ic2->not_in_order))) return;
+   elm_box_unpack(b->o_box, ic->o_holder);
+   b->icons = eina_inlist_remove(b->icons, EINA_INLIST_GET(ic));
+   if (ic2)
+     {
+        elm_box_pack_after(b->o_box, ic->o_holder, ic2->o_holder);
+        b->icons = eina_inlist_append_relative(b->icons, EINA_INLIST_GET(ic),
+                                               EINA_INLIST_GET(ic2));
+     }
+   else
+     {
+        elm_box_pack_start(b->o_box, ic->o_holder);
+        b->icons = eina_inlist_prepend(b->icons, EINA_INLIST_GET(ic));
+     }
+}
+
+static void
+_ibar_cb_app_change_item(void *data, E_Order *eo EINA_UNUSED, E_Order_Change change, Efreet_Desktop *desktop, Efreet_Desktop *other)
+{
+   IBar *b;
+   IBar_Icon *ic;
+   IBar_Order *io = data;
+   const Eina_List *l;
+   Evas_Coord w, h;
+
+   /* touch only the icon that changed instead of refilling every bar */
+   EINA_INLIST_FOREACH(io->bars, b)
+     {
+        if (!b->inst) continue;
+        ic = eina_hash_find(b->icon_hash, _desktop_name_get(desktop));
+        switch (change)
+          {
+           case E_ORDER_CHANGE_DEL:
+             if ((ic) && (ic->not_in_order)) continue;
+             /* the icon may be gone already (menu remove, drag out) */
+             if (ic) _ibar_icon_free(ic);
+             _ibar_icon_running_add(b, desktop);
+             break;
+
+           case E_ORDER_CHANGE_ADD:
+           case E_ORDER_CHANGE_MOVE:
+             if ((ic) && (ic->not_in_order))
+               {
+                  _ibar_icon_free(ic);
+                  ic = NULL;
+                  if (!b->not_in_order_count)
+                    E_FREE_FUNC(b->o_sep, evas_object_del);
+               }
+             if (!ic)
+               {
+                  ic = _ibar_icon_new(b, desktop, 0);
+                  l = e_exec_desktop_instances_find(desktop);
+                  if (l)
+                    {
+                       ic->exes = eina_list_clone(l);
+                       _ibar_icon_signal_emit(ic, "e,state,on", "e");
+                    }
+               }
+             _ibar_icon_place(b, ic, other);
+             break;
+
+           case E_ORDER_CHANGE_DESKTOP:
+             if ((!ic) || (ic->app == desktop)) continue;
+             efreet_desktop_ref(desktop);
+             efreet_desktop_unref(ic->app);
+             ic->app = desktop;
+             _ibar_icon_fill(ic);
+             break;
+          }
+        _ibar_empty_handle(b);
+        _ibar_resize_handle(b);
+        if (!b->inst->gcc) continue;
+        evas_object_size_hint_min_get(b->o_box, &w, &h);
+        evas_object_size_hint_max_set(b->o_box, w, h);
+     }
+}
+
 static void
 _ibar_cb_resize_job(void *data)
 {
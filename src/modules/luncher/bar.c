@@ -1837,6 +1837,76 @@ _bar_order_update(void *data, E_Order *eo EINA_UNUSED)
      }
 }
 
+static void
+_bar_icon_place(Instance *inst, Icon *ic, Efreet_Desktop *after)
+{
+   Icon *ic2 = NULL;
+
+   if (after) ic2 = eina_hash_find(inst->icons_desktop_hash, after->orig_path);
+   if ((ic2 == ic) || ((ic2) && (!ic2->in_order))) return;
+   elm_box_unpack(inst->o_icon_con, ic->o_layout);
+   inst->icons = eina_list_remove(inst->icons, ic);
+   if (ic2)
+     {
+        elm_box_pack_after(inst->o_icon_con, ic->o_layout, ic2->o_layout);
+        inst->icons = eina_list_append_relative(inst->icons, ic, ic2);
+     }
+   else
+     {
+        elm_box_pack_start(inst->o_icon_con, ic->o_layout);
+        inst->icons = eina_list_prepend(inst->icons, ic);
+     }
+}
+
+static void
+_bar_order_change(void *data, E_Order *eo EINA_UNUSED, E_Order_Change change, Efreet_Desktop *desktop, Efreet_Desktop *other)
+{
+   Instance *inst = data;
+   Icon *ic;
+
+   if ((!inst) || (!inst->o_icon_con)) return;
+   if (inst->cfg->type == E_LUNCHER_MODULE_TASKS_ONLY) return;
+   /* a full refill is already on its way */
+   if (inst->recalc_job) return;
+
+   ic = eina_hash_find(inst->icons_desktop_hash, desktop->orig_path);
+   switch (change)
+     {
+      case E_ORDER_CHANGE_DEL:
+        if ((!ic) || (!ic->in_order)) return;
+        if ((ic->execs) || (ic->clients))
+          {
+             /* still running - it stays as a task icon */
+             bar_recalculate(inst);
+             return;
+          }
+        _bar_icon_del(inst, ic);
+        break;
+
+      case E_ORDER_CHANGE_ADD:
+      case E_ORDER_CHANGE_MOVE:
+        if (!ic)
+          {
+             ic = _bar_icon_add(inst, desktop, NULL);
+             inst->icons = eina_list_append(inst->icons, ic);
+          }
+        ic->in_order = EINA_TRUE;
+        _bar_icon_place(inst, ic, other);
+        break;
+
+      case E_ORDER_CHANGE_DESKTOP:
+        if ((!ic) || (ic->desktop == desktop)) return;
+        efreet_desktop_ref(desktop);
+        if (ic->desktop) efreet_desktop_unref(ic->desktop);
+        ic->desktop = desktop;
+        _bar_icon_file_set(ic, desktop, NULL);
+        if (!inst->cfg->hide_tooltips)
+          elm_object_tooltip_text_set(ic->o_icon, desktop->name);
+        break;
+     }
+   _bar_aspect(inst);
+}
+
 static void
 _bar_created_cb(void *data, Evas_Object *obj, void *event_data EINA_UNUSED)
 {
@@ -1878,6 +1948,7 @@ _bar_created_cb(void *data, Evas_Object *obj, void *event_data EINA_UNUSED)
 
    inst->order = e_order_new(buf);
    e_order_update_callback_set(inst->order, _bar_order_update, inst);
+   e_order_change_callback_set(inst->order, _bar_order_change, inst);
 
    if (inst->cfg->type != E_LUNCHER_MODULE_LAUNCH_ONLY)
      {
@@ -1968,6 +2039,7 @@ bar_reorder(Instance *inst)
         e_object_del(E_OBJECT(inst->order));
         inst->order = e_order_new(buf);
         e_order_update_callback_set(inst->order, _bar_order_update, inst);
+        e_order_change_callback_set(inst->order, _bar_order_change, inst);
         _bar_fill(inst);
      }
 }
@@ -67,6 +67,8 @@ struct _Popup_Data
   const char  *app_name;
   Evas_Object *app_icon;
   Ecore_Timer *timer;
+  Ecore_Timer *refresh_timer;
+  unsigned int merged;
   Eina_Bool pending E_BITFIELD;
 };
 
@@ -11,12 +11,33 @@ static void        _notification_popup_del(unsigned int                 id,
                                            E_Notification_Notify_Closed_Reason reason);
 static void        _notification_popdown(Popup_Data                  *popup,
                                          E_Notification_Notify_Closed_Reason reason);
+static void        _notification_reshuffle_cb(void *data, Evas *e, Evas_Object *obj, void *event_info);
 
 
 #define POPUP_GAP 10
 #define POPUP_TO_EDGE 15
 static int popups_displayed = 0;
 
+/* merged popups keep at most this many of the newest messages/bytes */
+#define MERGE_MAX 8
+#define MERGE_LEN_MAX 4096
+/* each app may burst this many notifications and then this many a second -
+ * anything above that is coalesced into its popup and redrawn lazily */
+#define FLOOD_BURST 5
+#define FLOOD_RATE 2.0
+#define FLOOD_REFRESH 0.25
+#define FLOOD_APPS_MAX 64
+
+typedef struct
+{
+   double time;
+   double tokens;
+} Popup_Rate;
+
+static Eina_Hash *popups_id = NULL;
+static Eina_Hash *popups_app = NULL;
+static Eina_Hash *rates = NULL;
+
 /* Util function protos */
 static void _notification_format_message(Popup_Data *popup);
 
@@ -29,29 +50,76 @@ _notification_timer_cb(Popup_Data *popup)
    return EINA_FALSE;
 }
 
+static void
+_notification_popup_index_add(Popup_Data *popup)
+{
+   if (!popups_id) popups_id = eina_hash_int32_new(NULL);
+   if (!popups_app) popups_app = eina_hash_pointer_new(NULL);
+   if (popup->id) eina_hash_add(popups_id, &popup->id, popup);
+   /* app_name is a stringshare so the pointer is the key */
+   if (popup->app_name) eina_hash_set(popups_app, &popup->app_name, popup);
+}
+
+static void
+_notification_popup_index_del(Popup_Data *popup)
+{
+   if (popups_id && popup->id)
+     eina_hash_del(popups_id, &popup->id, popup);
+   if (popups_app && popup->app_name)
+     eina_hash_del(popups_app, &popup->app_name, popup);
+}
+
+static Eina_Bool
+_notification_flood_check(E_Notification_Notify *n)
+{
+   Popup_Rate *rate;
+   double t = ecore_time_get();
+
+   if ((!n->app_name) || (n->urgency == E_NOTIFICATION_NOTIFY_URGENCY_CRITICAL))
+     return EINA_FALSE;
+   if (!rates) rates = eina_hash_string_superfast_new(free);
+   rate = eina_hash_find(rates, n->app_name);
+   if (!rate)
+     {
+        if (eina_hash_population(rates) >= FLOOD_APPS_MAX)
+          eina_hash_free_buckets(rates);
+        rate = E_NEW(Popup_Rate, 1);
+        if (!rate) return EINA_FALSE;
+        rate->tokens = FLOOD_BURST;
+        eina_hash_add(rates, n->app_name, rate);
+     }
+   else
+     {
+        rate->tokens += (t - rate->time) * FLOOD_RATE;
+        if (rate->tokens > FLOOD_BURST) rate->tokens = FLOOD_BURST;
+     }
+   rate->time = t;
+   if (rate->tokens < 1.0) return EINA_TRUE;
+   rate->tokens -= 1.0;
+   return EINA_FALSE;
+}
+
 static Popup_Data *
-_notification_popup_merge(E_Notification_Notify *n)
+_notification_popup_merge(E_Notification_Notify *n, Eina_Bool flood)
 {
-   Eina_List *l;
    Popup_Data *popup;
-   char *body_final;
+   Eina_Strbuf *buf;
+   const char *body, *p;
    size_t len;
+   unsigned int count;
 
    if (!n->app_name) return NULL;
+   if (!popups_app) return NULL;
 
-   EINA_LIST_FOREACH(notification_cfg->popups, l, popup)
-     {
-        if (!popup->notif) continue;
-        if (popup->notif->app_name == n->app_name) break;
-     }
-
-   if (!popup)
+   popup = eina_hash_find(popups_app, &n->app_name);
+   if ((!popup) || (!popup->notif))
      {
         /* printf("- no poup to merge\n"); */
         return NULL;
      }
 
-   if (n->summary && (n->summary != popup->notif->summary))
+   /* a flooding app gets everything folded into its popup */
+   if ((!flood) && n->summary && (n->summary != popup->notif->summary))
      {
         /* printf("- summary doesn match, %s, %s\n", str1, str2); */
         return NULL;
@@ -60,25 +128,54 @@ _notification_popup_merge(E_Notification_Notify *n)
    /* TODO  p->n is not fallback alert..*/
    /* TODO  both allow merging */
 
-   len = strlen(popup->notif->body);
-   len += strlen(n->body);
-   len += 5; /* \xE2\x80\xA9 or <PS/> */
-   if (len < 8192) body_final = alloca(len + 1);
-   else body_final = malloc(len + 1);
+   buf = eina_strbuf_new();
    /* Hack to allow e to include markup */
-   snprintf(body_final, len + 1, "%s<ps/>%s", popup->notif->body, n->body);
+   eina_strbuf_append_printf(buf, "%s<ps/>%s", popup->notif->body, n->body);
+   /* drop the oldest messages so the history can't grow without bound */
+   body = eina_strbuf_string_get(buf);
+   len = eina_strbuf_length_get(buf);
+   count = popup->merged + 2;
+   while ((count > MERGE_MAX) || (len > MERGE_LEN_MAX))
+     {
+        p = strstr(body, "<ps/>");
+        if (!p) break;
+        len -= (p + 5) - body;
+        body = p + 5;
+        count--;
+     }
 
-   /* printf("set body %s\n", body_final); */
+   /* printf("set body %s\n", body); */
 
-   eina_stringshare_replace(&n->body, body_final);
+   eina_stringshare_replace(&n->body, body);
+   eina_strbuf_free(buf);
 
    e_object_del(E_OBJECT(popup->notif));
    popup->notif = n;
-   if (len >= 8192) free(body_final);
+   popup->merged = count - 1;
 
    return popup;
 }
 
+static Eina_Bool
+_notification_refresh_timer_cb(void *data)
+{
+   Popup_Data *popup = data;
+
+   popup->refresh_timer = NULL;
+   _notification_popup_refresh(popup);
+   _notification_reshuffle_cb(NULL, NULL, NULL, NULL);
+   return EINA_FALSE;
+}
+
+static void
+_notification_popup_refresh_queue(Popup_Data *popup)
+{
+   if (popup->refresh_timer) return;
+   popup->refresh_timer = ecore_timer_loop_add(FLOOD_REFRESH,
+                                               _notification_refresh_timer_cb,
+                                               popup);
+}
+
 static void
 _notification_reshuffle_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
 {
@@ -105,6 +202,7 @@ notification_popup_notify(E_Notification_Notify *n,
                           unsigned int id)
 {
    Popup_Data *popup = NULL;
+   Eina_Bool flood;
 
    switch (n->urgency)
      {
@@ -124,23 +222,37 @@ notification_popup_notify(E_Notification_Notify *n,
      }
    if (notification_cfg->ignore_replacement)
      n->replaces_id = 0;
+   flood = _notification_flood_check(n);
 
    if (n->replaces_id && (popup = _notification_popup_find(n->replaces_id)))
      {
         if (popup->notif)
           e_object_del(E_OBJECT(popup->notif));
 
+        _notification_popup_index_del(popup);
         popup->notif = n;
         popup->id = id;
-        _notification_popup_refresh(popup);
-        _notification_reshuffle_cb(NULL, NULL, NULL, NULL);
+        popup->app_name = n->app_name;
+        _notification_popup_index_add(popup);
+        if (flood)
+          _notification_popup_refresh_queue(popup);
+        else
+          {
+             _notification_popup_refresh(popup);
+             _notification_reshuffle_cb(NULL, NULL, NULL, NULL);
+          }
      }
    else if (!n->replaces_id)
      {
-        if ((popup = _notification_popup_merge(n)))
+        if ((popup = _notification_popup_merge(n, flood)))
           {
-             _notification_popup_refresh(popup);
-             _notification_reshuffle_cb(NULL, NULL, NULL, NULL);
+             if (flood)
+               _notification_popup_refresh_queue(popup);
+             else
+               {
+                  _notification_popup_refresh(popup);
+                  _notification_reshuffle_cb(NULL, NULL, NULL, NULL);
+               }
           }
      }
 
@@ -154,6 +266,7 @@ notification_popup_notify(E_Notification_Notify *n,
              return;
           }
         notification_cfg->popups = eina_list_append(notification_cfg->popups, popup);
+        _notification_popup_index_add(popup);
         edje_object_signal_emit(popup->theme, "notification,new", "notification");
      }
 
@@ -175,6 +288,9 @@ notification_popup_shutdown(void)
 
    EINA_LIST_FREE(notification_cfg->popups, popup)
      _notification_popdown(popup, E_NOTIFICATION_NOTIFY_CLOSED_REASON_REQUESTED);
+   E_FREE_FUNC(popups_id, eina_hash_free);
+   E_FREE_FUNC(popups_app, eina_hash_free);
+   E_FREE_FUNC(rates, eina_hash_free);
 }
 
 void
@@ -430,7 +546,7 @@ _notification_popup_refresh(Popup_Data *popup)
      }
 
    /* Check if the app specify an icon either by a path or by a hint */
-   if (!popup->notif->icon.raw.data)
+   if ((!popup->notif->icon.raw.data) && (!popup->notif->icon.image))
      {
         const char *icon_path;
 
@@ -539,14 +655,8 @@ _notification_popup_refresh(Popup_Data *popup)
 static Popup_Data *
 _notification_popup_find(unsigned int id)
 {
-   Eina_List *l;
-   Popup_Data *popup;
-
-   if (!id) return NULL;
-   EINA_LIST_FOREACH(notification_cfg->popups, l, popup)
-     if (popup->id == id)
-       return popup;
-   return NULL;
+   if ((!id) || (!popups_id)) return NULL;
+   return eina_hash_find(popups_id, &id);
 }
 
 static void
@@ -554,25 +664,21 @@ _notification_popup_del(unsigned int                 id,
                         E_Notification_Notify_Closed_Reason reason)
 {
    Popup_Data *popup;
-   Eina_List *l;
 
-   EINA_LIST_FOREACH(notification_cfg->popups, l, popup)
-     {
-        if (popup->id == id)
-          {
-             popup->pending = 1;
-             evas_object_event_callback_add(popup->theme, EVAS_CALLBACK_DEL, _notification_reshuffle_cb, NULL);
-             _notification_popdown(popup, reason);
-             break;
-          }
-     }
+   popup = _notification_popup_find(id);
+   if (!popup) return;
+   popup->pending = 1;
+   evas_object_event_callback_add(popup->theme, EVAS_CALLBACK_DEL, _notification_reshuffle_cb, NULL);
+   _notification_popdown(popup, reason);
 }
 
 static void
 _notification_popdown(Popup_Data                  *popup,
                       E_Notification_Notify_Closed_Reason reason)
 {
+   _notification_popup_index_del(popup);
    E_FREE_FUNC(popup->timer, ecore_timer_del);
+   E_FREE_FUNC(popup->refresh_timer, ecore_timer_del);
    E_FREE_LIST(popup->mirrors, evas_object_del);
    if (popup->win)
      {
@@ -378,6 +378,7 @@ E_API int
 e_modapi_shutdown(E_Module *m EINA_UNUSED)
 {
    share_abort();
+   save_shutdown();
    preview_abort();
    delay_abort();
    if (delfn_client)
@@ -11,9 +11,10 @@ extern E_Module *shot_module;
 
 #define MAXZONES 64
 
-void         share_save              (const char *cmd);
+Ecore_Exe   *share_save              (const char *cmd);
 void         share_write_end_watch   (void *data);
 void         share_write_status_watch(void *data);
+void         share_prepare_progress  (int progress);
 void         share_dialog_show       (void);
 void         share_confirm           (void);
 Eina_Bool    share_have              (void);
@@ -24,6 +25,8 @@ void         preview_abort           (void);
 Evas_Object *preview_image_get       (void);
 void         save_to                 (const char *file);
 void         save_show               (void);
+void         save_abort              (Eina_Bool uploads_only);
+void         save_shutdown           (void);
 
 Evas_Object *ui_edit(Evas_Object *window, Evas_Object *o_bg, E_Zone *zone,
                      E_Client *ec, void *dst, int sx, int sy, int sw, int sh,
@@ -7,31 +7,56 @@ typedef struct
    int w, h, stride, quality;
    size_t size;
    int fd;
+   Ecore_Thread *th;
 } Rgba_Writer_Data;
 
+typedef struct
+{
+   Ecore_Exe *exe;
+   int fd;
+} Rgba_Mem;
+
+static Eina_List *writers = NULL;
+static Eina_List *mems = NULL;
+static Ecore_Event_Handler *mem_handler = NULL;
+
 static void
 _rgba_data_free(Rgba_Writer_Data *rdata)
 {
+   writers = eina_list_remove(writers, rdata);
    free(rdata->path);
    free(rdata->outfile);
    free(rdata->data);
-   close(rdata->fd);
+   if (rdata->fd >= 0) close(rdata->fd);
    free(rdata);
 }
 
-static void
-_cb_rgba_writer_do(void *data, Ecore_Thread *th EINA_UNUSED)
+static Eina_Bool
+_cb_rgba_mem_exe_del(void *data EINA_UNUSED, int ev_type EINA_UNUSED, void *event)
 {
-   Rgba_Writer_Data *rdata = data;
-   if (write(rdata->fd, rdata->data, rdata->size) < 0)
-     ERR("Write of shot rgba data failed");
+   Ecore_Exe_Event_Del *ev = event;
+   Rgba_Mem *mem;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(mems, l, mem)
+     {
+        if (mem->exe != ev->exe) continue;
+        // the helper has its own mapping (or died) - drop our memfd ref
+        close(mem->fd);
+        mems = eina_list_remove_list(mems, l);
+        free(mem);
+        break;
+     }
+   if (!mems) E_FREE_FUNC(mem_handler, ecore_event_handler_del);
+   return ECORE_CALLBACK_PASS_ON;
 }
 
 static void
-_cb_rgba_writer_done(void *data, Ecore_Thread *th EINA_UNUSED)
+_rgba_helper_run(Rgba_Writer_Data *rdata, int mem_fd)
 {
-   Rgba_Writer_Data *rdata = data;
    char buf[PATH_MAX];
+   Ecore_Exe *exe;
+   Rgba_Mem *mem;
 
    if (rdata->outfile)
      snprintf(buf, sizeof(buf), "%s/%s/upload '%s' %i %i %i %i '%s'",
@@ -43,7 +68,64 @@ _cb_rgba_writer_done(void *data, Ecore_Thread *th EINA_UNUSED)
               e_module_dir_get(shot_module), MODULE_ARCH,
               rdata->path, rdata->w, rdata->h, rdata->stride,
               rdata->quality);
-   share_save(buf);
+   exe = share_save(buf);
+   if (mem_fd < 0) return;
+   // the helper opens the memfd through our /proc entry so it has to stay
+   // open here until the helper is gone
+   mem = E_NEW(Rgba_Mem, 1);
+   if ((!exe) || (!mem))
+     {
+        free(mem);
+        close(mem_fd);
+        return;
+     }
+   mem->exe = exe;
+   mem->fd = mem_fd;
+   mems = eina_list_append(mems, mem);
+   if (!mem_handler)
+     mem_handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL,
+                                           _cb_rgba_mem_exe_del, NULL);
+}
+
+static void
+_cb_rgba_writer_do(void *data, Ecore_Thread *th)
+{
+   Rgba_Writer_Data *rdata = data;
+   unsigned char *p = rdata->data;
+   size_t done = 0, chunk;
+   ssize_t n;
+
+   // write in chunks so a large shot can report progress and be cancelled
+   while (done < rdata->size)
+     {
+        if (ecore_thread_check(th)) return;
+        chunk = rdata->size - done;
+        if (chunk > (4 * 1024 * 1024)) chunk = 4 * 1024 * 1024;
+        n = write(rdata->fd, p + done, chunk);
+        if (n < 0)
+          {
+             if (errno == EINTR) continue;
+             ERR("Write of shot rgba data failed");
+             ecore_thread_cancel(th);
+             return;
+          }
+        done += n;
+        ecore_thread_feedback(th, (void *)(intptr_t)((done * 1000) / rdata->size));
+     }
+}
+
+static void
+_cb_rgba_writer_progress(void *data EINA_UNUSED, Ecore_Thread *th EINA_UNUSED, void *msg)
+{
+   share_prepare_progress((int)(intptr_t)msg);
+}
+
+static void
+_cb_rgba_writer_done(void *data, Ecore_Thread *th EINA_UNUSED)
+{
+   Rgba_Writer_Data *rdata = data;
+
+   _rgba_helper_run(rdata, -1);
    _rgba_data_free(rdata);
 }
 
@@ -51,119 +133,184 @@ static void
 _cb_rgba_writer_cancel(void *data, Ecore_Thread *th EINA_UNUSED)
 {
    Rgba_Writer_Data *rdata = data;
+
+   if (rdata->path) ecore_file_unlink(rdata->path);
    _rgba_data_free(rdata);
 }
 
+static int
+_rgba_memfd_new(size_t size)
+{
+   int fd = -1;
+
+#ifdef MFD_CLOEXEC
+   fd = memfd_create("e-shot-rgba", MFD_CLOEXEC);
+   if (fd < 0) return -1;
+   if ((ftruncate(fd, size) < 0) || (!ecore_file_exists("/proc/self/fd")))
+     {
+        close(fd);
+        return -1;
+     }
+#else
+   (void)size;
+#endif
+   return fd;
+}
+
+static void
+_rgba_copy(unsigned char *dst, unsigned char *src_data, int stride, int h)
+{
+   int y;
+   unsigned char *s;
+
+   if ((crop.x == 0) && (crop.y == 0) &&
+       (crop.w == 0) && (crop.h == 0))
+     {
+        memcpy(dst, src_data, (size_t)stride * h);
+        return;
+     }
+   for (y = crop.y; y < (crop.y + crop.h); y++)
+     {
+        s = src_data + ((size_t)stride * y) + (crop.x * 4);
+        memcpy(dst, s, crop.w * 4);
+        dst += crop.w * 4;
+     }
+}
+
 void
 save_to(const char *file)
 {
    int fd;
    char tmpf[256] = "e-shot-rgba-XXXXXX";
+   char buf[PATH_MAX];
    Eina_Tmpstr *path = NULL;
-   int imw = 0, imh = 0, imstride;
+   int imw = 0, imh = 0, imstride = 0, w = 0, h = 0, stride;
+   unsigned char *src_data, *map;
+   Rgba_Writer_Data *thdat;
+   size_t size;
+   Evas_Object *img = preview_image_get();
+
+   if (!img) return;
+   ui_edit_prepare();
+   stride = evas_object_image_stride_get(img);
+   src_data = evas_object_image_data_get(img, EINA_FALSE);
+   evas_object_image_size_get(img, &w, &h);
+   if (!((stride > 0) && (src_data) && (h > 0))) return;
+   if ((crop.x == 0) && (crop.y == 0) &&
+       (crop.w == 0) && (crop.h == 0))
+     {
+        imw = w;
+        imh = h;
+        imstride = stride;
+     }
+   else
+     {
+        imw = crop.w;
+        imh = crop.h;
+        imstride = imw * 4;
+     }
+   size = (size_t)imstride * imh;
 
-   fd = eina_file_mkstemp(tmpf, &path);
+   thdat = E_NEW(Rgba_Writer_Data, 1);
+   if (!thdat) return;
+   thdat->fd = -1;
+   thdat->w = imw;
+   thdat->h = imh;
+   thdat->stride = imstride;
+   thdat->quality = quality;
+   thdat->size = size;
+   if (file)
+     {
+        thdat->outfile = strdup(file);
+        if (!thdat->outfile) goto err;
+     }
+
+   // hand the pixels straight to the encoding helper in a memfd - nothing
+   // touches the disk and the helper does the encode outside our loop
+   fd = _rgba_memfd_new(size);
    if (fd >= 0)
      {
-        unsigned char *data = NULL;
-        Rgba_Writer_Data *thdat = NULL;
-        size_t size = 0;
-        Evas_Object *img = preview_image_get();
-
-        ui_edit_prepare();
-        printf("C: %i %i %ix%i\n", crop.x, crop.y, crop.w, crop.h);
-        if ((crop.x == 0) && (crop.y == 0) &&
-            (crop.w == 0) && (crop.h == 0))
-          {
-             if (img)
-               {
-                  int w = 0, h = 0;
-                  int stride = evas_object_image_stride_get(img);
-                  unsigned char *src_data = evas_object_image_data_get(img, EINA_FALSE);
-
-                  evas_object_image_size_get(img, &w, &h);
-                  if ((stride > 0) && (src_data) && (h > 0))
-                    {
-                       imw = w;
-                       imh = h;
-                       imstride = stride;
-                       size = stride * h;
-                       data = malloc(size);
-                       if (data) memcpy(data, src_data, size);
-                    }
-               }
-          }
-        else
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED)
           {
-             if (img)
+             _rgba_copy(map, src_data, stride, imh);
+             munmap(map, size);
+             snprintf(buf, sizeof(buf), "/proc/%i/fd/%i", (int)getpid(), fd);
+             thdat->path = strdup(buf);
+             if (thdat->path)
                {
-                  int w = 0, h = 0;
-                  int stride = evas_object_image_stride_get(img);
-                  unsigned char *src_data = evas_object_image_data_get(img, EINA_FALSE);
-
-                  evas_object_image_size_get(img, &w, &h);
-                  if ((stride > 0) && (src_data) && (h > 0))
-                    {
-                       size = crop.w * crop.h * 4;
-                       data = malloc(size);
-                       if (data)
-                         {
-                            int y;
-                            unsigned char *s, *d;
-
-                            imw = crop.w;
-                            imh = crop.h;
-                            imstride = imw * 4;
-                            d = data;
-                            printf("Cpy dat %p -> %p | %ix%i\n", src_data, data, imw, imh);
-                            for (y = crop.y; y < (crop.y + crop.h); y++)
-                              {
-                                 s = src_data + (stride * y) + (crop.x * 4);
-                                 memcpy(d, s, crop.w * 4);
-                                 d += crop.w * 4;
-                              }
-                         }
-                    }
+                  _rgba_helper_run(thdat, fd);
+                  _rgba_data_free(thdat);
+                  return;
                }
           }
-        if (data)
+        close(fd);
+     }
+
+   // no memfd - write a tmp file in a thread and run the helper on that
+   thdat->fd = eina_file_mkstemp(tmpf, &path);
+   if (thdat->fd < 0) goto err;
+   thdat->path = strdup(path);
+   if (!thdat->path) ecore_file_unlink(path);
+   eina_tmpstr_del(path);
+   thdat->data = malloc(size);
+   if ((!thdat->path) || (!thdat->data)) goto err;
+   _rgba_copy(thdat->data, src_data, stride, imh);
+   writers = eina_list_append(writers, thdat);
+   thdat->th = ecore_thread_feedback_run(_cb_rgba_writer_do,
+                                         _cb_rgba_writer_progress,
+                                         _cb_rgba_writer_done,
+                                         _cb_rgba_writer_cancel,
+                                         thdat, EINA_FALSE);
+   return;
+err:
+   if (thdat->path) ecore_file_unlink(thdat->path);
+   _rgba_data_free(thdat);
+}
+
+void
+save_abort(Eina_Bool uploads_only)
+{
+   Rgba_Writer_Data *rdata;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(writers, l, rdata)
+     {
+        if ((uploads_only) && (rdata->outfile)) continue;
+        if (rdata->th) ecore_thread_cancel(rdata->th);
+     }
+}
+
+void
+save_shutdown(void)
+{
+   Rgba_Writer_Data *rdata;
+   Rgba_Mem *mem;
+   Ecore_Thread *th;
+
+   // the thread and exe callbacks live in this module so nothing may be
+   // left to call them once it is unloaded
+   while (writers)
+     {
+        rdata = eina_list_data_get(writers);
+        th = rdata->th;
+        if (!th)
           {
-             thdat = calloc(1, sizeof(Rgba_Writer_Data));
-             if (thdat)
-               {
-                  thdat->path = strdup(path);
-                  if (file) thdat->outfile = strdup(file);
-                  if ((thdat->path) &&
-                      (((file) && (thdat->outfile)) ||
-                       (!file)))
-                    {
-                       thdat->data = data;
-                       thdat->size = size;
-                       thdat->fd = fd;
-                       thdat->w = imw;
-                       thdat->h = imh;
-                       thdat->stride = imstride;
-                       thdat->quality = quality;
-                       ecore_thread_run(_cb_rgba_writer_do,
-                                        _cb_rgba_writer_done,
-                                        _cb_rgba_writer_cancel, thdat);
-                    }
-                  else
-                    {
-                       free(data);
-                       free(thdat->path);
-                       free(thdat->outfile);
-                       free(thdat);
-                       thdat = NULL;
-                    }
-               }
-             else
-               free(data);
+             _rgba_data_free(rdata);
+             continue;
           }
-        if (!thdat) close(fd);
-        eina_tmpstr_del(path);
+        // a thread that never started is cancelled (and freed) right here,
+        // a running one stops at its next chunk and runs its callback
+        if (ecore_thread_cancel(th)) continue;
+        while (!ecore_thread_wait(th, 0.5));
+     }
+   E_FREE_FUNC(mem_handler, ecore_event_handler_del);
+   EINA_LIST_FREE(mems, mem)
+     {
+        ecore_exe_terminate(mem->exe);
+        close(mem->fd);
+        free(mem);
      }
-   return;
 }
 
 void
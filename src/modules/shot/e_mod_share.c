@@ -34,7 +34,14 @@ static void
 _upload_cancel_cb(void *data EINA_UNUSED, E_Dialog *dia)
 {
    o_label = NULL;
-   if (dia) e_util_defer_object_del(E_OBJECT(dia));
+   if (dia)
+     {
+        // cancel pressed - stop preparing the data and kill the helper
+        // encoding/uploading it, hiding the dialog leaves them running
+        save_abort(EINA_TRUE);
+        if (img_write_exe) ecore_exe_terminate(img_write_exe);
+        e_util_defer_object_del(E_OBJECT(dia));
+     }
    E_FREE_FUNC(win, evas_object_del);
    _share_done();
 }
@@ -61,7 +68,18 @@ _img_write_out_cb(void *data, int ev_type EINA_UNUSED, void *event)
      {
         const char *l = ev->lines[i].line;
 
-        if ((l[0] == 'U') && (l[1] == ' '))
+        if ((l[0] == 'S') && (l[1] == ' '))
+          {
+             int v = atoi(l + 2);
+             if ((v >= 0) && (v <= 1000))
+               {
+                  char buf[128];
+                  // update gui...
+                  snprintf(buf, sizeof(buf), _("Encoding %i%%"), (v * 100) / 1000);
+                  e_widget_label_text_set(o_label, buf);
+               }
+          }
+        else if ((l[0] == 'U') && (l[1] == ' '))
           {
              int v = atoi(l + 2);
              if ((v >= 0) && (v <= 1000))
@@ -101,13 +119,24 @@ done:
    return EINA_FALSE;
 }
 
-void
+Ecore_Exe *
 share_save(const char *cmd)
 {
    share_write_end_watch(NULL);
    img_write_exe = ecore_exe_pipe_run
      (cmd, ECORE_EXE_PIPE_READ | ECORE_EXE_PIPE_READ_LINE_BUFFERED |
       ECORE_EXE_NOT_LEADER | ECORE_EXE_TERM_WITH_PARENT, NULL);
+   return img_write_exe;
+}
+
+void
+share_prepare_progress(int progress)
+{
+   char buf[128];
+
+   if (!o_label) return;
+   snprintf(buf, sizeof(buf), _("Preparing %i%%"), (progress * 100) / 1000);
+   e_widget_label_text_set(o_label, buf);
 }
 
 void
@@ -211,6 +240,7 @@ share_have(void)
 void
 share_abort(void)
 {
+   save_abort(EINA_FALSE);
    E_FREE_FUNC(cd, e_object_del);
    E_FREE_FUNC(win, evas_object_del);
 }
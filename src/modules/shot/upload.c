@@ -77,6 +77,22 @@ find_tmpfile(int quality, char *buf, size_t buf_size)
    return EINA_FALSE;
 }
 
+static void
+rgba_file_done(const char *rgba_file)
+{
+   // pixels handed over in the parent's memfd via /proc have nothing to
+   // remove - only a real tmp file does
+   if (!strncmp(rgba_file, "/proc/", 6)) return;
+   ecore_file_unlink(rgba_file);
+}
+
+static void
+encode_progress(int v)
+{
+   printf("S %i\n", v);
+   fflush(stdout);
+}
+
 EAPI int
 elm_main(int argc, char **argv)
 {
@@ -124,7 +140,7 @@ elm_main(int argc, char **argv)
    fdata = eina_file_map_all(infile, EINA_FILE_SEQUENTIAL);
    if (!((fsize > 0) && (fdata)))
      {
-        ecore_file_unlink(rgba_file);
+        rgba_file_done(rgba_file);
         return 3;
      }
 
@@ -137,10 +153,16 @@ elm_main(int argc, char **argv)
    image_data = evas_object_image_data_get(image, EINA_TRUE);
    if (!((image_stride > 0) && (image_data)))
      {
-        ecore_file_unlink(rgba_file);
+        rgba_file_done(rgba_file);
         return 4;
      }
    // copy data into output image (could also set data straight in
+   if ((size_t)stride * h > fsize)
+     {
+        rgba_file_done(rgba_file);
+        return 3;
+     }
+   encode_progress(0);
    src = fdata;
    for (y = 0; y < h; y++)
      {
@@ -148,15 +170,17 @@ elm_main(int argc, char **argv)
         image_data += image_stride;
         src += stride;
      }
+   encode_progress(100);
    if (quality == 100)
      snprintf(opts, sizeof(opts), "compress=%i", 9);
    else
      snprintf(opts, sizeof(opts), "quality=%i", quality);
    eina_file_close(infile);
-   ecore_file_unlink(rgba_file);
+   rgba_file_done(rgba_file);
    // save the file
    if (!evas_object_image_save(image, out_file, NULL, opts))
      return 5;
+   encode_progress(1000);
 
    // if we have to upload it, open our output file, mmap it and upload
    if (upload)
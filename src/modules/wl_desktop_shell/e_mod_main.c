@@ -34,6 +34,7 @@ e_shell_surface_destroy(struct wl_resource *resource)
    if (shd)
      {
         E_FREE_LIST(shd->pending, free);
+        E_FREE_FUNC(shd->throttle.timer, ecore_timer_del);
         if ((resource == shd->surface) || (!shd->surface))
           E_FREE(ec->comp_data->shell.data);
      }
@@ -136,6 +137,83 @@ e_shell_data_new(unsigned int version)
    return shd;
 }
 
+/* interactive resizes ask for a configure on every pointer motion. like
+ * _NET_WM_SYNC_REQUEST on x only one of those is kept in flight: the next
+ * one waits until the client has acked the last one and committed a buffer
+ * for it, and all sizes asked for meanwhile fold into the latest. clients
+ * that take longer than CONFIGURE_TIMEOUT are not waited for */
+#define CONFIGURE_TIMEOUT 0.5
+
+static void
+_e_shell_data_configure_release(E_Client *ec, E_Shell_Data *shd)
+{
+   shd->throttle.wait = 0;
+   shd->throttle.acked = 0;
+   E_FREE_FUNC(shd->throttle.timer, ecore_timer_del);
+   if (!shd->throttle.queued) return;
+   shd->throttle.queued = 0;
+   if ((ec->comp_data->shell.surface) && (ec->comp_data->shell.configure_send))
+     ec->comp_data->shell.configure_send(ec->comp_data->shell.surface,
+                                         shd->throttle.edges,
+                                         shd->throttle.width,
+                                         shd->throttle.height);
+}
+
+static Eina_Bool
+_e_shell_data_configure_timeout(void *data)
+{
+   E_Client *ec = data;
+   E_Shell_Data *shd = ec->comp_data->shell.data;
+
+   shd->throttle.timer = NULL;
+   _e_shell_data_configure_release(ec, shd);
+   return ECORE_CALLBACK_CANCEL;
+}
+
+EINTERN Eina_Bool
+e_shell_data_configure_throttle(E_Client *ec, E_Shell_Data *shd, uint32_t edges, int32_t width, int32_t height)
+{
+   if (!shd->throttle.wait) return EINA_FALSE;
+   if ((ecore_loop_time_get() - shd->throttle.send_time) > CONFIGURE_TIMEOUT)
+     return EINA_FALSE;
+   shd->throttle.edges = edges;
+   shd->throttle.width = width;
+   shd->throttle.height = height;
+   shd->throttle.queued = 1;
+   // make sure the last size goes out even if the pointer stops here
+   if (!shd->throttle.timer)
+     shd->throttle.timer = ecore_timer_loop_add(CONFIGURE_TIMEOUT,
+                                                _e_shell_data_configure_timeout,
+                                                ec);
+   return EINA_TRUE;
+}
+
+EINTERN void
+e_shell_data_configure_sent(E_Shell_Data *shd, uint32_t serial, uint32_t edges)
+{
+   // whatever was queued is superseded by what just went out
+   shd->throttle.queued = 0;
+   shd->throttle.acked = 0;
+   E_FREE_FUNC(shd->throttle.timer, ecore_timer_del);
+   shd->throttle.wait = !!edges;
+   shd->throttle.serial = serial;
+   shd->throttle.send_time = ecore_loop_time_get();
+}
+
+EINTERN void
+e_shell_data_configure_acked(E_Shell_Data *shd, uint32_t serial)
+{
+   if ((shd->throttle.wait) && (serial >= shd->throttle.serial))
+     shd->throttle.acked = 1;
+}
+
+EINTERN void
+e_shell_data_configure_committed(E_Client *ec, E_Shell_Data *shd)
+{
+   if ((shd) && (shd->throttle.wait) && (shd->throttle.acked))
+     _e_shell_data_configure_release(ec, shd);
+}
+
 static Eina_Bool
 desktop_xwayland_startup()
 {
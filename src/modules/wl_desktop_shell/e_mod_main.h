@@ -14,6 +14,10 @@ EINTERN void e_shell_surface_cb_destroy(struct wl_resource *resource);
 EINTERN void e_shell_surface_parent_set(E_Client *ec, struct wl_resource *parent_resource);
 EINTERN void e_shell_surface_mouse_down_helper(E_Client *ec, E_Binding_Event_Mouse_Button *ev, Eina_Bool move);
 EINTERN E_Shell_Data *e_shell_data_new(unsigned int version);
+EINTERN Eina_Bool e_shell_data_configure_throttle(E_Client *ec, E_Shell_Data *shd, uint32_t edges, int32_t width, int32_t height);
+EINTERN void e_shell_data_configure_sent(E_Shell_Data *shd, uint32_t serial, uint32_t edges);
+EINTERN void e_shell_data_configure_acked(E_Shell_Data *shd, uint32_t serial);
+EINTERN void e_shell_data_configure_committed(E_Client *ec, E_Shell_Data *shd);
 
 EINTERN Eina_Bool e_xdg_shell_v6_init(void);
 EINTERN Eina_Bool e_xdg_shell_init(void);
@@ -28,6 +32,18 @@ struct E_Shell_Data
    struct wl_resource *surface;
    void *shell;
    unsigned int version;
+   struct
+   {
+      Ecore_Timer *timer;
+      double send_time;
+      uint32_t serial;
+      uint32_t edges;
+      int32_t width;
+      int32_t height;
+      Eina_Bool wait E_BITFIELD;
+      Eina_Bool acked E_BITFIELD;
+      Eina_Bool queued E_BITFIELD;
+   } throttle;
    Eina_Bool fullscreen E_BITFIELD;
    Eina_Bool maximized E_BITFIELD;
    Eina_Bool activated E_BITFIELD;
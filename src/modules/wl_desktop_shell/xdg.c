@@ -190,6 +190,8 @@ _e_xdg_shell_surface_configure(struct wl_resource *resource, Evas_Coord x, Evas_
      e_client_util_move_resize_without_frame(ec, x, y, w, h);
    else
      e_client_util_resize_without_frame(ec, w, h);
+   /* a commit after the ack lets the next resize configure go out */
+   e_shell_data_configure_committed(ec, ec->comp_data->shell.data);
 }
 
 static void
@@ -326,6 +328,13 @@ _xdg_shell_surface_send_configure(struct wl_resource *resource, Eina_Bool fullsc
        (shd->fullscreen == fullscreen) &&
        (shd->maximized == maximized) &&
        (shd->activated == activated)) return;
+   // resizing on and on - fold this size into the one in flight
+   if (edges && (shd->edges == edges) &&
+       (shd->fullscreen == fullscreen) &&
+       (shd->maximized == maximized) &&
+       (shd->activated == activated) &&
+       e_shell_data_configure_throttle(ec, shd, edges, width, height))
+     return;
    if (shd->edges && (shd->edges != edges))
      {
         if (shd->pending && (!width) && (!height))
@@ -373,6 +382,7 @@ _xdg_shell_surface_send_configure(struct wl_resource *resource, Eina_Bool fullsc
       ps->serial = serial;
       shd->pending = eina_list_append(shd->pending, ps);
    }
+   e_shell_data_configure_sent(shd, serial, edges);
    xdg_surface_send_configure(shd->surface, serial);
 
    wl_array_release(&states);
@@ -477,6 +487,7 @@ _e_xdg_surface_cb_ack_configure(struct wl_client *client EINA_UNUSED, struct wl_
      }
    if (e_object_is_del(E_OBJECT(ec))) return;
    shd = ec->comp_data->shell.data;
+   e_shell_data_configure_acked(shd, serial);
    EINA_LIST_FOREACH_SAFE(shd->pending, l, ll, ps)
      {
         if (ps->serial > serial) break;
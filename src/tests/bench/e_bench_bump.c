@@ -0,0 +1,231 @@
+/* efx bump mapping kernel: checks the row kernel (vector paths and all) is
+ * bit for bit the same as the original per-pixel loop, over odd sizes, edge
+ * wrapping and parameter sets that overflow, then times both on a 512x512
+ * image.
+ *
+ * env:
+ *   E_BENCH_TIME - seconds to spend per timed kernel (default: 0.5)
+ */
+#include "efx_bumpmapping.c"
+#include <time.h>
+
+int _e_efx_log_dom = -1;
+
+E_EFX *
+e_efx_new(Evas_Object *obj EINA_UNUSED)
+{
+   return NULL;
+}
+
+static unsigned int bench_seed = 0x5eed;
+
+static unsigned int
+_bench_rand(void)
+{
+   bench_seed = (bench_seed * 1103515245) + 12345;
+   return (bench_seed >> 16) & 0x7fff;
+}
+
+static unsigned long long
+_bench_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((unsigned long long)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+/* the loop _bumpmap() had before it was split into rows and vectorized */
+static void
+_ref_bumpmap(const E_Efx_Bumpmap_Params *p, const unsigned int *img, unsigned int *out, int w, int h)
+{
+   int i, j, lightx, lighty, mx, my;
+   const unsigned int *mp, *mpy, *mpp;
+   unsigned int *src;
+
+   memcpy(out, img, w * h * sizeof(int));
+   src = out;
+   mpp = img;
+   my = h;
+   lighty = -p->y;
+   for (j = h; --j >= 0;)
+     {
+        mp = mpp;
+        mpp += w;
+        if (--my <= 0)
+          {
+             mpp -= w * h;
+             my = h;
+          }
+        mpy = mpp;
+        mx = w;
+        lightx = -p->x;
+        i = w - 1;
+        do
+          {
+             double v;
+             int r, g, b, gr, x1, y_1;
+
+             gr = A_VAL(mp) * (R_VAL(mp) + G_VAL(mp) + B_VAL(mp));
+             y_1 = p->depth * (A_VAL(mpy) * (R_VAL(mpy) + G_VAL(mpy) +
+                                             B_VAL(mpy)) - gr);
+             mp++;
+             mpy++;
+             if (--mx <= 0)
+               {
+                  mp -= w;
+                  mpy -= w;
+                  mx = w;
+               }
+             x1 = p->depth * (A_VAL(mp) * (R_VAL(mp) + G_VAL(mp) +
+                                           B_VAL(mp)) - gr);
+             v = x1 * lightx + y_1 * lighty + p->z;
+             v /= sqrt(((x1 * x1) + (y_1 * y_1) + 1) *
+                       ((lightx * lightx) + (lighty * lighty) + p->z_2));
+             v += p->ambient;
+             r = v * R_VAL(src) * p->red;
+             g = v * G_VAL(src) * p->green;
+             b = v * B_VAL(src) * p->blue;
+             R_VAL(src) = _bump_clamp(r);
+             G_VAL(src) = _bump_clamp(g);
+             B_VAL(src) = _bump_clamp(b);
+             lightx++;
+             src++;
+          } while (--i >= 0);
+        lighty++;
+     }
+}
+
+static void
+_params_set(E_Efx_Bumpmap_Params *p, int x, int y, int z, int depth, int color, int ambient)
+{
+   // same scaling as _bumpmap()
+   p->x = x;
+   p->y = y;
+   p->z = z;
+   p->z_2 = z * z;
+   p->red = p->green = p->blue = color / 0x100;
+   p->ambient = ambient / 0x100;
+   p->depth = (depth / 0x100) / (255 * (255 + 255 + 255));
+}
+
+static void
+_image_fill(unsigned int *img, int n)
+{
+   int i;
+
+   for (i = 0; i < n; i++)
+     img[i] = (_bench_rand() << 17) ^ (_bench_rand() << 2) ^ _bench_rand();
+}
+
+static Eina_Bool
+_check(const E_Efx_Bumpmap_Params *p, int w, int h)
+{
+   unsigned int *img, *ref, *out;
+   Eina_Bool ok = EINA_FALSE;
+   int i;
+
+   img = malloc(w * h * sizeof(unsigned int));
+   ref = malloc(w * h * sizeof(unsigned int));
+   out = malloc(w * h * sizeof(unsigned int));
+   if ((!img) || (!ref) || (!out)) goto done;
+   _image_fill(img, w * h);
+   _ref_bumpmap(p, img, ref, w, h);
+   // in two bands like the threaded path splits it
+   _bumpmap_rows(p, img, out, w, h, 0, h / 2);
+   _bumpmap_rows(p, img, out, w, h, h / 2, h);
+   for (i = 0; i < (w * h); i++)
+     {
+        if (ref[i] == out[i]) continue;
+        fprintf(stderr, "BENCH: %ix%i depth %i light %i,%i: pixel %i,%i is "
+                "%08x, want %08x\n", w, h, p->depth, p->x, p->y,
+                i % w, i / w, out[i], ref[i]);
+        goto done;
+     }
+   ok = EINA_TRUE;
+done:
+   free(img);
+   free(ref);
+   free(out);
+   return ok;
+}
+
+typedef void (*Bump_Func)(const E_Efx_Bumpmap_Params *p, const unsigned int *img, unsigned int *out, int w, int h);
+
+static void
+_kernel(const E_Efx_Bumpmap_Params *p, const unsigned int *img, unsigned int *out, int w, int h)
+{
+   _bumpmap_rows(p, img, out, w, h, 0, h);
+}
+
+static double
+_time(const char *name, Bump_Func func, const E_Efx_Bumpmap_Params *p, int w, int h, double secs)
+{
+   unsigned int *img, *out;
+   unsigned long long t0, t, n = 0;
+   double per;
+
+   img = malloc(w * h * sizeof(unsigned int));
+   out = malloc(w * h * sizeof(unsigned int));
+   if ((!img) || (!out))
+     {
+        free(img);
+        free(out);
+        return 0.0;
+     }
+   _image_fill(img, w * h);
+   t0 = _bench_now();
+   do
+     {
+        func(p, img, out, w, h);
+        n++;
+        t = _bench_now() - t0;
+     }
+   while (t < (secs * 1000000000.0));
+   per = (double)t / (double)(n * w * h);
+   printf("BENCH %s: %llu passes of %ix%i, %1.2f ns/pixel\n",
+          name, n, w, h, per);
+   free(img);
+   free(out);
+   return per;
+}
+
+int
+main(int argc EINA_UNUSED, char **argv EINA_UNUSED)
+{
+   static const int sizes[][2] =
+   {
+      { 1, 1 }, { 2, 3 }, { 3, 2 }, { 4, 4 }, { 5, 5 }, { 7, 3 },
+      { 8, 8 }, { 9, 17 }, { 37, 29 }, { 64, 64 }, { 255, 33 }
+   };
+   E_Efx_Bumpmap_Params p;
+   const char *s;
+   double secs = 0.5, ref, vec;
+   unsigned int i, fails = 0, checks = 0;
+   int depth;
+
+   s = getenv("E_BENCH_TIME");
+   if (s) secs = MAX(atof(s), 0.01);
+   // e_efx_bumpmap()'s own defaults first, then depths big enough that
+   // normals are non-zero and, at the top end, overflow int like they did
+   for (depth = 0; depth < 4; depth++)
+     {
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+          {
+             _params_set(&p, (_bench_rand() % 300) - 50,
+                         (_bench_rand() % 300) - 50, 30,
+                         depth ? depth * 0x100 * 255 * 765 : 0x200,
+                         0x200 + (depth * 0x80), depth * 0x40);
+             checks++;
+             if (!_check(&p, sizes[i][0], sizes[i][1])) fails++;
+          }
+     }
+   printf("BENCH bump_equivalence: %u of %u cases match\n",
+          checks - fails, checks);
+
+   _params_set(&p, 100, 100, 30, 0x100 * 255 * 765, 0x200, 0);
+   ref = _time("bump_ref_512", _ref_bumpmap, &p, 512, 512, secs);
+   vec = _time("bump_rows_512", _kernel, &p, 512, 512, secs);
+   if (vec > 0.0) printf("BENCH bump_speedup: %1.2fx\n", ref / vec);
+   return fails ? 1 : 0;
+}
@@ -0,0 +1,173 @@
+#include "e_system.h"
+
+/* drives the ddc workers from enlightenment_system against fake_ddcutil.c
+ * (found as libddcutil.so.2 via LD_LIBRARY_PATH) instead of the stdin/out
+ * protocol. a burst of brightness sets goes to the slow monitor and one set
+ * to the fast one. the fast one must not wait behind the slow queue, and
+ * the slow one must only see the newest value once its worker catches up.
+ *
+ * env:
+ *   E_BENCH_DDC_SETS    - sets sent to the slow monitor (default: 100)
+ *   E_BENCH_DDC_SLOW_MS - ms each set takes on the slow monitor (50)
+ */
+
+typedef struct
+{
+   void (*func) (void *data, const char *params);
+   void *data;
+} Handler;
+
+Eina_Bool alert_backlight_reset = EINA_FALSE;
+
+static Eina_Hash *_cmd_handlers = NULL;
+static char _edid_slow[257], _edid_fast[257];
+static int _sets = 100, _slow_ms = 50;
+static double _t0 = 0.0, _t_fast = 0.0, _t_slow = 0.0;
+static Eina_Bool _got_fast = EINA_FALSE, _got_slow = EINA_FALSE;
+static int _ret = 1;
+
+void
+e_system_inout_command_register(const char *cmd, void (*func) (void *data, const char *params), void *data)
+{
+   Handler *h = calloc(1, sizeof(Handler));
+
+   if (!h) return;
+   h->func = func;
+   h->data = data;
+   eina_hash_add(_cmd_handlers, cmd, h);
+}
+
+static void
+_command(const char *cmd, const char *fmt, ...)
+{
+   Handler *h;
+   va_list ap;
+   char buf[1024];
+
+   h = eina_hash_find(_cmd_handlers, cmd);
+   if (!h) return;
+   va_start(ap, fmt);
+   vsnprintf(buf, sizeof(buf), fmt, ap);
+   va_end(ap);
+   h->func(h->data, buf);
+}
+
+static void
+_done(void)
+{
+   int (*sets_get) (int screen);
+   int (*val_get) (int screen);
+   void *lib;
+   int sets, val;
+
+   lib = dlopen("libddcutil.so.2", RTLD_NOW | RTLD_LOCAL);
+   sets_get = lib ? dlsym(lib, "fake_ddc_sets_get") : NULL;
+   val_get = lib ? dlsym(lib, "fake_ddc_val_get") : NULL;
+   if ((!sets_get) || (!val_get))
+     {
+        fprintf(stderr, "BENCH: libddcutil.so.2 is not the fake one\n");
+        ecore_main_loop_quit();
+        return;
+     }
+   sets = sets_get(0);
+   val = val_get(0);
+   printf("BENCH ddc_fast_monitor_latency: %1.3f ms\n", _t_fast * 1000.0);
+   printf("BENCH ddc_slow_monitor_settle: %1.3f ms\n", _t_slow * 1000.0);
+   printf("BENCH ddc_slow_monitor_writes: %i of %i sets\n", sets, _sets);
+   _ret = 0;
+   if (val != (_sets - 1))
+     {
+        fprintf(stderr, "BENCH: slow monitor ended at %i, not %i\n",
+                val, _sets - 1);
+        _ret = 1;
+     }
+   // the first set is in flight while the rest pile up, so they all fold
+   // into one or two more writes
+   if ((_sets > 4) && (sets > 3))
+     {
+        fprintf(stderr, "BENCH: %i sets reached the slow monitor\n", sets);
+        _ret = 1;
+     }
+   if ((_slow_ms > 0) && (_t_fast >= (_slow_ms / 1000.0)))
+     {
+        fprintf(stderr, "BENCH: fast monitor waited behind the slow one\n");
+        _ret = 1;
+     }
+   ecore_main_loop_quit();
+}
+
+void
+e_system_inout_command_send(const char *cmd, const char *fmt, ...)
+{
+   va_list ap;
+   char buf[1024], edid[257], status[8];
+   int id, val, i;
+
+   va_start(ap, fmt);
+   vsnprintf(buf, sizeof(buf), fmt, ap);
+   va_end(ap);
+   if (!strcmp(cmd, "ddc-list"))
+     {
+        if (sscanf(buf, "%256s %256s", _edid_slow, _edid_fast) != 2)
+          {
+             fprintf(stderr, "BENCH: fake ddc monitors not found\n");
+             ecore_main_loop_quit();
+             return;
+          }
+        _t0 = ecore_time_get();
+        for (i = 0; i < _sets; i++)
+          _command("ddc-val-set", "%s %i %i", _edid_slow, 0x10, i);
+        _command("ddc-val-set", "%s %i %i", _edid_fast, 0x10, 42);
+     }
+   else if (!strcmp(cmd, "ddc-val-set"))
+     {
+        if (sscanf(buf, "%256s %i %i %7s", edid, &id, &val, status) != 4)
+          return;
+        if (strcmp(status, "ok"))
+          {
+             fprintf(stderr, "BENCH: set failed: %s\n", buf);
+             ecore_main_loop_quit();
+             return;
+          }
+        if (!strcmp(edid, _edid_fast))
+          {
+             _t_fast = ecore_time_get() - _t0;
+             _got_fast = EINA_TRUE;
+          }
+        else if ((!strcmp(edid, _edid_slow)) && (val == (_sets - 1)))
+          {
+             _t_slow = ecore_time_get() - _t0;
+             _got_slow = EINA_TRUE;
+          }
+        if ((_got_fast) && (_got_slow)) _done();
+     }
+}
+
+static Eina_Bool
+_cb_timeout(void *data EINA_UNUSED)
+{
+   fprintf(stderr, "BENCH: ddc requests timed out\n");
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+int
+main(int argc EINA_UNUSED, char **argv EINA_UNUSED)
+{
+   const char *s;
+
+   s = getenv("E_BENCH_DDC_SETS");
+   if (s) _sets = MAX(atoi(s), 1);
+   s = getenv("E_BENCH_DDC_SLOW_MS");
+   if (s) _slow_ms = atoi(s);
+   eina_init();
+   ecore_init();
+   _cmd_handlers = eina_hash_string_superfast_new(free);
+   e_system_ddc_init();
+   ecore_timer_add(30.0 + ((_sets * _slow_ms) / 1000.0), _cb_timeout, NULL);
+   ecore_main_loop_begin();
+   // the ddc workers never return, so don't wait for them in a shutdown
+   fflush(stdout);
+   _exit(_ret);
+   return _ret;
+}
@@ -0,0 +1,69 @@
+#!/bin/sh
+# run the benchmark module inside a throwaway headless enlightenment
+#
+# usage: e_bench_run.sh [enlightenment_start] <bench.so> [output.json]
+#
+# uses Xvfb if it is around (and E_BENCH_ENGINE is not "wl"), otherwise the
+# wayland wl_buffer backend. all E_BENCH_* env vars are passed through to
+# the module - see e_mod_bench.c
+START="enlightenment_start"
+if [ $# -ge 2 ]; then
+  START="$1"
+  shift
+fi
+MOD="$1"
+OUT="$2"
+if [ -z "$MOD" ] || [ ! -f "$MOD" ]; then
+  echo "usage: $0 [enlightenment_start] <bench.so> [output.json]" >&2
+  exit 1
+fi
+
+TMP=$(mktemp -d "${TMPDIR:-/tmp}/e-bench-XXXXXX") || exit 1
+XPID=""
+cleanup() {
+  [ -n "$XPID" ] && kill "$XPID" 2>/dev/null
+  rm -rf "$TMP"
+}
+trap cleanup EXIT INT TERM
+
+# fresh home so results don't depend on whoever runs it
+export HOME="$TMP/home"
+export XDG_RUNTIME_DIR="$TMP/run"
+export XDG_CONFIG_HOME="$HOME/.config"
+export XDG_CACHE_HOME="$HOME/.cache"
+mkdir -p "$HOME" "$XDG_RUNTIME_DIR"
+chmod 700 "$XDG_RUNTIME_DIR"
+unset WAYLAND_DISPLAY DBUS_SESSION_BUS_ADDRESS
+
+# the standard profile skips the first run wizard
+export E_CONF_PROFILE="${E_CONF_PROFILE:-standard}"
+# everything and notification are needed for the evry and notify benches -
+# skipped if already loaded
+export E_MODULE_EXTRA="everything:notification:$MOD"
+if [ -n "$OUT" ]; then
+  export E_BENCH_OUTPUT="$OUT"
+  rm -f "$OUT"
+fi
+
+if [ "$E_BENCH_ENGINE" != "wl" ] && command -v Xvfb > /dev/null 2>&1; then
+  DISP=":${E_BENCH_DISPLAY:-97}"
+  Xvfb "$DISP" -screen 0 1920x1080x24 -nolisten tcp > /dev/null 2>&1 &
+  XPID=$!
+  sleep 1
+  export DISPLAY="$DISP"
+else
+  unset DISPLAY
+  export E_WL_FORCE=buffer
+fi
+
+if command -v dbus-run-session > /dev/null 2>&1; then
+  dbus-run-session -- "$START"
+else
+  "$START"
+fi
+RET=$?
+if [ -n "$OUT" ]; then
+  [ -s "$OUT" ] || exit 1
+  cat "$OUT"
+fi
+exit $RET
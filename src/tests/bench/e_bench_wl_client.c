@@ -0,0 +1,252 @@
+/* a deliberately slow xdg-shell client for the resize configure bench. it
+ * maps one toplevel, then only acks a configure (and commits a buffer of
+ * the new size) E_BENCH_ACK_MS (default 100) after it arrived, like a
+ * client busy redrawing. every toplevel configure is reported on stdout as
+ * "configure <count> <w> <h> <resizing>" for e_mod_bench.c to read */
+#include "config.h"
+
+#ifndef _GNU_SOURCE
+# define _GNU_SOURCE 1
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <wayland-client.h>
+#include "xdg-shell-client-protocol.h"
+
+#define POOL_MAX 2048
+
+static struct wl_compositor *compositor = NULL;
+static struct wl_shm *shm = NULL;
+static struct xdg_wm_base *wm_base = NULL;
+static struct wl_shm_pool *pool = NULL;
+static struct wl_surface *surface = NULL;
+static struct xdg_surface *xsurface = NULL;
+static int width = 200, height = 200, next_w = 0, next_h = 0;
+static int ack_ms = 100, running = 1;
+static unsigned int configures = 0;
+static unsigned int ack_serial = 0;
+static long long ack_time = -1;
+
+static long long
+_now_ms(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((long long)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+}
+
+static int
+_pool_fd_new(size_t size)
+{
+   int fd;
+#ifdef MFD_CLOEXEC
+   fd = memfd_create("e-bench-wl-client", MFD_CLOEXEC);
+#else
+   char buf[4096];
+   const char *dir = getenv("XDG_RUNTIME_DIR");
+
+   if (!dir) dir = "/tmp";
+   snprintf(buf, sizeof(buf), "%s/e-bench-wl-client-XXXXXX", dir);
+   fd = mkostemp(buf, O_CLOEXEC);
+   if (fd >= 0) unlink(buf);
+#endif
+   if (fd < 0) return -1;
+   if (ftruncate(fd, size) < 0)
+     {
+        close(fd);
+        return -1;
+     }
+   return fd;
+}
+
+static void
+_buffer_release(void *data, struct wl_buffer *buffer)
+{
+   (void)data;
+   wl_buffer_destroy(buffer);
+}
+
+static const struct wl_buffer_listener _buffer_listener =
+{
+   _buffer_release
+};
+
+static void
+_draw(void)
+{
+   struct wl_buffer *buffer;
+
+   // contents don't matter, only that a buffer of the acked size arrives
+   buffer = wl_shm_pool_create_buffer(pool, 0, width, height, width * 4,
+                                      WL_SHM_FORMAT_XRGB8888);
+   wl_buffer_add_listener(buffer, &_buffer_listener, NULL);
+   wl_surface_attach(surface, buffer, 0, 0);
+   wl_surface_damage(surface, 0, 0, width, height);
+   wl_surface_commit(surface);
+}
+
+static void
+_wm_base_ping(void *data, struct xdg_wm_base *base, uint32_t serial)
+{
+   (void)data;
+   xdg_wm_base_pong(base, serial);
+}
+
+static const struct xdg_wm_base_listener _wm_base_listener =
+{
+   _wm_base_ping
+};
+
+static void
+_xsurface_configure(void *data, struct xdg_surface *xs, uint32_t serial)
+{
+   (void)data;
+   (void)xs;
+   // only the newest configure needs an ack, so a later one just moves it
+   ack_serial = serial;
+   if (ack_time < 0) ack_time = _now_ms() + ack_ms;
+}
+
+static const struct xdg_surface_listener _xsurface_listener =
+{
+   _xsurface_configure
+};
+
+static void
+_toplevel_configure(void *data, struct xdg_toplevel *top, int32_t w, int32_t h, struct wl_array *states)
+{
+   uint32_t *state;
+   int resizing = 0;
+
+   (void)data;
+   (void)top;
+   wl_array_for_each(state, states)
+     {
+        if (*state == XDG_TOPLEVEL_STATE_RESIZING) resizing = 1;
+     }
+   next_w = w;
+   next_h = h;
+   configures++;
+   printf("configure %u %i %i %i\n", configures, w, h, resizing);
+   fflush(stdout);
+}
+
+static void
+_toplevel_close(void *data, struct xdg_toplevel *top)
+{
+   (void)data;
+   (void)top;
+   running = 0;
+}
+
+static const struct xdg_toplevel_listener _toplevel_listener =
+{
+   _toplevel_configure,
+   _toplevel_close
+};
+
+static void
+_registry_global(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version)
+{
+   (void)data;
+   (void)version;
+   if (!strcmp(interface, wl_compositor_interface.name))
+     compositor = wl_registry_bind(registry, name, &wl_compositor_interface, 1);
+   else if (!strcmp(interface, wl_shm_interface.name))
+     shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+   else if (!strcmp(interface, xdg_wm_base_interface.name))
+     {
+        wm_base = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(wm_base, &_wm_base_listener, NULL);
+     }
+}
+
+static void
+_registry_global_remove(void *data, struct wl_registry *registry, uint32_t name)
+{
+   (void)data;
+   (void)registry;
+   (void)name;
+}
+
+static const struct wl_registry_listener _registry_listener =
+{
+   _registry_global,
+   _registry_global_remove
+};
+
+int
+main(int argc, char **argv)
+{
+   struct wl_display *disp;
+   struct wl_registry *registry;
+   struct xdg_toplevel *toplevel;
+   struct pollfd pfd;
+   const char *s;
+   long long now;
+   int fd, timeout;
+
+   (void)argc;
+   (void)argv;
+   s = getenv("E_BENCH_ACK_MS");
+   if (s) ack_ms = atoi(s);
+   disp = wl_display_connect(NULL);
+   if (!disp)
+     {
+        fprintf(stderr, "cannot connect to the wayland display\n");
+        return 1;
+     }
+   registry = wl_display_get_registry(disp);
+   wl_registry_add_listener(registry, &_registry_listener, NULL);
+   wl_display_roundtrip(disp);
+   if ((!compositor) || (!shm) || (!wm_base))
+     {
+        fprintf(stderr, "compositor lacks wl_compositor, wl_shm or xdg_wm_base\n");
+        return 1;
+     }
+   fd = _pool_fd_new(POOL_MAX * POOL_MAX * 4);
+   if (fd < 0) return 1;
+   pool = wl_shm_create_pool(shm, fd, POOL_MAX * POOL_MAX * 4);
+   close(fd);
+
+   surface = wl_compositor_create_surface(compositor);
+   xsurface = xdg_wm_base_get_xdg_surface(wm_base, surface);
+   xdg_surface_add_listener(xsurface, &_xsurface_listener, NULL);
+   toplevel = xdg_surface_get_toplevel(xsurface);
+   xdg_toplevel_add_listener(toplevel, &_toplevel_listener, NULL);
+   xdg_toplevel_set_app_id(toplevel, "e_bench_configure");
+   xdg_toplevel_set_title(toplevel, "Configure Bench");
+   wl_surface_commit(surface);
+
+   pfd.fd = wl_display_get_fd(disp);
+   pfd.events = POLLIN;
+   while (running)
+     {
+        wl_display_dispatch_pending(disp);
+        wl_display_flush(disp);
+        timeout = -1;
+        if (ack_time >= 0)
+          {
+             now = _now_ms();
+             timeout = (ack_time > now) ? (int)(ack_time - now) : 0;
+          }
+        if (poll(&pfd, 1, timeout) < 0) continue;
+        if ((pfd.revents & POLLIN) && (wl_display_dispatch(disp) < 0)) break;
+        if (pfd.revents & (POLLERR | POLLHUP)) break;
+        if ((ack_time < 0) || (_now_ms() < ack_time)) continue;
+        ack_time = -1;
+        if (next_w > 0) width = next_w < POOL_MAX ? next_w : POOL_MAX;
+        if (next_h > 0) height = next_h < POOL_MAX ? next_h : POOL_MAX;
+        xdg_surface_ack_configure(xsurface, ack_serial);
+        _draw();
+     }
+   wl_display_disconnect(disp);
+   return 0;
+}
@@ -0,0 +1,1459 @@
+#include "e.h"
+#include "evry_api.h"
+#include <time.h>
+
+/* headless benchmark suite - this is loaded into a running e (usually on
+ * xvfb or the wl_buffer backend) via E_MODULE_EXTRA, drives some hot paths
+ * with synthetic data, dumps ns/op as json and then exits e again.
+ *
+ * env:
+ *   E_BENCH_OUTPUT  - file to write json to (default: stdout)
+ *   E_BENCH_TIME    - seconds to spend per benchmark (default: 0.5)
+ *   E_BENCH_CLIENTS - number of windows to map for placement etc. (24)
+ *   E_BENCH_FILES   - number of files for the fm listing bench (2000)
+ *   E_BENCH_CLIP_MB - megabytes to push through the wl clipboard (200)
+ *   E_BENCH_X_WINS  - raw x windows for the property prefetch bench (200)
+ *   E_BENCH_WL_CLIENT - e_bench_wl_client to resize (set by meson)
+ *   E_BENCH_RESIZE_STEPS - pointer motions in that resize (200)
+ *   E_BENCH_ACK_MS  - how long that client takes to ack a configure (100)
+ *   E_BENCH_NOTIFY  - notifications in the dbus flood from one app (1000)
+ *   E_BENCH_FILTER  - only run benchmarks whose name contains this
+ *   E_BENCH_NO_EXIT - stay running after the results are written
+ */
+
+typedef struct
+{
+   const char         *name;
+   unsigned long long  iterations;
+   double              ns_per_op;
+   double              min_ns_per_op;
+} Bench_Result;
+
+typedef void (*Bench_Func)(void *data, unsigned long long n);
+
+typedef struct
+{
+   Evas_Object        *obj;
+   char               *dir;
+   unsigned int        files;
+   unsigned long long  t0;
+   double              timeout;
+   E_Fm2_Config        cfg;
+} Bench_Fm;
+
+static Eina_List *results = NULL;
+static Eina_List *wins = NULL;
+static Ecore_Timer *step_timer = NULL;
+static Bench_Fm *bench_fm = NULL;
+static double bench_time = 0.5;
+static double map_timeout = 0.0;
+static const char *bench_filter = NULL;
+static unsigned int bench_seed = 0x5eed;
+static unsigned int bench_async = 0;
+
+static void _bench_async_next(void);
+
+static unsigned long long
+_bench_now(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((unsigned long long)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+static int
+_bench_rand(void)
+{
+   // own lcg so every run sees the same sequence of synthetic input
+   bench_seed = (bench_seed * 1103515245) + 12345;
+   return (bench_seed >> 16) & 0x7fff;
+}
+
+static Eina_Bool
+_bench_wanted(const char *name)
+{
+   if ((!bench_filter) || (!bench_filter[0])) return EINA_TRUE;
+   return !!strstr(name, bench_filter);
+}
+
+static void
+_bench_result_add(const char *name, unsigned long long iterations,
+                  double ns_per_op, double min_ns_per_op)
+{
+   Bench_Result *r;
+
+   r = E_NEW(Bench_Result, 1);
+   if (!r) return;
+   r->name = eina_stringshare_add(name);
+   r->iterations = iterations;
+   r->ns_per_op = ns_per_op;
+   r->min_ns_per_op = min_ns_per_op;
+   results = eina_list_append(results, r);
+   INF("BENCH %s: %llu iterations, %1.1f ns/op (min %1.1f)",
+       name, iterations, ns_per_op, min_ns_per_op);
+}
+
+static void
+_bench_run(const char *name, Bench_Func func, void *data)
+{
+   unsigned long long n = 1, t, total_t = 0, total_n = 0, budget;
+   double per, min = 0.0;
+
+   if (!_bench_wanted(name)) return;
+   budget = bench_time * 1000000000.0;
+   // calibrate a batch size that takes roughly a tenth of the budget so the
+   // clock overhead vanishes, then run batches until the budget is used up
+   for (;;)
+     {
+        t = _bench_now();
+        func(data, n);
+        t = _bench_now() - t;
+        if ((t >= (budget / 10)) || (n >= (1ULL << 32))) break;
+        if (t < 1000) n *= 16;
+        else n = (n * (budget / 10)) / t + 1;
+     }
+   while (total_t < budget)
+     {
+        t = _bench_now();
+        func(data, n);
+        t = _bench_now() - t;
+        total_t += t;
+        total_n += n;
+        per = (double)t / (double)n;
+        if ((min <= 0.0) || (per < min)) min = per;
+     }
+   _bench_result_add(name, total_n, (double)total_t / (double)total_n, min);
+}
+
+/* e_place */
+
+static void
+_bench_place(void *data, unsigned long long n)
+{
+   E_Desk *desk = data;
+   E_Zone *zone = desk->zone;
+   int rx, ry;
+
+   while (n--)
+     e_place_desk_region_smart(desk, NULL,
+                               zone->x + (_bench_rand() % (zone->w / 2)),
+                               zone->y + (_bench_rand() % (zone->h / 2)),
+                               100 + (_bench_rand() % 400),
+                               100 + (_bench_rand() % 300),
+                               &rx, &ry);
+}
+
+/* e_bindings */
+
+#define BENCH_BINDINGS 200
+
+typedef struct
+{
+   Ecore_Event_Key ev;
+   char            key[64];
+   E_Binding_Modifier mod;
+} Bench_Bind;
+
+static void
+_bench_bindings_event(void *data, unsigned long long n)
+{
+   Bench_Bind *bb = data;
+   E_Binding_Key *bind;
+
+   while (n--)
+     e_bindings_key_event_find(E_BINDING_CONTEXT_WINDOW, &bb->ev, &bind);
+}
+
+static void
+_bench_bindings_find(void *data, unsigned long long n)
+{
+   Bench_Bind *bb = data;
+
+   while (n--)
+     e_bindings_key_find(bb->key, bb->mod, 0);
+}
+
+static void
+_bench_bindings(void)
+{
+   Bench_Bind bb;
+   char buf[64];
+   int i;
+
+   if ((!_bench_wanted("bindings_key_event_find")) &&
+       (!_bench_wanted("bindings_key_find")) &&
+       (!_bench_wanted("bindings_key_event_find_miss")))
+     return;
+   for (i = 0; i < BENCH_BINDINGS; i++)
+     {
+        snprintf(buf, sizeof(buf), "BenchKey%03i", i);
+        e_bindings_key_add((i & 1) ? E_BINDING_CONTEXT_WINDOW : E_BINDING_CONTEXT_ANY,
+                           buf, (i & 2) ? E_BINDING_MODIFIER_CTRL : E_BINDING_MODIFIER_ALT,
+                           0, "bench_none", NULL);
+     }
+   // the last binding added is the one found last
+   memset(&bb, 0, sizeof(bb));
+   snprintf(bb.key, sizeof(bb.key), "BenchKey%03i", BENCH_BINDINGS - 1);
+   bb.mod = ((BENCH_BINDINGS - 1) & 2) ? E_BINDING_MODIFIER_CTRL : E_BINDING_MODIFIER_ALT;
+   bb.ev.key = bb.ev.keyname = bb.key;
+   bb.ev.modifiers = (bb.mod == E_BINDING_MODIFIER_CTRL) ?
+     ECORE_EVENT_MODIFIER_CTRL : ECORE_EVENT_MODIFIER_ALT;
+   _bench_run("bindings_key_event_find", _bench_bindings_event, &bb);
+   _bench_run("bindings_key_find", _bench_bindings_find, &bb);
+   // and a key nobody has bound - the common case when typing
+   bb.ev.key = bb.ev.keyname = "BenchUnbound";
+   bb.ev.modifiers = 0;
+   _bench_run("bindings_key_event_find_miss", _bench_bindings_event, &bb);
+
+   for (i = 0; i < BENCH_BINDINGS; i++)
+     {
+        snprintf(buf, sizeof(buf), "BenchKey%03i", i);
+        e_bindings_key_del((i & 1) ? E_BINDING_CONTEXT_WINDOW : E_BINDING_CONTEXT_ANY,
+                           buf, (i & 2) ? E_BINDING_MODIFIER_CTRL : E_BINDING_MODIFIER_ALT,
+                           0, "bench_none", NULL);
+     }
+}
+
+/* e_remember */
+
+#define BENCH_REMEMBERS 500
+
+static void
+_bench_remember_find(void *data, unsigned long long n)
+{
+   E_Client *ec = data;
+
+   while (n--)
+     e_remember_find(ec);
+}
+
+static void
+_bench_remember(E_Client *ec)
+{
+   E_Remember *rem;
+   Eina_List *rems = NULL;
+   char buf[64];
+   int i;
+
+   if (!_bench_wanted("remember_find_miss")) return;
+   for (i = 0; i < BENCH_REMEMBERS; i++)
+     {
+        rem = e_remember_new();
+        if (!rem) break;
+        snprintf(buf, sizeof(buf), "bench-%i", i);
+        rem->match = E_REMEMBER_MATCH_NAME | E_REMEMBER_MATCH_CLASS;
+        if (i & 1) rem->match |= E_REMEMBER_MATCH_TITLE;
+        rem->name = eina_stringshare_add(buf);
+        rem->class = eina_stringshare_add("Bench");
+        rem->title = eina_stringshare_add(buf);
+        rems = eina_list_append(rems, rem);
+     }
+   // nothing matches the client so every lookup walks the whole list
+   _bench_run("remember_find_miss", _bench_remember_find, ec);
+   EINA_LIST_FREE(rems, rem)
+     e_remember_del(rem);
+}
+
+/* e_comp_object damage */
+
+static void
+_bench_damage(void *data, unsigned long long n)
+{
+   E_Client *ec = data;
+   unsigned long long i;
+   int w = MAX(ec->client.w, 1), h = MAX(ec->client.h, 1);
+
+   for (i = 0; i < n; i++)
+     {
+        e_comp_object_damage(ec->frame,
+                             _bench_rand() % w, _bench_rand() % h,
+                             1 + (_bench_rand() % 64), 1 + (_bench_rand() % 64));
+        // flush the tiler like a render would before it collapses to full
+        if ((i & 63) == 63) e_comp_object_dirty(ec->frame);
+     }
+   e_comp_object_dirty(ec->frame);
+}
+
+/* evry */
+
+#define BENCH_EVRY_STRINGS 1024
+
+static const char *_bench_words[] =
+{
+   "terminal", "browser", "file manager", "settings", "text editor",
+   "image viewer", "music player", "video", "calculator", "archive"
+};
+
+typedef struct
+{
+   Evry_API *api;
+   char     *strings;
+} Bench_Evry;
+
+static void
+_bench_evry_match(void *data, unsigned long long n)
+{
+   Bench_Evry *be = data;
+   unsigned long long i;
+
+   for (i = 0; i < n; i++)
+     be->api->fuzzy_match(be->strings + ((i % BENCH_EVRY_STRINGS) * 64),
+                          "te ed");
+}
+
+static void
+_bench_evry(void)
+{
+   Bench_Evry be;
+   int i;
+
+   if (!_bench_wanted("evry_fuzzy_match")) return;
+   be.api = e_datastore_get("evry_api");
+   if (!be.api)
+     {
+        INF("BENCH: everything module not loaded - skipping evry");
+        return;
+     }
+   be.strings = malloc(BENCH_EVRY_STRINGS * 64);
+   if (!be.strings) return;
+   for (i = 0; i < BENCH_EVRY_STRINGS; i++)
+     {
+        snprintf(be.strings + (i * 64), 64, "%s %s %i",
+                 _bench_words[_bench_rand() % EINA_C_ARRAY_LENGTH(_bench_words)],
+                 _bench_words[_bench_rand() % EINA_C_ARRAY_LENGTH(_bench_words)],
+                 i);
+     }
+   _bench_run("evry_fuzzy_match", _bench_evry_match, &be);
+   free(be.strings);
+}
+
+/* e_exehist - 50k launches over a skewed set of apps. the history itself
+ * keeps the newest 500, so this drives add, trim and the index together */
+
+#define BENCH_EXEHIST_ADDS 50000
+#define BENCH_EXEHIST_APPS 700
+#define BENCH_EXEHIST_KEEP 500
+
+static int
+_bench_exehist_app(void)
+{
+   int r = _bench_rand() % BENCH_EXEHIST_APPS;
+
+   // a few apps get most of the launches, like a real history
+   return (r * r) / BENCH_EXEHIST_APPS;
+}
+
+static void
+_bench_exehist_popularity(void *data EINA_UNUSED, unsigned long long n)
+{
+   unsigned long long i;
+   char buf[64];
+
+   for (i = 0; i < n; i++)
+     {
+        snprintf(buf, sizeof(buf), "/usr/bin/bench-app-%i %%U",
+                 (int)(i % BENCH_EXEHIST_APPS));
+        e_exehist_popularity_get(buf);
+     }
+}
+
+static void
+_bench_exehist_sorted(void *data, unsigned long long n)
+{
+   E_Exehist_Sort sort = (E_Exehist_Sort)(intptr_t)data;
+   unsigned long long i;
+
+   // the strings are the history's own, only the list is ours
+   for (i = 0; i < n; i++)
+     eina_list_free(e_exehist_sorted_list_get(sort, 20));
+}
+
+static Eina_Bool
+_bench_exehist_check(const int *last)
+{
+   int counts[BENCH_EXEHIST_APPS] = { 0 };
+   Eina_List *list, *l;
+   const char *exe;
+   char buf[64];
+   int i, pop, prev = -1;
+   Eina_Bool ok = EINA_TRUE;
+
+   for (i = 0; i < BENCH_EXEHIST_KEEP; i++) counts[last[i]]++;
+   for (i = 0; (ok) && (i < BENCH_EXEHIST_APPS); i++)
+     {
+        snprintf(buf, sizeof(buf), "/usr/bin/bench-app-%i %%U", i);
+        pop = e_exehist_popularity_get(buf);
+        if (pop == counts[i]) continue;
+        ERR("BENCH: bench-app-%i has popularity %i, want %i",
+            i, pop, counts[i]);
+        ok = EINA_FALSE;
+     }
+   list = e_exehist_sorted_list_get(E_EXEHIST_SORT_BY_POPULARITY, 20);
+   EINA_LIST_FOREACH(list, l, exe)
+     {
+        pop = e_exehist_popularity_get(exe);
+        if ((prev >= 0) && (pop > prev))
+          {
+             ERR("BENCH: %s (%i) sorts after a less popular app (%i)",
+                 exe, pop, prev);
+             ok = EINA_FALSE;
+          }
+        prev = pop;
+     }
+   eina_list_free(list);
+   return ok;
+}
+
+static void
+_bench_exehist(void)
+{
+   int last[BENCH_EXEHIST_KEEP];
+   unsigned long long t;
+   char buf[64];
+   int i, app;
+
+   if ((!_bench_wanted("exehist_add")) &&
+       (!_bench_wanted("exehist_popularity_get")) &&
+       (!_bench_wanted("exehist_sorted")))
+     return;
+   e_exehist_clear();
+   t = _bench_now();
+   for (i = 0; i < BENCH_EXEHIST_ADDS; i++)
+     {
+        app = _bench_exehist_app();
+        last[i % BENCH_EXEHIST_KEEP] = app;
+        snprintf(buf, sizeof(buf), "/usr/bin/bench-app-%i %%U", app);
+        e_exehist_add("bench", buf);
+     }
+   t = _bench_now() - t;
+   if (!_bench_exehist_check(last))
+     {
+        ERR("BENCH: exec history index is wrong - skipping exehist");
+        e_exehist_clear();
+        return;
+     }
+   if (_bench_wanted("exehist_add"))
+     _bench_result_add("exehist_add", BENCH_EXEHIST_ADDS,
+                       (double)t / BENCH_EXEHIST_ADDS,
+                       (double)t / BENCH_EXEHIST_ADDS);
+   _bench_run("exehist_popularity_get", _bench_exehist_popularity, NULL);
+   _bench_run("exehist_sorted_popularity", _bench_exehist_sorted,
+              (void *)(intptr_t)E_EXEHIST_SORT_BY_POPULARITY);
+   _bench_run("exehist_sorted_date", _bench_exehist_sorted,
+              (void *)(intptr_t)E_EXEHIST_SORT_BY_DATE);
+   _bench_run("exehist_sorted_exe", _bench_exehist_sorted,
+              (void *)(intptr_t)E_EXEHIST_SORT_BY_EXE);
+   e_exehist_clear();
+}
+
+/* output */
+
+static void
+_bench_output(void)
+{
+   Bench_Result *r;
+   Eina_List *l;
+   const char *file;
+   FILE *f = stdout;
+
+   file = getenv("E_BENCH_OUTPUT");
+   if ((file) && (file[0]))
+     {
+        f = fopen(file, "w");
+        if (!f)
+          {
+             ERR("BENCH: cannot write %s", file);
+             f = stdout;
+          }
+     }
+   fprintf(f, "{\n");
+   fprintf(f, "  \"version\": \"%s\",\n", VERSION);
+   fprintf(f, "  \"engine\": \"%s\",\n",
+           (e_comp->comp_type == E_PIXMAP_TYPE_X) ? "x11" : "wl");
+   fprintf(f, "  \"seconds_per_benchmark\": %1.3f,\n", bench_time);
+   fprintf(f, "  \"benchmarks\": [");
+   EINA_LIST_FOREACH(results, l, r)
+     {
+        fprintf(f, "%s\n    { \"name\": \"%s\", \"iterations\": %llu, "
+                "\"ns_per_op\": %1.2f, \"min_ns_per_op\": %1.2f }",
+                (l == results) ? "" : ",",
+                r->name, r->iterations, r->ns_per_op, r->min_ns_per_op);
+     }
+   fprintf(f, "\n  ]\n}\n");
+   if (f != stdout) fclose(f);
+   else fflush(f);
+}
+
+static void
+_bench_finish(void)
+{
+   Evas_Object *win;
+
+   EINA_LIST_FREE(wins, win)
+     evas_object_del(win);
+   _bench_output();
+   if (getenv("E_BENCH_NO_EXIT")) return;
+   e_sys_action_do(E_SYS_EXIT, NULL);
+}
+
+/* e_fm - async, the listing comes back from the fm slave over ipc */
+
+static void
+_bench_fm_free(void)
+{
+   if (!bench_fm) return;
+   E_FREE_FUNC(bench_fm->obj, evas_object_del);
+   if (bench_fm->dir)
+     {
+        ecore_file_recursive_rm(bench_fm->dir);
+        free(bench_fm->dir);
+     }
+   E_FREE(bench_fm);
+}
+
+static Eina_Bool
+_bench_fm_cb_poll(void *data EINA_UNUSED)
+{
+   Eina_List *icons;
+   unsigned int count;
+   unsigned long long t;
+
+   icons = e_fm2_all_list_get(bench_fm->obj);
+   count = eina_list_count(icons);
+   eina_list_free(icons);
+   t = _bench_now() - bench_fm->t0;
+   if (count < bench_fm->files)
+     {
+        if (((double)t / 1000000000.0) < bench_fm->timeout)
+          return ECORE_CALLBACK_RENEW;
+        ERR("BENCH: fm listing timed out with %u/%u icons",
+            count, bench_fm->files);
+     }
+   else
+     _bench_result_add("fm_icon_insert", count,
+                       (double)t / (double)count, (double)t / (double)count);
+   step_timer = NULL;
+   _bench_fm_free();
+   _bench_async_next();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_fm_start(void)
+{
+   Eina_Tmpstr *dir = NULL;
+   const char *s;
+   char buf[PATH_MAX];
+   unsigned int i;
+   FILE *f;
+
+   if (!_bench_wanted("fm_icon_insert")) return EINA_FALSE;
+   if (!eina_file_mkdtemp("e-bench-fm-XXXXXX", &dir)) return EINA_FALSE;
+   bench_fm = E_NEW(Bench_Fm, 1);
+   if (!bench_fm)
+     {
+        ecore_file_recursive_rm(dir);
+        eina_tmpstr_del(dir);
+        return EINA_FALSE;
+     }
+   bench_fm->dir = strdup(dir);
+   eina_tmpstr_del(dir);
+   if (!bench_fm->dir)
+     {
+        E_FREE(bench_fm);
+        return EINA_FALSE;
+     }
+   bench_fm->files = 2000;
+   s = getenv("E_BENCH_FILES");
+   if (s) bench_fm->files = MAX(atoi(s), 1);
+   bench_fm->timeout = 60.0;
+   for (i = 0; i < bench_fm->files; i++)
+     {
+        snprintf(buf, sizeof(buf), "%s/file-%05u.txt", bench_fm->dir, i);
+        f = fopen(buf, "w");
+        if (!f)
+          {
+             _bench_fm_free();
+             return EINA_FALSE;
+          }
+        fclose(f);
+     }
+   bench_fm->cfg.view.mode = E_FM2_VIEW_MODE_GRID_ICONS;
+   bench_fm->cfg.icon.icon.w = 48;
+   bench_fm->cfg.icon.icon.h = 48;
+   bench_fm->cfg.icon.list.w = 24;
+   bench_fm->cfg.icon.list.h = 24;
+   bench_fm->cfg.icon.fixed.w = 1;
+   bench_fm->cfg.icon.fixed.h = 1;
+   bench_fm->cfg.list.sort.no_case = 1;
+   bench_fm->cfg.selection.single = 1;
+   bench_fm->obj = e_fm2_add(e_comp->evas);
+   e_fm2_config_set(bench_fm->obj, &(bench_fm->cfg));
+   evas_object_resize(bench_fm->obj, 800, 600);
+   evas_object_show(bench_fm->obj);
+   bench_fm->t0 = _bench_now();
+   e_fm2_path_set(bench_fm->obj, NULL, bench_fm->dir);
+   step_timer = ecore_timer_loop_add(0.001, _bench_fm_cb_poll, NULL);
+   return EINA_TRUE;
+}
+
+/* wl clipboard - async, owner pipe -> saved copy -> receiver pipe */
+
+#ifdef HAVE_WAYLAND
+typedef struct
+{
+   E_Comp_Wl_Clipboard_Source *source;
+   Ecore_Fd_Handler   *owner;
+   Ecore_Fd_Handler   *receiver;
+   int                 owner_fd;
+   int                 receiver_fd;
+   size_t              total;
+   size_t              written;
+   size_t              received;
+   unsigned long long  t0;
+   char                buf[65536];
+} Bench_Clip;
+
+static Bench_Clip *bench_clip = NULL;
+
+static void
+_bench_clip_free(void)
+{
+   if (!bench_clip) return;
+   E_FREE_FUNC(bench_clip->owner, ecore_main_fd_handler_del);
+   E_FREE_FUNC(bench_clip->receiver, ecore_main_fd_handler_del);
+   if (bench_clip->owner_fd >= 0) close(bench_clip->owner_fd);
+   if (bench_clip->receiver_fd >= 0) close(bench_clip->receiver_fd);
+   if (bench_clip->source)
+     e_comp_wl_clipboard_source_unref(bench_clip->source);
+   E_FREE(bench_clip);
+}
+
+static void
+_bench_clip_done(void)
+{
+   unsigned long long t;
+
+   t = _bench_now() - bench_clip->t0;
+   if (bench_clip->received != bench_clip->total)
+     ERR("BENCH: clipboard transfer got %zu/%zu bytes",
+         bench_clip->received, bench_clip->total);
+   else
+     // one op is one megabyte through the whole save + offer path
+     _bench_result_add("wl_clipboard_transfer", bench_clip->total >> 20,
+                       (double)t / (double)(bench_clip->total >> 20),
+                       (double)t / (double)(bench_clip->total >> 20));
+   _bench_clip_free();
+   _bench_async_next();
+}
+
+static Eina_Bool
+_bench_clip_cb_owner(void *data EINA_UNUSED, Ecore_Fd_Handler *fdh EINA_UNUSED)
+{
+   size_t size;
+   ssize_t len;
+
+   size = MIN(sizeof(bench_clip->buf), bench_clip->total - bench_clip->written);
+   len = write(bench_clip->owner_fd, bench_clip->buf, size);
+   if ((len < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+     return ECORE_CALLBACK_RENEW;
+   if (len > 0) bench_clip->written += len;
+   if ((len > 0) && (bench_clip->written < bench_clip->total))
+     return ECORE_CALLBACK_RENEW;
+   // closing the pipe is what tells the compositor the copy is complete
+   close(bench_clip->owner_fd);
+   bench_clip->owner_fd = -1;
+   bench_clip->owner = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_clip_cb_receiver(void *data EINA_UNUSED, Ecore_Fd_Handler *fdh EINA_UNUSED)
+{
+   ssize_t len;
+
+   len = read(bench_clip->receiver_fd, bench_clip->buf, sizeof(bench_clip->buf));
+   if ((len < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+     return ECORE_CALLBACK_RENEW;
+   if (len > 0)
+     {
+        bench_clip->received += len;
+        return ECORE_CALLBACK_RENEW;
+     }
+   bench_clip->receiver = NULL;
+   _bench_clip_done();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_clip_start(void)
+{
+   const char *s;
+   int owner[2], receiver[2];
+   size_t mb = 200;
+
+   if (e_comp->comp_type != E_PIXMAP_TYPE_WL) return EINA_FALSE;
+   if (!_bench_wanted("wl_clipboard_transfer")) return EINA_FALSE;
+   s = getenv("E_BENCH_CLIP_MB");
+   if (s) mb = MAX(atoi(s), 1);
+   if (pipe2(owner, O_CLOEXEC | O_NONBLOCK) < 0) return EINA_FALSE;
+   if (pipe2(receiver, O_CLOEXEC | O_NONBLOCK) < 0)
+     {
+        close(owner[0]);
+        close(owner[1]);
+        return EINA_FALSE;
+     }
+   bench_clip = E_NEW(Bench_Clip, 1);
+   if (!bench_clip) goto err;
+   bench_clip->owner_fd = owner[1];
+   bench_clip->receiver_fd = receiver[0];
+   bench_clip->total = mb << 20;
+   memset(bench_clip->buf, 'x', sizeof(bench_clip->buf));
+   bench_clip->t0 = _bench_now();
+   bench_clip->source =
+     e_comp_wl_clipboard_source_create("text/plain;charset=utf-8", 0, owner[0]);
+   if (!bench_clip->source) goto err_clip;
+   bench_clip->owner =
+     ecore_main_fd_handler_add(owner[1], ECORE_FD_WRITE,
+                               _bench_clip_cb_owner, NULL, NULL, NULL);
+   bench_clip->receiver =
+     ecore_main_fd_handler_add(receiver[0], ECORE_FD_READ | ECORE_FD_ERROR,
+                               _bench_clip_cb_receiver, NULL, NULL, NULL);
+   if ((!bench_clip->owner) || (!bench_clip->receiver))
+     {
+        close(receiver[1]);
+        _bench_clip_free();
+        return EINA_FALSE;
+     }
+   // ask for it straight away so the offer waits on the save like a paste would
+   bench_clip->source->data_source.send(&bench_clip->source->data_source,
+                                        "text/plain;charset=utf-8", receiver[1]);
+   return EINA_TRUE;
+
+err_clip:
+   E_FREE(bench_clip);
+   close(owner[0]);
+err:
+   close(owner[1]);
+   close(receiver[0]);
+   close(receiver[1]);
+   return EINA_FALSE;
+}
+#else
+static void
+_bench_clip_free(void)
+{
+}
+
+static Eina_Bool
+_bench_clip_start(void)
+{
+   return EINA_FALSE;
+}
+#endif
+
+/* x property prefetch - async, raw x windows with every property the
+ * fetch hook prefetches set, checked against what e read back */
+
+#ifndef HAVE_WAYLAND_ONLY
+typedef struct
+{
+   Ecore_X_Window    *wins;
+   unsigned int       num;
+   unsigned long long t0;
+   double             timeout;
+   Eina_Bool          changed E_BITFIELD;
+} Bench_Xprop;
+
+static Bench_Xprop *bench_xprop = NULL;
+
+static void
+_bench_xprop_free(void)
+{
+   unsigned int i;
+
+   if (!bench_xprop) return;
+   for (i = 0; i < bench_xprop->num; i++)
+     ecore_x_window_free(bench_xprop->wins[i]);
+   free(bench_xprop->wins);
+   E_FREE(bench_xprop);
+}
+
+static Eina_Bool
+_bench_xprop_check(unsigned int i, E_Client *ec)
+{
+   char buf[64], buf2[64];
+
+   snprintf(buf, sizeof(buf), "%s %u", bench_xprop->changed ? "changed" : "title", i);
+   if (e_util_strcmp(ec->icccm.title, buf)) return EINA_FALSE;
+   if (bench_xprop->changed) return EINA_TRUE;
+   snprintf(buf, sizeof(buf), "netwm %u", i);
+   if (e_util_strcmp(ec->netwm.name, buf)) return EINA_FALSE;
+   snprintf(buf, sizeof(buf), "bench-%u", i);
+   if (e_util_strcmp(ec->icccm.name, buf)) return EINA_FALSE;
+   if (e_util_strcmp(ec->icccm.class, "EBench")) return EINA_FALSE;
+   snprintf(buf, sizeof(buf), "role-%u", i);
+   if (e_util_strcmp(ec->icccm.window_role, buf)) return EINA_FALSE;
+   snprintf(buf, sizeof(buf), "icon %u", i);
+   snprintf(buf2, sizeof(buf2), "netwm icon %u", i);
+   if ((e_util_strcmp(ec->icccm.icon_name, buf)) ||
+       (e_util_strcmp(ec->netwm.icon_name, buf2)))
+     return EINA_FALSE;
+   if (ec->icccm.transient_for != ((i & 1) ? bench_xprop->wins[0] : 0))
+     return EINA_FALSE;
+   if (ec->icccm.window_group != bench_xprop->wins[0]) return EINA_FALSE;
+   return !!ec->icccm.delete_request;
+}
+
+static Eina_Bool
+_bench_xprop_cb_poll(void *data EINA_UNUSED)
+{
+   E_Client *ec;
+   unsigned long long t;
+   unsigned int i, ok = 0, bad = 0;
+   char buf[64];
+
+   for (i = 0; i < bench_xprop->num; i++)
+     {
+        ec = e_pixmap_find_client(E_PIXMAP_TYPE_X, bench_xprop->wins[i]);
+        if ((!ec) || (ec->new_client) || (ec->changes.prop)) continue;
+        if (_bench_xprop_check(i, ec)) ok++;
+        else bad++;
+     }
+   t = _bench_now() - bench_xprop->t0;
+   if ((ok < bench_xprop->num) &&
+       (((double)t / 1000000000.0) < bench_xprop->timeout))
+     return ECORE_CALLBACK_RENEW;
+   if (ok < bench_xprop->num)
+     ERR("BENCH: x prefetch %s: %u ok, %u wrong of %u windows",
+         bench_xprop->changed ? "change" : "manage", ok, bad, bench_xprop->num);
+   else
+     _bench_result_add(bench_xprop->changed ? "x_prefetch_change" : "x_prefetch_manage",
+                       ok, (double)t / (double)ok, (double)t / (double)ok);
+   if ((ok == bench_xprop->num) && (!bench_xprop->changed))
+     {
+        // now through PropertyNotify on managed clients
+        bench_xprop->changed = EINA_TRUE;
+        bench_xprop->t0 = _bench_now();
+        for (i = 0; i < bench_xprop->num; i++)
+          {
+             snprintf(buf, sizeof(buf), "changed %u", i);
+             ecore_x_icccm_title_set(bench_xprop->wins[i], buf);
+          }
+        ecore_x_flush();
+        return ECORE_CALLBACK_RENEW;
+     }
+   step_timer = NULL;
+   _bench_xprop_free();
+   _bench_async_next();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_xprop_start(void)
+{
+   Ecore_X_Window win;
+   E_Zone *zone;
+   const char *s;
+   unsigned int i;
+   char buf[64];
+
+   if (e_comp->comp_type != E_PIXMAP_TYPE_X) return EINA_FALSE;
+   if ((!_bench_wanted("x_prefetch_manage")) &&
+       (!_bench_wanted("x_prefetch_change")))
+     return EINA_FALSE;
+   bench_xprop = E_NEW(Bench_Xprop, 1);
+   if (!bench_xprop) return EINA_FALSE;
+   bench_xprop->num = 200;
+   s = getenv("E_BENCH_X_WINS");
+   if (s) bench_xprop->num = MAX(atoi(s), 1);
+   bench_xprop->timeout = 60.0;
+   bench_xprop->wins = calloc(bench_xprop->num, sizeof(Ecore_X_Window));
+   if (!bench_xprop->wins)
+     {
+        E_FREE(bench_xprop);
+        return EINA_FALSE;
+     }
+   zone = e_zone_current_get();
+   for (i = 0; i < bench_xprop->num; i++)
+     {
+        win = ecore_x_window_new(0, zone->x + (_bench_rand() % (zone->w / 2)),
+                                 zone->y + (_bench_rand() % (zone->h / 2)),
+                                 64 + (_bench_rand() % 200),
+                                 64 + (_bench_rand() % 200));
+        if (!win) break;
+        bench_xprop->wins[i] = win;
+        snprintf(buf, sizeof(buf), "title %u", i);
+        ecore_x_icccm_title_set(win, buf);
+        snprintf(buf, sizeof(buf), "netwm %u", i);
+        ecore_x_netwm_name_set(win, buf);
+        snprintf(buf, sizeof(buf), "bench-%u", i);
+        ecore_x_icccm_name_class_set(win, buf, "EBench");
+        snprintf(buf, sizeof(buf), "role-%u", i);
+        ecore_x_icccm_window_role_set(win, buf);
+        snprintf(buf, sizeof(buf), "icon %u", i);
+        ecore_x_icccm_icon_name_set(win, buf);
+        snprintf(buf, sizeof(buf), "netwm icon %u", i);
+        ecore_x_netwm_icon_name_set(win, buf);
+        ecore_x_icccm_hints_set(win, 1, ECORE_X_WINDOW_STATE_HINT_NORMAL,
+                                0, 0, 0, bench_xprop->wins[0], 0);
+        ecore_x_icccm_protocol_set(win, ECORE_X_WM_PROTOCOL_DELETE_REQUEST, 1);
+        if (i & 1) ecore_x_icccm_transient_for_set(win, bench_xprop->wins[0]);
+     }
+   if (i < bench_xprop->num)
+     {
+        bench_xprop->num = i;
+        _bench_xprop_free();
+        return EINA_FALSE;
+     }
+   bench_xprop->t0 = _bench_now();
+   for (i = 0; i < bench_xprop->num; i++)
+     ecore_x_window_show(bench_xprop->wins[i]);
+   ecore_x_flush();
+   step_timer = ecore_timer_loop_add(0.001, _bench_xprop_cb_poll, NULL);
+   return EINA_TRUE;
+}
+#else
+static void
+_bench_xprop_free(void)
+{
+}
+
+static Eina_Bool
+_bench_xprop_start(void)
+{
+   return EINA_FALSE;
+}
+#endif
+
+/* wl resize configures - async, an interactive resize of a client that is
+ * slow to ack, counting the configures it gets */
+
+#ifdef HAVE_WAYLAND
+typedef struct
+{
+   Ecore_Exe           *exe;
+   Ecore_Event_Handler *handler;
+   E_Client            *ec;
+   unsigned int        configures;
+   unsigned int        configures_start;
+   unsigned int        steps;
+   unsigned int        step;
+   int                 last_w, last_h;
+   int                 start_w, start_h;
+   unsigned long long  t0;
+   double              timeout;
+   Eina_Bool           resizing E_BITFIELD;
+   Eina_Bool           ended E_BITFIELD;
+   Eina_Bool           done E_BITFIELD;
+} Bench_Cfg;
+
+static Bench_Cfg *bench_cfg = NULL;
+
+static void
+_bench_cfg_free(void)
+{
+   if (!bench_cfg) return;
+   if ((bench_cfg->ec) && (e_client_util_resizing_get(bench_cfg->ec)))
+     e_client_act_resize_end(bench_cfg->ec, NULL);
+   E_FREE_FUNC(bench_cfg->handler, ecore_event_handler_del);
+   if (bench_cfg->exe)
+     {
+        ecore_exe_terminate(bench_cfg->exe);
+        ecore_exe_free(bench_cfg->exe);
+     }
+   E_FREE(bench_cfg);
+}
+
+static Eina_Bool
+_bench_cfg_cb_data(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Exe_Event_Data *ev = event;
+   unsigned int n;
+   int i, w, h, resizing;
+
+   if ((!bench_cfg) || (ev->exe != bench_cfg->exe) || (!ev->lines))
+     return ECORE_CALLBACK_PASS_ON;
+   for (i = 0; ev->lines[i].line; i++)
+     {
+        if (sscanf(ev->lines[i].line, "configure %u %i %i %i",
+                   &n, &w, &h, &resizing) != 4)
+          continue;
+        bench_cfg->configures = n;
+        bench_cfg->last_w = w;
+        bench_cfg->last_h = h;
+        // the configure that ends the resize is never held back
+        if ((bench_cfg->ended) && (!resizing)) bench_cfg->done = EINA_TRUE;
+     }
+   return ECORE_CALLBACK_DONE;
+}
+
+static E_Client *
+_bench_cfg_client_find(void)
+{
+   const Eina_List *l;
+   E_Client *ec;
+
+   EINA_LIST_FOREACH(e_comp->clients, l, ec)
+     {
+        if (e_object_is_del(E_OBJECT(ec))) continue;
+        if ((ec->new_client) || (!ec->visible) || (!ec->frame)) continue;
+        if (!e_util_strcmp(ec->icccm.class, "e_bench_configure")) return ec;
+     }
+   return NULL;
+}
+
+static Eina_Bool
+_bench_cfg_cb_step(void *data EINA_UNUSED)
+{
+   Evas_Point pt;
+   E_Client *ec;
+   unsigned long long t;
+   unsigned int sent;
+
+   t = _bench_now() - bench_cfg->t0;
+   if (((double)t / 1000000000.0) > bench_cfg->timeout)
+     {
+        ERR("BENCH: wl resize timed out (%u configures)", bench_cfg->configures);
+        goto done;
+     }
+   if (!bench_cfg->ec)
+     {
+        if ((!bench_cfg->configures) || (!(ec = _bench_cfg_client_find())))
+          return ECORE_CALLBACK_RENEW;
+        bench_cfg->ec = ec;
+        // grab the bottom right corner like a pointer would
+        ec->moveinfo.down.button = 0;
+        ec->moveinfo.down.x = ec->x;
+        ec->moveinfo.down.y = ec->y;
+        ec->moveinfo.down.w = ec->w;
+        ec->moveinfo.down.h = ec->h;
+        ec->moveinfo.down.mx = ec->mouse.current.mx = ec->x + ec->w - 1;
+        ec->moveinfo.down.my = ec->mouse.current.my = ec->y + ec->h - 1;
+        e_client_act_resize_begin(ec, NULL);
+        if (!e_client_util_resizing_get(ec))
+          {
+             ERR("BENCH: cannot start resizing the wl client");
+             goto done;
+          }
+        bench_cfg->start_w = ec->client.w;
+        bench_cfg->start_h = ec->client.h;
+        bench_cfg->configures_start = bench_cfg->configures;
+        bench_cfg->resizing = EINA_TRUE;
+        bench_cfg->t0 = _bench_now();
+        return ECORE_CALLBACK_RENEW;
+     }
+   ec = bench_cfg->ec;
+   if (bench_cfg->step < bench_cfg->steps)
+     {
+        bench_cfg->step++;
+        pt.x = ec->moveinfo.down.mx + bench_cfg->step;
+        pt.y = ec->moveinfo.down.my + bench_cfg->step;
+        e_client_mouse_move(ec, &pt);
+        return ECORE_CALLBACK_RENEW;
+     }
+   if (!bench_cfg->ended)
+     {
+        bench_cfg->ended = EINA_TRUE;
+        e_client_act_resize_end(ec, NULL);
+        return ECORE_CALLBACK_RENEW;
+     }
+   if (!bench_cfg->done) return ECORE_CALLBACK_RENEW;
+
+   // one motion per tick against a client that needs ack_ms per configure,
+   // so with a configure in flight at a time most sizes must fold together
+   sent = bench_cfg->configures - bench_cfg->configures_start;
+   if (sent > (bench_cfg->steps / 4))
+     ERR("BENCH: slow client got %u configures for %u motions",
+         sent, bench_cfg->steps);
+   else if ((bench_cfg->last_w <= bench_cfg->start_w) ||
+            (bench_cfg->last_h <= bench_cfg->start_h))
+     ERR("BENCH: slow client ended at %ix%i, started at %ix%i",
+         bench_cfg->last_w, bench_cfg->last_h,
+         bench_cfg->start_w, bench_cfg->start_h);
+   else
+     _bench_result_add("wl_resize_configures", sent,
+                       (double)t / (double)sent, (double)t / (double)sent);
+done:
+   step_timer = NULL;
+   _bench_cfg_free();
+   _bench_async_next();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_cfg_start(void)
+{
+   const char *s, *client;
+
+   if (e_comp->comp_type != E_PIXMAP_TYPE_WL) return EINA_FALSE;
+   if (!_bench_wanted("wl_resize_configures")) return EINA_FALSE;
+   client = getenv("E_BENCH_WL_CLIENT");
+   if ((!client) || (!client[0])) return EINA_FALSE;
+   bench_cfg = E_NEW(Bench_Cfg, 1);
+   if (!bench_cfg) return EINA_FALSE;
+   bench_cfg->steps = 200;
+   s = getenv("E_BENCH_RESIZE_STEPS");
+   if (s) bench_cfg->steps = MAX(atoi(s), 1);
+   bench_cfg->timeout = 30.0;
+   bench_cfg->handler = ecore_event_handler_add(ECORE_EXE_EVENT_DATA,
+                                                _bench_cfg_cb_data, NULL);
+   bench_cfg->exe = ecore_exe_pipe_run(client,
+                                       ECORE_EXE_PIPE_READ |
+                                       ECORE_EXE_PIPE_READ_LINE_BUFFERED |
+                                       ECORE_EXE_TERM_WITH_PARENT, NULL);
+   if (!bench_cfg->exe)
+     {
+        _bench_cfg_free();
+        return EINA_FALSE;
+     }
+   bench_cfg->t0 = _bench_now();
+   step_timer = ecore_timer_loop_add(0.005, _bench_cfg_cb_step, NULL);
+   return EINA_TRUE;
+}
+#else
+static void
+_bench_cfg_free(void)
+{
+}
+
+static Eina_Bool
+_bench_cfg_start(void)
+{
+   return EINA_FALSE;
+}
+#endif
+
+/* notification flood - async, Notify calls with image-data over the
+ * session bus back into e's own server, all from one app */
+
+#define BENCH_NOTIFY_ICON 48
+
+typedef struct
+{
+   Eldbus_Connection  *conn;
+   Ecore_Timer        *stall_timer;
+   unsigned char      *icon;
+   unsigned int        num;
+   unsigned int        replies;
+   unsigned int        errors;
+   unsigned int        objs;
+   unsigned long long  t0;
+   unsigned long long  last_tick;
+   unsigned long long  max_stall;
+   double              timeout;
+} Bench_Notify;
+
+static Bench_Notify *bench_notify = NULL;
+
+static void
+_bench_notify_free(void)
+{
+   if (!bench_notify) return;
+   E_FREE_FUNC(bench_notify->stall_timer, ecore_timer_del);
+   if (bench_notify->conn) eldbus_connection_unref(bench_notify->conn);
+   free(bench_notify->icon);
+   E_FREE(bench_notify);
+}
+
+static unsigned int
+_bench_notify_objs_count(void)
+{
+   Eina_List *objs;
+   unsigned int count;
+
+   objs = evas_objects_in_rectangle_get(e_comp->evas, -100000, -100000,
+                                        200000, 200000, EINA_TRUE, EINA_TRUE);
+   count = eina_list_count(objs);
+   eina_list_free(objs);
+   return count;
+}
+
+static Eina_Bool
+_bench_notify_cb_stall(void *data EINA_UNUSED)
+{
+   unsigned long long t = _bench_now();
+
+   // how long the main loop went without getting back to us
+   if ((t - bench_notify->last_tick) > bench_notify->max_stall)
+     bench_notify->max_stall = t - bench_notify->last_tick;
+   bench_notify->last_tick = t;
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_bench_notify_cb_reply(void *data EINA_UNUSED, const Eldbus_Message *msg, Eldbus_Pending *pending EINA_UNUSED)
+{
+   const char *name, *text;
+
+   if (!bench_notify) return;
+   if (eldbus_message_error_get(msg, &name, &text))
+     {
+        if (!bench_notify->errors)
+          ERR("BENCH: notify failed: %s %s", name, text);
+        bench_notify->errors++;
+     }
+   bench_notify->replies++;
+}
+
+static Eina_Bool
+_bench_notify_send(const char *app, unsigned int i)
+{
+   Eldbus_Message *msg;
+   Eldbus_Message_Iter *iter, *actions, *hints, *entry, *var, *st, *data;
+   char summary[64], body[128];
+
+   msg = eldbus_message_method_call_new("org.freedesktop.Notifications",
+                                        "/org/freedesktop/Notifications",
+                                        "org.freedesktop.Notifications",
+                                        "Notify");
+   if (!msg) return EINA_FALSE;
+   snprintf(summary, sizeof(summary), "Flood %u", i);
+   snprintf(body, sizeof(body), "message number %u of a flood from %s", i, app);
+   iter = eldbus_message_iter_get(msg);
+   eldbus_message_iter_arguments_append(iter, "susssas", app, 0, "",
+                                        summary, body, &actions);
+   eldbus_message_iter_container_close(iter, actions);
+   eldbus_message_iter_arguments_append(iter, "a{sv}", &hints);
+   // the same icon every time, as a chatty app would send it
+   eldbus_message_iter_arguments_append(hints, "{sv}", &entry);
+   eldbus_message_iter_arguments_append(entry, "s", "image-data");
+   var = eldbus_message_iter_container_new(entry, 'v', "(iiibiiay)");
+   eldbus_message_iter_arguments_append(var, "(iiibiiay)", &st);
+   eldbus_message_iter_arguments_append(st, "iiibiiay",
+                                        BENCH_NOTIFY_ICON, BENCH_NOTIFY_ICON,
+                                        BENCH_NOTIFY_ICON * 4, EINA_TRUE, 8, 4,
+                                        &data);
+   eldbus_message_iter_fixed_array_append(data, 'y', bench_notify->icon,
+                                          BENCH_NOTIFY_ICON * BENCH_NOTIFY_ICON * 4);
+   eldbus_message_iter_container_close(st, data);
+   eldbus_message_iter_container_close(var, st);
+   eldbus_message_iter_container_close(entry, var);
+   eldbus_message_iter_container_close(hints, entry);
+   eldbus_message_iter_container_close(iter, hints);
+   eldbus_message_iter_arguments_append(iter, "i", 5000);
+   return !!eldbus_connection_send(bench_notify->conn, msg,
+                                   _bench_notify_cb_reply, NULL, 60000);
+}
+
+static Eina_Bool
+_bench_notify_cb_poll(void *data EINA_UNUSED)
+{
+   unsigned long long t;
+   unsigned int objs;
+
+   t = _bench_now() - bench_notify->t0;
+   if ((bench_notify->replies < bench_notify->num) &&
+       (((double)t / 1000000000.0) < bench_notify->timeout))
+     return ECORE_CALLBACK_RENEW;
+   objs = _bench_notify_objs_count();
+   if (bench_notify->replies < bench_notify->num)
+     ERR("BENCH: notification flood timed out with %u/%u replies",
+         bench_notify->replies, bench_notify->num);
+   else if (bench_notify->errors)
+     ERR("BENCH: %u of %u notifications failed",
+         bench_notify->errors, bench_notify->num);
+   // a burst and then merging into one popup - never a popup per message
+   else if (objs > (bench_notify->objs + 16))
+     ERR("BENCH: notification flood left %u new canvas objects",
+         objs - bench_notify->objs);
+   else
+     {
+        _bench_result_add("notify_flood", bench_notify->num,
+                          (double)t / (double)bench_notify->num,
+                          (double)t / (double)bench_notify->num);
+        _bench_result_add("notify_flood_max_stall", 1,
+                          bench_notify->max_stall, bench_notify->max_stall);
+     }
+   step_timer = NULL;
+   _bench_notify_free();
+   _bench_async_next();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_notify_start(void)
+{
+   const char *s;
+   unsigned int i;
+
+   if ((!_bench_wanted("notify_flood")) &&
+       (!_bench_wanted("notify_flood_max_stall")))
+     return EINA_FALSE;
+   if (!e_module_find("notification"))
+     {
+        INF("BENCH: notification module not loaded - skipping notify_flood");
+        return EINA_FALSE;
+     }
+   bench_notify = E_NEW(Bench_Notify, 1);
+   if (!bench_notify) return EINA_FALSE;
+   bench_notify->conn = eldbus_connection_get(ELDBUS_CONNECTION_TYPE_SESSION);
+   bench_notify->icon = malloc(BENCH_NOTIFY_ICON * BENCH_NOTIFY_ICON * 4);
+   if ((!bench_notify->conn) || (!bench_notify->icon))
+     {
+        _bench_notify_free();
+        return EINA_FALSE;
+     }
+   for (i = 0; i < (BENCH_NOTIFY_ICON * BENCH_NOTIFY_ICON * 4); i++)
+     bench_notify->icon[i] = _bench_rand();
+   bench_notify->num = 1000;
+   s = getenv("E_BENCH_NOTIFY");
+   if (s) bench_notify->num = MAX(atoi(s), 1);
+   bench_notify->timeout = 60.0;
+   bench_notify->objs = _bench_notify_objs_count();
+   bench_notify->t0 = bench_notify->last_tick = _bench_now();
+   for (i = 0; i < bench_notify->num; i++)
+     {
+        if (!_bench_notify_send("e_bench_flood", i))
+          {
+             _bench_notify_free();
+             return EINA_FALSE;
+          }
+     }
+   bench_notify->stall_timer =
+     ecore_timer_loop_add(0.01, _bench_notify_cb_stall, NULL);
+   step_timer = ecore_timer_loop_add(0.01, _bench_notify_cb_poll, NULL);
+   return EINA_TRUE;
+}
+
+/* driver */
+
+static Eina_Bool (*_bench_async[])(void) =
+{
+   _bench_xprop_start,
+   _bench_cfg_start,
+   _bench_notify_start,
+   _bench_clip_start,
+   _bench_fm_start
+};
+
+static void
+_bench_async_next(void)
+{
+   // async benches run one after the other, then results are written
+   while (bench_async < EINA_C_ARRAY_LENGTH(_bench_async))
+     {
+        if (_bench_async[bench_async++]()) return;
+     }
+   _bench_finish();
+}
+
+static void
+_bench_sync_suites(void)
+{
+   E_Client *ec = NULL;
+   Evas_Object *win;
+   E_Desk *desk;
+
+   if (wins)
+     {
+        win = eina_list_data_get(wins);
+        ec = e_win_client_get(win);
+     }
+   desk = e_desk_current_get(e_zone_current_get());
+   if (desk) _bench_run("place_desk_region_smart", _bench_place, desk);
+   _bench_bindings();
+   if (ec)
+     {
+        _bench_remember(ec);
+        if ((ec->frame) && (_bench_wanted("comp_object_damage")))
+          _bench_run("comp_object_damage", _bench_damage, ec);
+     }
+   _bench_evry();
+   _bench_exehist();
+}
+
+static Eina_Bool
+_bench_cb_mapped(void *data EINA_UNUSED)
+{
+   Evas_Object *win;
+   E_Client *ec;
+   Eina_List *l;
+
+   // wait until every window has a visible client, or give up after a while
+   EINA_LIST_FOREACH(wins, l, win)
+     {
+        ec = e_win_client_get(win);
+        if (((!ec) || (!ec->visible)) && (ecore_loop_time_get() < map_timeout))
+          return ECORE_CALLBACK_RENEW;
+     }
+   step_timer = NULL;
+   _bench_sync_suites();
+   _bench_async_next();
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_bench_cb_start(void *data EINA_UNUSED)
+{
+   Evas_Object *win;
+   E_Zone *zone;
+   const char *s;
+   int i, num = 24;
+
+   s = getenv("E_BENCH_CLIENTS");
+   if (s) num = MAX(atoi(s), 0);
+   zone = e_zone_current_get();
+   for (i = 0; i < num; i++)
+     {
+        win = elm_win_util_standard_add("e_bench", "Benchmark");
+        e_win_no_remember_set(win, EINA_TRUE);
+        evas_object_resize(win, 100 + (_bench_rand() % 400),
+                           100 + (_bench_rand() % 300));
+        evas_object_move(win, zone->x + (_bench_rand() % (zone->w / 2)),
+                         zone->y + (_bench_rand() % (zone->h / 2)));
+        evas_object_show(win);
+        wins = eina_list_append(wins, win);
+     }
+   map_timeout = ecore_loop_time_get() + 5.0;
+   step_timer = ecore_timer_loop_add(0.05, _bench_cb_mapped, NULL);
+   return ECORE_CALLBACK_CANCEL;
+}
+
+E_API E_Module_Api e_modapi =
+{
+   E_MODULE_API_VERSION,
+   "Bench"
+};
+
+E_API void *
+e_modapi_init(E_Module *m)
+{
+   const char *s;
+
+   s = getenv("E_BENCH_TIME");
+   if (s) bench_time = MAX(atof(s), 0.01);
+   bench_filter = getenv("E_BENCH_FILTER");
+   // give startup (and any other deferred module init) a moment to settle
+   step_timer = ecore_timer_loop_add(1.0, _bench_cb_start, NULL);
+   return m;
+}
+
+E_API int
+e_modapi_shutdown(E_Module *m EINA_UNUSED)
+{
+   Bench_Result *r;
+   Evas_Object *win;
+
+   E_FREE_FUNC(step_timer, ecore_timer_del);
+   _bench_xprop_free();
+   _bench_cfg_free();
+   _bench_notify_free();
+   _bench_clip_free();
+   _bench_fm_free();
+   EINA_LIST_FREE(wins, win)
+     evas_object_del(win);
+   EINA_LIST_FREE(results, r)
+     {
+        eina_stringshare_del(r->name);
+        free(r);
+     }
+   return 1;
+}
+
+E_API int
+e_modapi_save(E_Module *m EINA_UNUSED)
+{
+   return 1;
+}
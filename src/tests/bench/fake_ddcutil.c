@@ -0,0 +1,166 @@
+// stand-in for libddcutil.so.2 so the ddc workers in enlightenment_system
+// can be driven without i2c hardware. it has two monitors - the first is
+// slow to write like a real one (E_BENCH_DDC_SLOW_MS, default 50ms per set)
+// and the second answers right away
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// only the parts of the ddcutil abi that e_system_ddc.c uses
+typedef int DDCA_Status;
+typedef void * DDCA_Display_Ref;
+typedef void * DDCA_Display_Handle;
+typedef uint8_t DDCA_Vcp_Feature_Code;
+
+typedef struct
+{
+   int io_mode;
+   union {
+      int i2c_busno;
+      struct { int a, d; } adlno;
+      int hiddev_devno;
+   } path;
+} DDCA_IO_Path;
+
+typedef struct
+{
+   char marker[4];
+   int dispno;
+   DDCA_IO_Path path;
+   int usb_bus;
+   int usb_device;
+   char mfg_id[4];
+   char model_name[14];
+   char sn[14];
+   uint16_t product_code;
+   uint8_t edid_bytes[128];
+   struct { uint8_t major, minor; } vcp_version;
+   DDCA_Display_Ref dref;
+} DDCA_Display_Info;
+
+typedef struct
+{
+   int ct;
+   DDCA_Display_Info info[];
+} DDCA_Display_Info_List;
+
+typedef struct
+{
+   uint8_t mh;
+   uint8_t ml;
+   uint8_t sh;
+   uint8_t sl;
+} DDCA_Non_Table_Vcp_Value;
+
+#define FAKE_DISPLAYS 2
+
+typedef struct
+{
+   int val;
+   int sets;
+} Fake_Display;
+
+static Fake_Display _displays[FAKE_DISPLAYS];
+
+static void
+_fake_sleep(int ms)
+{
+   struct timespec ts;
+
+   ts.tv_sec = ms / 1000;
+   ts.tv_nsec = (ms % 1000) * 1000000L;
+   nanosleep(&ts, NULL);
+}
+
+DDCA_Status
+ddca_get_display_info_list2(bool include_invalid_displays, DDCA_Display_Info_List **dlist_loc)
+{
+   DDCA_Display_Info_List *dlist;
+   int i, j;
+
+   (void)include_invalid_displays;
+   dlist = calloc(1, sizeof(DDCA_Display_Info_List) +
+                  (FAKE_DISPLAYS * sizeof(DDCA_Display_Info)));
+   if (!dlist) return -1;
+   dlist->ct = FAKE_DISPLAYS;
+   for (i = 0; i < FAKE_DISPLAYS; i++)
+     {
+        dlist->info[i].dispno = i + 1;
+        for (j = 0; j < 128; j++)
+          dlist->info[i].edid_bytes[j] = (j * 7) + i;
+        dlist->info[i].dref = &(_displays[i]);
+     }
+   *dlist_loc = dlist;
+   return 0;
+}
+
+void
+ddca_free_display_info_list(DDCA_Display_Info_List *dlist)
+{
+   free(dlist);
+}
+
+DDCA_Status
+ddca_open_display2(DDCA_Display_Ref ddca_dref, bool wait, DDCA_Display_Handle *ddca_dh_loc)
+{
+   (void)wait;
+   *ddca_dh_loc = ddca_dref;
+   return 0;
+}
+
+DDCA_Status
+ddca_close_display(DDCA_Display_Handle ddca_dh)
+{
+   (void)ddca_dh;
+   return 0;
+}
+
+DDCA_Status
+ddca_get_non_table_vcp_value(DDCA_Display_Handle ddca_dh, DDCA_Vcp_Feature_Code feature_code, DDCA_Non_Table_Vcp_Value *valrec)
+{
+   Fake_Display *d = ddca_dh;
+   int val;
+
+   (void)feature_code;
+   val = __atomic_load_n(&(d->val), __ATOMIC_SEQ_CST);
+   memset(valrec, 0, sizeof(*valrec));
+   valrec->sh = (val >> 8) & 0xff;
+   valrec->sl = val & 0xff;
+   return 0;
+}
+
+DDCA_Status
+ddca_set_non_table_vcp_value(DDCA_Display_Handle ddca_dh, DDCA_Vcp_Feature_Code feature_code, uint8_t hi_byte, uint8_t lo_byte)
+{
+   Fake_Display *d = ddca_dh;
+   const char *s;
+   int ms = 50;
+
+   (void)feature_code;
+   if (d == &(_displays[0]))
+     {
+        s = getenv("E_BENCH_DDC_SLOW_MS");
+        if (s) ms = atoi(s);
+        if (ms > 0) _fake_sleep(ms);
+     }
+   __atomic_store_n(&(d->val), (hi_byte << 8) | lo_byte, __ATOMIC_SEQ_CST);
+   __atomic_add_fetch(&(d->sets), 1, __ATOMIC_SEQ_CST);
+   return 0;
+}
+
+// not ddcutil api - lets the bench see what actually reached the monitors
+int
+fake_ddc_sets_get(int screen)
+{
+   if ((screen < 0) || (screen >= FAKE_DISPLAYS)) return -1;
+   return __atomic_load_n(&(_displays[screen].sets), __ATOMIC_SEQ_CST);
+}
+
+int
+fake_ddc_val_get(int screen)
+{
+   if ((screen < 0) || (screen >= FAKE_DISPLAYS)) return -1;
+   return __atomic_load_n(&(_displays[screen].val), __ATOMIC_SEQ_CST);
+}